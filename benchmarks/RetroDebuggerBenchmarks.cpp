@@ -0,0 +1,464 @@
+#include "BreakpointManager.h"
+#include "ConditionInterpreter.h"
+#include "Debugger.h"
+#include "DebuggerCallbacks.h"
+#include "DebuggerOperations.h"
+#include "DebuggerXmlParser.h"
+#include "Disassembler.h"
+#include "RetroDebugger.h"
+
+#include "GameboyBios.h"
+#include "RetroDebuggerTests_assets.h"
+#ifdef RDB_GENERATED_OPERATIONS
+#include "GameboyOperations.h"
+#endif
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+
+/******************************************************************************
+ * Benchmarks for the paths an emulator hits every instruction or memory access,
+ * plus the interactive commands. Memory holds the Gameboy BIOS at address 0.
+ ******************************************************************************/
+
+namespace {
+using RetroDebuggerTests::Assets::GameboyBios;
+
+static constexpr auto AddressMask = 0xFFFFU;
+static constexpr auto BiosMask = 0xFFU;
+static constexpr auto UnusedAddress = 0xC000U; // Breakpoints and watchpoints are set here so they are checked but never hit.
+
+// Stands in for the emulator state the callbacks read.
+struct Emulator {
+    Emulator() { std::ranges::copy(GameboyBios, memory.begin()); }
+
+    unsigned int pc = 0;
+    unsigned int a = 0;
+    std::array<unsigned int, AddressMask + 1> memory = {};
+};
+
+// Emulator style callbacks, concrete and final so a BasicBreakpointManager can inline them.
+class StaticCallbacks final : public Rdb::IDebuggerCallbacks {
+public:
+    explicit StaticCallbacks(Emulator& emulator) :
+        m_emulator(emulator) {}
+
+    unsigned int GetPcReg() override { return m_emulator.pc; }
+    unsigned int ReadMemory(unsigned int address) override { return m_emulator.memory[address & AddressMask]; }
+    bool CheckBankableMemoryLocation(BankNum /*bank*/, unsigned int /*address*/) override { return false; }
+    unsigned int ReadBankableMemory(BankNum /*bank*/, unsigned int address) override { return ReadMemory(address); }
+    bool ReadMemoryBlock(BankNum /*bank*/, unsigned int /*address*/, std::span<std::byte> /*buffer*/) override { return false; }
+    RegSet GetRegSet() override { return { { "A", m_emulator.a } }; }
+    RegisterId FindRegister(const std::string& name) override { return name == "A" ? RegisterId{ 0 } : InvalidRegisterId; }
+    unsigned int ReadRegister(RegisterId /*id*/) override { return m_emulator.a; }
+    RegisterFile GetRegisterFile() override { return { { .name = "A", .id = RegisterId{ 0 }, .width = 1 } }; }
+
+private:
+    Emulator& m_emulator;
+};
+
+std::shared_ptr<Rdb::DebuggerCallbacks> MakeCallbacks(Emulator& emulator) {
+    auto callbacks = std::make_shared<Rdb::DebuggerCallbacks>();
+    callbacks->SetGetPcRegCallback([&emulator]() { return emulator.pc; });
+    callbacks->SetReadMemoryCallback([&emulator](unsigned int address) { return emulator.memory[address & AddressMask]; });
+    callbacks->SetReadBankableMemoryCallback([&emulator](BankNum /*bank*/, unsigned int address) { return emulator.memory[address & AddressMask]; });
+    callbacks->SetCheckBankableMemoryLocationCallback([](BankNum /*bank*/, unsigned int /*address*/) { return false; });
+    callbacks->SetRegisterFile({ { .name = "A", .id = RegisterId{ 0 }, .width = 1 } }, [&emulator](RegisterId /*id*/) { return emulator.a; });
+    return callbacks;
+}
+
+std::shared_ptr<Rdb::DebuggerOperations> MakeOperations(std::shared_ptr<Rdb::IDebuggerCallbacks> callbacks) {
+    DebuggerXmlParser parser;
+    parser.ParseFile(std::string(RetroDebuggerTests::Assets::GameboyOperationsDebuggerXml));
+    auto operations = std::make_shared<Rdb::DebuggerOperations>(std::move(callbacks));
+    operations->SetOperations(parser.GetOperations());
+    return operations;
+}
+
+void CheckBreakpoints_Breakpoints(benchmark::State& state) {
+    Emulator emulator;
+    auto callbacks = MakeCallbacks(emulator);
+    Rdb::BreakpointManager breakpointManager{ MakeOperations(callbacks), callbacks };
+    for (auto i = 0; i < state.range(0); ++i) {
+        breakpointManager.SetBreakpoint(UnusedAddress + static_cast<unsigned int>(i));
+    }
+
+    BreakInfo breakInfo;
+    for (auto _ : state) {
+        emulator.pc = (emulator.pc + 1) & BiosMask;
+        benchmark::DoNotOptimize(breakpointManager.CheckBreakpoints(breakInfo));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(CheckBreakpoints_Breakpoints)->Arg(0)->Arg(10)->Arg(100)->Arg(1000);
+
+// Cost of recording each instruction into the trace, 0 leaves tracing off.
+void CheckBreakpoints_Trace(benchmark::State& state) {
+    Emulator emulator;
+    auto callbacks = MakeCallbacks(emulator);
+    Rdb::Debugger debugger(callbacks);
+    DebuggerXmlParser parser;
+    parser.ParseFile(std::string(RetroDebuggerTests::Assets::GameboyOperationsDebuggerXml));
+    debugger.SetOperations(parser.GetOperations());
+    debugger.SetReadOnlyMemory(0, BiosMask);
+    if (state.range(0) != 0) {
+        debugger.EnableTrace(static_cast<size_t>(state.range(0)), { "A" });
+    }
+    debugger.Run();
+
+    BreakInfo breakInfo;
+    for (auto _ : state) {
+        emulator.pc = (emulator.pc + 1) & BiosMask;
+        benchmark::DoNotOptimize(debugger.CheckBreakpoints(breakInfo));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(CheckBreakpoints_Trace)->Arg(0)->Arg(100'000);
+
+// Cost of streaming each instruction to a trace file, the file is kept for RdbTraceDump.
+void CheckBreakpoints_TraceFile(benchmark::State& state) {
+    Emulator emulator;
+    auto callbacks = MakeCallbacks(emulator);
+    Rdb::Debugger debugger(callbacks);
+    DebuggerXmlParser parser;
+    parser.ParseFile(std::string(RetroDebuggerTests::Assets::GameboyOperationsDebuggerXml));
+    debugger.SetOperations(parser.GetOperations());
+    debugger.SetReadOnlyMemory(0, BiosMask);
+    debugger.EnableTraceFile(std::filesystem::temp_directory_path() / "RetroDebuggerBenchmarks_trace.rdbt", { "A" });
+    debugger.Run();
+
+    BreakInfo breakInfo;
+    for (auto _ : state) {
+        emulator.pc = (emulator.pc + 1) & BiosMask;
+        benchmark::DoNotOptimize(debugger.CheckBreakpoints(breakInfo));
+    }
+    debugger.DisableTrace();
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(CheckBreakpoints_TraceFile);
+
+void CheckBreakpoints_Profile(benchmark::State& state) {
+    Emulator emulator;
+    auto callbacks = MakeCallbacks(emulator);
+    Rdb::Debugger debugger(callbacks);
+    if (state.range(0) != 0) {
+        debugger.EnableProfile();
+    }
+    debugger.Run();
+
+    BreakInfo breakInfo;
+    for (auto _ : state) {
+        emulator.pc = (emulator.pc + 1) & BiosMask;
+        benchmark::DoNotOptimize(debugger.CheckBreakpoints(breakInfo));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(CheckBreakpoints_Profile)->Arg(0)->Arg(1);
+
+// Static callbacks, so the PC read coverage adds is inlined rather than a second callback.
+void CheckBreakpoints_Coverage(benchmark::State& state) {
+    Emulator emulator;
+    auto callbacks = std::make_shared<StaticCallbacks>(emulator);
+    Rdb::BasicDebugger<StaticCallbacks> debugger(callbacks);
+    if (state.range(0) != 0) {
+        debugger.EnableCoverage();
+    }
+    debugger.Run();
+
+    BreakInfo breakInfo;
+    for (auto _ : state) {
+        emulator.pc = (emulator.pc + 1) & BiosMask;
+        benchmark::DoNotOptimize(debugger.CheckBreakpoints(breakInfo));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(CheckBreakpoints_Coverage)->Arg(0)->Arg(1);
+
+// A tracepoint on every executed address, each instruction logs register A.
+void CheckBreakpoints_Tracepoints(benchmark::State& state) {
+    Emulator emulator;
+    auto callbacks = MakeCallbacks(emulator);
+    Rdb::BreakpointManager breakpointManager{ MakeOperations(callbacks), callbacks };
+    if (state.range(0) != 0) {
+        for (auto address = 0U; address <= BiosMask; ++address) {
+            breakpointManager.SetTracepoint(address, { "A" });
+        }
+    }
+
+    BreakInfo breakInfo;
+    for (auto _ : state) {
+        emulator.pc = (emulator.pc + 1) & BiosMask;
+        benchmark::DoNotOptimize(breakpointManager.CheckBreakpoints(breakInfo));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(CheckBreakpoints_Tracepoints)->Arg(0)->Arg(1);
+
+void CheckBreakpoints_Watchpoints(benchmark::State& state) {
+    Emulator emulator;
+    auto callbacks = MakeCallbacks(emulator);
+    Rdb::BreakpointManager breakpointManager{ MakeOperations(callbacks), callbacks };
+    for (auto i = 0; i < state.range(0); ++i) {
+        breakpointManager.SetWatchpoint(UnusedAddress + static_cast<unsigned int>(i));
+    }
+
+    BreakInfo breakInfo;
+    for (auto _ : state) {
+        emulator.pc = (emulator.pc + 1) & BiosMask;
+        benchmark::DoNotOptimize(breakpointManager.CheckBreakpoints(breakInfo));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(CheckBreakpoints_Watchpoints)->Arg(0)->Arg(10)->Arg(100)->Arg(1000);
+
+void CheckBreakpoints_StaticCallbacks(benchmark::State& state) {
+    Emulator emulator;
+    auto callbacks = std::make_shared<StaticCallbacks>(emulator);
+    Rdb::BasicBreakpointManager<StaticCallbacks> breakpointManager{ MakeOperations(callbacks), callbacks };
+    for (auto i = 0; i < state.range(0); ++i) {
+        breakpointManager.SetBreakpoint(UnusedAddress + static_cast<unsigned int>(i));
+    }
+
+    BreakInfo breakInfo;
+    for (auto _ : state) {
+        emulator.pc = (emulator.pc + 1) & BiosMask;
+        benchmark::DoNotOptimize(breakpointManager.CheckBreakpoints(breakInfo));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(CheckBreakpoints_StaticCallbacks)->Arg(0)->Arg(10)->Arg(100)->Arg(1000);
+
+enum class HookForm {
+    Vector,
+    Span,
+    Scalar,
+};
+
+void MemoryHook(benchmark::State& state, bool isWrite, HookForm form) {
+    Emulator emulator;
+    auto callbacks = MakeCallbacks(emulator);
+    Rdb::BreakpointManager breakpointManager{ MakeOperations(callbacks), callbacks };
+    for (auto i = 0; i < state.range(0); ++i) {
+        breakpointManager.SetAnyWatchpoint(UnusedAddress + static_cast<unsigned int>(i));
+    }
+
+    // Accesses sweep the 8K below the watched addresses, as video memory writes would.
+    static constexpr auto accessStart = 0xA000U;
+    static constexpr auto accessMask = 0x1FFFU;
+    static constexpr auto value = std::byte{ 0x42 };
+    auto address = 0U;
+    for (auto _ : state) {
+        address = (address + 1) & accessMask;
+        switch (form) {
+            case HookForm::Vector: {
+                // What callers of the vector API pay, one allocation per access.
+                const std::vector<std::byte> bytes = { value };
+                isWrite ? breakpointManager.WriteMemoryHook(AnyBank, accessStart + address, bytes) : breakpointManager.ReadMemoryHook(AnyBank, accessStart + address, bytes);
+                break;
+            }
+            case HookForm::Span: {
+                const std::array<std::byte, 1> bytes = { value };
+                isWrite ? breakpointManager.WriteMemoryHook(AnyBank, accessStart + address, std::span{ bytes }) : breakpointManager.ReadMemoryHook(AnyBank, accessStart + address, std::span{ bytes });
+                break;
+            }
+            case HookForm::Scalar:
+                isWrite ? breakpointManager.WriteMemoryHook(AnyBank, accessStart + address, 0x42U, 1U) : breakpointManager.ReadMemoryHook(AnyBank, accessStart + address, 0x42U, 1U);
+                break;
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_CAPTURE(MemoryHook, ReadVector, false, HookForm::Vector)->Arg(0)->Arg(10)->Arg(100)->Arg(1000);
+BENCHMARK_CAPTURE(MemoryHook, ReadSpan, false, HookForm::Span)->Arg(0)->Arg(10)->Arg(100)->Arg(1000);
+BENCHMARK_CAPTURE(MemoryHook, ReadScalar, false, HookForm::Scalar)->Arg(0)->Arg(10)->Arg(100)->Arg(1000);
+BENCHMARK_CAPTURE(MemoryHook, WriteVector, true, HookForm::Vector)->Arg(0)->Arg(10)->Arg(100)->Arg(1000);
+BENCHMARK_CAPTURE(MemoryHook, WriteSpan, true, HookForm::Span)->Arg(0)->Arg(10)->Arg(100)->Arg(1000);
+BENCHMARK_CAPTURE(MemoryHook, WriteScalar, true, HookForm::Scalar)->Arg(0)->Arg(10)->Arg(100)->Arg(1000);
+
+// Accesses pushed into a buffer and flushed once per 4, as an instruction boundary would.
+void MemoryHook_Batched(benchmark::State& state) {
+    Emulator emulator;
+    auto callbacks = MakeCallbacks(emulator);
+    Rdb::BreakpointManager breakpointManager{ MakeOperations(callbacks), callbacks };
+    for (auto i = 0; i < state.range(0); ++i) {
+        breakpointManager.SetAnyWatchpoint(UnusedAddress + static_cast<unsigned int>(i));
+    }
+
+    static constexpr auto accessStart = 0xA000U;
+    static constexpr auto accessMask = 0x1FFFU;
+    static constexpr auto accessesPerFlush = 4U;
+    Rdb::MemoryAccessBuffer buffer;
+    auto address = 0U;
+    for (auto _ : state) {
+        for (auto i = 0U; i < accessesPerFlush; ++i) {
+            address = (address + 1) & accessMask;
+            buffer.PushWrite(AnyBank, accessStart + address, 0x42U);
+        }
+        buffer.Drain([&breakpointManager](std::span<const Rdb::MemoryAccess> accesses) { breakpointManager.MemoryAccessHook(accesses); });
+    }
+    state.SetItemsProcessed(state.iterations() * accessesPerFlush);
+}
+BENCHMARK(MemoryHook_Batched)->Arg(0)->Arg(10)->Arg(100)->Arg(1000);
+
+void EvaluateCondition(benchmark::State& state, const std::string& conditionString) {
+    Emulator emulator;
+    emulator.a = 5;
+    auto callbacks = MakeCallbacks(emulator);
+    const auto condition = Rdb::ConditionInterpreter::CreateCondition(callbacks, conditionString);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(condition->EvaluateCondition());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_CAPTURE(EvaluateCondition, Register, std::string("A == 5"));
+BENCHMARK_CAPTURE(EvaluateCondition, RegisterAndMemory, std::string("A == 5 && *0xFF44 > 0x90"));
+BENCHMARK_CAPTURE(EvaluateCondition, Interpreted, std::string("A * 1.5 > 7.0")); // Doubles aren't compiled, this runs the tree walking interpreter.
+
+void GetOperation(benchmark::State& state) {
+    Emulator emulator;
+    auto callbacks = MakeCallbacks(emulator);
+    const auto operations = MakeOperations(callbacks);
+
+    size_t address = 0;
+    for (auto _ : state) {
+        const auto instruction = operations->Decode(address);
+        address = (address + instruction.length) & BiosMask;
+        benchmark::DoNotOptimize(instruction);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(GetOperation);
+
+// Full 64K address space of random bytes, as a listing of a whole ROM would decode.
+std::vector<std::byte> MakeRandomMemory() {
+    std::mt19937 generator(0x5EED); // NOLINT (cert-msc32-c, cert-msc51-cpp) Fixed seed, the same memory every run.
+    std::uniform_int_distribution<unsigned int> distribution(0, 0xFF);
+    std::vector<std::byte> memory(AddressMask + 1);
+    for (auto& value : memory) {
+        value = static_cast<std::byte>(distribution(generator));
+    }
+    return memory;
+}
+
+void ListAddressSpace(benchmark::State& state) {
+    const auto memory = MakeRandomMemory();
+    auto callbacks = std::make_shared<Rdb::DebuggerCallbacks>();
+    callbacks->SetReadMemoryCallback([&memory](unsigned int address) { return std::to_integer<unsigned int>(memory[address & AddressMask]); });
+    Rdb::Debugger debugger(callbacks);
+    DebuggerXmlParser parser;
+    parser.ParseFile(std::string(RetroDebuggerTests::Assets::GameboyOperationsDebuggerXml));
+    debugger.SetOperations(parser.GetOperations());
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(debugger.GetCommandInfoList(size_t{ 0 }, size_t{ AddressMask }));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * memory.size()));
+}
+BENCHMARK(ListAddressSpace)->Unit(benchmark::kMillisecond);
+
+// Threads from the argument, 0 for one per hardware thread.
+void DisassembleAddressSpace(benchmark::State& state) {
+    const auto memory = MakeRandomMemory();
+    Emulator emulator;
+    const auto operations = MakeOperations(MakeCallbacks(emulator));
+    const Rdb::Disassembler disassembler(*operations, static_cast<unsigned int>(state.range(0)));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(disassembler.Disassemble(0, memory, memory.size()));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * memory.size()));
+}
+BENCHMARK(DisassembleAddressSpace)->Arg(1)->Arg(2)->Arg(4)->Arg(0)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+void ListCommand(benchmark::State& state, bool isReadOnly, bool readsBlocks) {
+    Emulator emulator;
+    Rdb::RetroDebugger debugger;
+    debugger.ParseXmlFile(std::string(RetroDebuggerTests::Assets::GameboyOperationsDebuggerXml));
+    debugger.SetGetPcRegCallback([&emulator]() { return emulator.pc; });
+    debugger.SetReadMemoryCallback([&emulator](unsigned int address) { return emulator.memory[address & AddressMask]; });
+    if (isReadOnly) {
+        debugger.SetReadOnlyMemory(0, BiosMask);
+    }
+    if (readsBlocks) {
+        debugger.SetReadMemoryBlockCallback([&emulator](BankNum /*bank*/, unsigned int address, std::span<std::byte> buffer) {
+            for (auto& value : buffer) {
+                value = static_cast<std::byte>(emulator.memory[address++ & AddressMask]);
+            }
+        });
+    }
+
+    for (auto _ : state) {
+        debugger.ProcessCommandString("list 0x0");
+        benchmark::DoNotOptimize(debugger.GetCommandResponse());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_CAPTURE(ListCommand, Memory, false, false);
+BENCHMARK_CAPTURE(ListCommand, ReadOnlyMemory, true, false);
+BENCHMARK_CAPTURE(ListCommand, BlockMemory, false, true);
+
+void ParseXmlFile(benchmark::State& state, bool useBinaryCache) {
+    // Copied so the binary cache isn't written into the source tree.
+    const auto xmlPath = std::filesystem::temp_directory_path() / "RetroDebuggerBenchmarks_GameboyOperationsDebugger.xml";
+    std::filesystem::copy_file(std::string(RetroDebuggerTests::Assets::GameboyOperationsDebuggerXml), xmlPath, std::filesystem::copy_options::overwrite_existing);
+
+    Rdb::RetroDebugger debugger;
+    for (auto _ : state) {
+        debugger.ParseXmlFile(xmlPath.string(), useBinaryCache);
+    }
+    state.SetItemsProcessed(state.iterations());
+
+    std::filesystem::remove(xmlPath);
+    std::filesystem::remove(xmlPath.string() + ".rdbcache");
+}
+BENCHMARK_CAPTURE(ParseXmlFile, Xml, false)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(ParseXmlFile, BinaryCache, true)->Unit(benchmark::kMillisecond);
+
+#ifdef RDB_GENERATED_OPERATIONS
+void SetGeneratedOperations(benchmark::State& state) {
+    Rdb::RetroDebugger debugger;
+    for (auto _ : state) {
+        debugger.SetOperations(RdbOperations::GameboyOperations::Tables);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(SetGeneratedOperations)->Unit(benchmark::kMillisecond);
+#endif
+
+// A made up 16-bit ISA, 256 mnemonics and a register+offset argument per opcode that is rarely repeated.
+void SetOperations_LargeIsa(benchmark::State& state) {
+    static constexpr auto mnemonicCount = 256U;
+    static constexpr auto registerCount = 16U;
+    const auto opcodeCount = static_cast<unsigned int>(state.range(0));
+
+    XmlDebuggerOperations table = { .opcodeLength = 16, .extendedOpcode = NormalOperationsKey, .operations = {} };
+    for (auto opcode = 0U; opcode < opcodeCount; ++opcode) {
+        XmlDebuggerOperation operation = { .opcode = opcode, .command = "OP" + std::to_string(opcode % mnemonicCount), .arguments = {}, .isJump = false };
+        const auto reg = "R" + std::to_string(opcode % registerCount);
+        operation.arguments.push_back({ .type = ArgumentType::REG, .indirectArg = false, .operation = RegOperationType::NONE, .value = { .nameFirst = true, .name = reg, .reg = reg, .offset = 0 } });
+        operation.arguments.push_back({ .type = ArgumentType::REG, .indirectArg = true, .operation = RegOperationType::REG_OFFSET_ADD, .value = { .nameFirst = true, .name = reg, .reg = reg, .offset = opcode / registerCount } });
+        table.operations.emplace(opcode, std::move(operation));
+    }
+    const XmlOperationsMap operations = { { NormalOperationsKey, table } };
+
+    Emulator emulator;
+    const auto callbacks = MakeCallbacks(emulator);
+    for (auto _ : state) {
+        Rdb::DebuggerOperations debuggerOperations(callbacks);
+        debuggerOperations.SetOperations(operations);
+        benchmark::DoNotOptimize(debuggerOperations);
+    }
+    state.SetItemsProcessed(state.iterations() * opcodeCount);
+}
+BENCHMARK(SetOperations_LargeIsa)->Arg(1 << 10)->Arg(1 << 12)->Arg(1 << 14)->Unit(benchmark::kMillisecond);
+}
@@ -0,0 +1,46 @@
+#[=======================================================================[.rst:
+GenerateOperations
+------------------
+
+Generates constexpr operation tables from an operations XML at build time.
+
+.. cmake:command:: generate_operations_header
+
+  .. code-block:: cmake
+
+    generate_operations_header(<target> <xml> <name>)
+
+  Runs `RdbOperationsCodegen` on `<xml>` whenever the XML changes, writing `<name>.h` under the build folder's `generatedOperations` folder.
+  `generatedOperations` is added to the passed in target's include directories and the header to its source files.
+  The header defines `RdbOperations::<name>::Tables`, which can be installed with `SetOperations` without parsing the XML at runtime.
+  `RDB_GENERATED_OPERATIONS` is defined for the target when the header is generated.
+
+  When cross compiling, the codegen built for the target can't run on the host. It is run through `CMAKE_CROSSCOMPILING_EMULATOR` when one is set,
+  or `RDB_OPERATIONS_CODEGEN` can name a host build of `RdbOperationsCodegen`. Without either no header is generated,
+  and the target falls back to parsing the XML at runtime.
+
+#]=======================================================================]
+set(RDB_OPERATIONS_CODEGEN "" CACHE FILEPATH "Host build of RdbOperationsCodegen, used to generate operation tables when cross compiling")
+
+function(generate_operations_header target xml name)
+    if(RDB_OPERATIONS_CODEGEN)
+        set(codegen ${RDB_OPERATIONS_CODEGEN})
+    elseif(CMAKE_CROSSCOMPILING AND NOT CMAKE_CROSSCOMPILING_EMULATOR)
+        message(STATUS "Not generating ${name}.h for ${target}, RdbOperationsCodegen can't run on the host when cross compiling. Set RDB_OPERATIONS_CODEGEN to a host build of it.")
+        return()
+    else()
+        set(codegen RdbOperationsCodegen)
+    endif()
+
+    set(destination "${CMAKE_CURRENT_BINARY_DIR}/generatedOperations")
+    set(header "${destination}/${name}.h")
+    add_custom_command(
+        OUTPUT ${header}
+        COMMAND ${codegen} ${xml} ${header} ${name}
+        DEPENDS ${codegen} ${xml}
+        COMMENT "Generating operation tables ${name}.h"
+        VERBATIM)
+    target_include_directories(${target} PRIVATE ${destination})
+    target_sources(${target} PRIVATE ${header})
+    target_compile_definitions(${target} PRIVATE RDB_GENERATED_OPERATIONS)
+endfunction()
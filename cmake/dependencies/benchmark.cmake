@@ -0,0 +1,7 @@
+if(NOT TARGET benchmark::benchmark)
+    set(BENCHMARK_ENABLE_TESTING OFF) # Don't build google benchmark's own tests.
+    set(BENCHMARK_ENABLE_GTEST_TESTS OFF)
+    cpmaddpackage("gh:google/benchmark@1.9.1")
+    set_target_properties(benchmark PROPERTIES FOLDER "Dependencies/Benchmarks")
+    set_target_properties(benchmark_main PROPERTIES FOLDER "Dependencies/Benchmarks")
+endif()
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "Token.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Rdb::Bytecode {
+
+// Conditions are lowered to a small register machine, every value is a 32-bit int and booleans are stored as 0 or 1.
+// Operands 'dst', 'a' and 'b' are register indices, 'imm' is a constant, a jump target or a table index depending on the op.
+enum class OpCode : std::uint8_t {
+    LoadConst, // r[dst] = imm
+    LoadRegister, // r[dst] = emulator register with RegisterId imm
+    ReadMemory, // r[dst] = memory[r[a]]
+    ReadBankableMemory, // r[dst] = memory[r[a]:r[b]]
+    Move, // r[dst] = r[a]
+    Not, // r[dst] = !r[a]
+    Negate, // r[dst] = -r[a]
+    Add, // r[dst] = r[a] + r[b]
+    Subtract,
+    Multiply,
+    Divide, // Divide by zero reports on tokens[imm]
+    BitwiseAnd,
+    BitwiseOr,
+    BitwiseXor,
+    Equal,
+    NotEqual,
+    Greater,
+    GreaterEqual,
+    Less,
+    LessEqual,
+    Jump, // pc = imm
+    JumpIfFalse, // if (!r[a]) pc = imm
+    JumpIfTrue, // if (r[a]) pc = imm
+    Return, // return r[a] != 0
+};
+
+struct Instruction {
+    OpCode op;
+    std::uint8_t dst = 0;
+    std::uint8_t a = 0;
+    std::uint8_t b = 0;
+    std::int32_t imm = 0;
+};
+
+// Upper bound on the register file so evaluation can use a fixed array, expressions nested deeper than this aren't compiled.
+static constexpr std::size_t MaxRegisters = 32;
+
+struct Program {
+    std::vector<Instruction> instructions = {};
+    std::vector<TokenPtr> tokens = {}; // Operators that can raise a runtime error
+};
+
+}
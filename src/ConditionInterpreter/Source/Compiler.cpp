@@ -0,0 +1,248 @@
+#include "Compiler.h"
+
+#include "Expr.h"
+#include "RuntimeError.h"
+
+#include <utility>
+
+namespace {
+using Rdb::Bytecode::Instruction;
+using Rdb::Bytecode::OpCode;
+
+std::optional<OpCode> ToOpCode(TokenType type) {
+    switch (type) {
+        case TokenType::PLUS:
+            return OpCode::Add;
+        case TokenType::MINUS:
+            return OpCode::Subtract;
+        case TokenType::STAR:
+            return OpCode::Multiply;
+        case TokenType::SLASH:
+            return OpCode::Divide;
+        case TokenType::BITWISE_AND:
+            return OpCode::BitwiseAnd;
+        case TokenType::BITWISE_OR:
+            return OpCode::BitwiseOr;
+        case TokenType::BITWISE_XOR:
+            return OpCode::BitwiseXor;
+        case TokenType::EQUAL_EQUAL:
+            return OpCode::Equal;
+        case TokenType::BANG_EQUAL:
+            return OpCode::NotEqual;
+        case TokenType::GREATER:
+            return OpCode::Greater;
+        case TokenType::GREATER_EQUAL:
+            return OpCode::GreaterEqual;
+        case TokenType::LESS:
+            return OpCode::Less;
+        case TokenType::LESS_EQUAL:
+            return OpCode::LessEqual;
+        default:
+            return std::nullopt;
+    }
+}
+
+bool IsComparison(OpCode op) {
+    return op == OpCode::Greater || op == OpCode::GreaterEqual || op == OpCode::Less || op == OpCode::LessEqual;
+}
+
+bool IsEquality(OpCode op) {
+    return op == OpCode::Equal || op == OpCode::NotEqual;
+}
+}
+
+namespace Rdb {
+
+std::optional<Bytecode::Program> Compiler::Compile(const Expr::IExprPtr& expr, IDebuggerCallbacks& callbacks) {
+    if (expr == nullptr) { return std::nullopt; }
+
+    const Compiler compiler(callbacks);
+    if (compiler.CompileExpression(expr.get(), 0) == ValueType::Pair) { compiler.MarkUnsupported(); }
+    if (!compiler.m_isSupported) { return std::nullopt; }
+
+    compiler.Emit({ .op = OpCode::Return, .a = 0 });
+    return std::move(compiler.m_program);
+}
+
+Compiler::Compiler(IDebuggerCallbacks& callbacks) :
+    m_callbacks(callbacks) {}
+
+VisitorValue Compiler::VisitBinary(const Expr::Binary* expr) const {
+    const auto target = m_target;
+    const auto operType = expr->m_oper->GetType();
+
+    // <condition> ? <then> : <else>, the right side is a ':' binary holding both branches.
+    if (const auto colonOperator = std::dynamic_pointer_cast<Expr::Binary>(expr->m_right);
+        operType == TokenType::QUESTION && colonOperator != nullptr) {
+        if (CompileExpression(expr->m_left.get(), target) == ValueType::Pair) { MarkUnsupported(); }
+        const auto jumpToElse = Emit({ .op = OpCode::JumpIfFalse, .a = target });
+        const auto thenType = CompileExpression(colonOperator->m_left.get(), target);
+        const auto jumpToEnd = Emit({ .op = OpCode::Jump });
+        PatchJump(jumpToElse);
+        const auto elseType = CompileExpression(colonOperator->m_right.get(), target);
+        PatchJump(jumpToEnd);
+
+        if (thenType != elseType || thenType == ValueType::Pair) { MarkUnsupported(); }
+        m_resultType = thenType;
+        return {};
+    }
+
+    if (operType == TokenType::COMMA) {
+        CompileExpression(expr->m_left.get(), target);
+        m_resultType = CompileExpression(expr->m_right.get(), target);
+        return {};
+    }
+
+    const auto rightTarget = static_cast<std::uint8_t>(target + 1u);
+    const auto leftType = CompileExpression(expr->m_left.get(), target);
+    const auto rightType = CompileExpression(expr->m_right.get(), rightTarget);
+    const auto op = ToOpCode(operType);
+    if (!op || leftType == ValueType::Pair || rightType == ValueType::Pair) {
+        MarkUnsupported();
+        return {};
+    }
+
+    if (IsEquality(*op)) {
+        m_resultType = ValueType::Bool;
+        if (leftType != rightType) {
+            // The interpreter never considers a bool and a number equal.
+            Emit({ .op = OpCode::LoadConst, .dst = target, .imm = *op == OpCode::NotEqual ? 1 : 0 });
+            return {};
+        }
+    }
+    else if (leftType != ValueType::Int || rightType != ValueType::Int) {
+        // Arithmetic on bools is a runtime error, leave reporting it to the interpreter.
+        MarkUnsupported();
+        return {};
+    }
+    else {
+        m_resultType = IsComparison(*op) ? ValueType::Bool : ValueType::Int;
+    }
+
+    auto instruction = Instruction{ .op = *op, .dst = target, .a = target, .b = rightTarget };
+    if (*op == OpCode::Divide) {
+        instruction.imm = static_cast<std::int32_t>(m_program.tokens.size());
+        m_program.tokens.push_back(expr->m_oper);
+    }
+    Emit(instruction);
+    return {};
+}
+
+VisitorValue Compiler::VisitGrouping(const Expr::Grouping* expr) const {
+    m_resultType = CompileExpression(expr->m_expression.get(), m_target);
+    return {};
+}
+
+VisitorValue Compiler::VisitLogical(const Expr::Logical* expr) const {
+    const auto target = m_target;
+
+    // Short-circuiting leaves the left value as the result, same as the interpreter.
+    const auto leftType = CompileExpression(expr->m_left.get(), target);
+    const auto isOr = expr->m_oper->GetType() == TokenType::LOGIC_OR;
+    const auto jumpToEnd = Emit({ .op = isOr ? OpCode::JumpIfTrue : OpCode::JumpIfFalse, .a = target });
+    const auto rightType = CompileExpression(expr->m_right.get(), target);
+    PatchJump(jumpToEnd);
+
+    if (leftType != rightType || leftType == ValueType::Pair) { MarkUnsupported(); }
+    m_resultType = leftType;
+    return {};
+}
+
+VisitorValue Compiler::VisitLiteral(const Expr::Literal* expr) const {
+    const auto target = m_target;
+    const auto& value = expr->m_value;
+
+    if (IsBool(value)) {
+        Emit({ .op = OpCode::LoadConst, .dst = target, .imm = std::get<bool>(value) ? 1 : 0 });
+        m_resultType = ValueType::Bool;
+    }
+    else if (IsInt(value)) {
+        Emit({ .op = OpCode::LoadConst, .dst = target, .imm = std::get<NumericValue>(value).Get<int>() });
+        m_resultType = ValueType::Int;
+    }
+    else if (IsNumericPair(value)) {
+        const auto& [bank, address] = std::get<std::pair<NumericValue, NumericValue>>(value);
+        if (!bank.IsInt() || !address.IsInt()) { MarkUnsupported(); }
+
+        UseRegister(target + 1u);
+        Emit({ .op = OpCode::LoadConst, .dst = target, .imm = bank.Get<int>() });
+        Emit({ .op = OpCode::LoadConst, .dst = static_cast<std::uint8_t>(target + 1u), .imm = address.Get<int>() });
+        m_resultType = ValueType::Pair;
+    }
+    else {
+        MarkUnsupported();
+    }
+    return {};
+}
+
+VisitorValue Compiler::VisitUnary(const Expr::Unary* expr) const {
+    const auto target = m_target;
+    const auto rightType = CompileExpression(expr->m_right.get(), target);
+
+    switch (expr->m_oper->GetType()) {
+        case TokenType::BANG:
+            if (rightType == ValueType::Pair) { break; }
+            Emit({ .op = OpCode::Not, .dst = target, .a = target });
+            m_resultType = ValueType::Bool;
+            return {};
+        case TokenType::MINUS:
+            if (rightType != ValueType::Int) { break; }
+            Emit({ .op = OpCode::Negate, .dst = target, .a = target });
+            m_resultType = ValueType::Int;
+            return {};
+        case TokenType::STAR:
+            if (rightType == ValueType::Pair) {
+                Emit({ .op = OpCode::ReadBankableMemory, .dst = target, .a = target, .b = static_cast<std::uint8_t>(target + 1u) });
+            }
+            else if (rightType == ValueType::Int) {
+                Emit({ .op = OpCode::ReadMemory, .dst = target, .a = target });
+            }
+            else {
+                break;
+            }
+            m_resultType = ValueType::Int;
+            return {};
+        default:
+            break;
+    }
+
+    MarkUnsupported();
+    return {};
+}
+
+VisitorValue Compiler::VisitVariable(const Expr::Variable* expr) const {
+    const auto id = m_callbacks.FindRegister(expr->m_name->GetLexeme());
+    if (id == InvalidRegisterId) { throw RuntimeError(expr->m_name, "Not a recognized identifier."); }
+
+    Emit({ .op = OpCode::LoadRegister, .dst = m_target, .imm = static_cast<std::int32_t>(id) });
+    m_resultType = ValueType::Int;
+    return {};
+}
+
+Compiler::ValueType Compiler::CompileExpression(const Expr::IExpr* expr, std::uint8_t target) const {
+    UseRegister(target);
+    const auto previousTarget = std::exchange(m_target, target);
+    expr->Accept(this);
+    m_target = previousTarget;
+    return m_resultType;
+}
+
+std::size_t Compiler::Emit(Bytecode::Instruction instruction) const {
+    m_program.instructions.push_back(instruction);
+    return m_program.instructions.size() - 1;
+}
+
+void Compiler::PatchJump(std::size_t jump) const {
+    m_program.instructions[jump].imm = static_cast<std::int32_t>(m_program.instructions.size());
+}
+
+void Compiler::UseRegister(std::size_t reg) const {
+    if (reg >= Bytecode::MaxRegisters) { MarkUnsupported(); }
+}
+
+void Compiler::MarkUnsupported() const {
+    // Keep walking so every identifier still gets bound and checked.
+    m_isSupported = false;
+}
+
+}
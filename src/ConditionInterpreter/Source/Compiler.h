@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Bytecode.h"
+#include "IAstVisitor.h"
+#include "IDebuggerCallbacks.h"
+#include "IExpr.h"
+
+#include <optional>
+
+namespace Rdb {
+
+// Lowers a parsed condition to bytecode. Expressions with values the register machine can't represent (doubles, strings,
+// bank pairs outside of a dereference, or mixed types that the interpreter treats specially) aren't compiled, those conditions
+// stay on the Interpreter.
+// Identifiers are bound to register ids while compiling, an unknown identifier throws RuntimeError even when the rest of the
+// expression isn't supported.
+class Compiler : public IAstVisitor {
+public:
+    static std::optional<Bytecode::Program> Compile(const Expr::IExprPtr& expr, IDebuggerCallbacks& callbacks);
+
+    VisitorValue VisitBinary(const Expr::Binary* expr) const override;
+    VisitorValue VisitGrouping(const Expr::Grouping* expr) const override;
+    VisitorValue VisitLogical(const Expr::Logical* expr) const override;
+    VisitorValue VisitLiteral(const Expr::Literal* expr) const override;
+    VisitorValue VisitUnary(const Expr::Unary* expr) const override;
+    VisitorValue VisitVariable(const Expr::Variable* expr) const override;
+
+private:
+    enum class ValueType {
+        Int,
+        Bool,
+        Pair, // Bank in the target register, address in the one after it
+    };
+
+    explicit Compiler(IDebuggerCallbacks& callbacks);
+
+    ValueType CompileExpression(const Expr::IExpr* expr, std::uint8_t target) const;
+    std::size_t Emit(Bytecode::Instruction instruction) const;
+    void PatchJump(std::size_t jump) const;
+    void UseRegister(std::size_t reg) const;
+    void MarkUnsupported() const;
+
+    IDebuggerCallbacks& m_callbacks;
+
+    // The visitor interface is const, compilation state is carried in these members.
+    mutable Bytecode::Program m_program = {};
+    mutable std::uint8_t m_target = 0;
+    mutable ValueType m_resultType = ValueType::Int;
+    mutable bool m_isSupported = true;
+};
+
+}
@@ -1,13 +1,48 @@
 #include "ConditionInterpreter.h"
 
+#include "Compiler.h"
 #include "Interpreter.h"
 #include "Parser.h"
 #include "Report.h"
 #include "Scanner.h"
+#include "VirtualMachine.h"
 
 
+namespace {
+// Both evaluation paths report a runtime error once and throw it with the same "[line N]" message.
+[[noreturn]] void ThrowRuntimeError(Errors& errors, const RuntimeError& error) {
+    if (!errors.HasRuntimeError()) { errors.ReportRuntimeError(error); } // The Interpreter reports its own.
+    throw std::runtime_error(errors.GetError());
+}
+}
+
 namespace Rdb {
 
+// Runs the compiled program when there is one, the program doesn't need an Interpreter or Errors unless it fails.
+template<typename RunFunc, typename InterpretFunc>
+auto ConditionInterpreter::Evaluate(RunFunc&& run, InterpretFunc&& interpret) const {
+    if (m_program) {
+        try {
+            return run();
+        }
+        catch (const RuntimeError& error) {
+            Errors errors;
+            ThrowRuntimeError(errors, error);
+        }
+    }
+
+    auto errors = std::make_shared<Errors>();
+    Interpreter interpreter(m_callbacks, errors);
+    try {
+        auto result = interpret(interpreter);
+        if (errors->HasError()) { throw std::runtime_error(errors->GetError()); }
+        return result;
+    }
+    catch (const RuntimeError& error) {
+        ThrowRuntimeError(*errors, error);
+    }
+}
+
 // Static Public
 ConditionPtr ConditionInterpreter::CreateCondition(std::shared_ptr<IDebuggerCallbacks> callbacks, const std::string& conditionString) {
     if (conditionString.empty()) { return nullptr; }
@@ -19,17 +54,19 @@ ConditionPtr ConditionInterpreter::CreateCondition(std::shared_ptr<IDebuggerCall
 
     Parser parser(errors, tokens);
     auto expr = parser.ParseWithThrow();
-    return std::unique_ptr<ConditionInterpreter>(new ConditionInterpreter(callbacks, expr, conditionString));
+    auto program = Compiler::Compile(expr, *callbacks);
+    return std::unique_ptr<ConditionInterpreter>(new ConditionInterpreter(callbacks, expr, std::move(program), conditionString));
 }
 
 // Public
 bool ConditionInterpreter::EvaluateCondition() const {
-    auto errors = std::make_shared<Errors>();
-    Interpreter interpreter(m_callbacks, errors);
-    bool expressionResult = interpreter.InterpretBoolean(m_conditionExpression);
-    if (errors->HasError()) { throw std::runtime_error(errors->GetError()); }
+    return Evaluate([this]() { return VirtualMachine::Run(*m_program, *m_callbacks); },
+                    [this](Interpreter& interpreter) { return interpreter.InterpretBoolean(m_conditionExpression); });
+}
 
-    return expressionResult;
+int ConditionInterpreter::EvaluateValue() const {
+    return Evaluate([this]() { return VirtualMachine::Evaluate(*m_program, *m_callbacks); },
+                    [this](Interpreter& interpreter) { return interpreter.InterpretInteger(m_conditionExpression); });
 }
 
 std::string ConditionInterpreter::GetAsString() const {
@@ -37,9 +74,10 @@ std::string ConditionInterpreter::GetAsString() const {
 }
 
 // Private
-ConditionInterpreter::ConditionInterpreter(std::shared_ptr<IDebuggerCallbacks> callbacks, Expr::IExprPtr expression, const std::string& conditionString) :
+ConditionInterpreter::ConditionInterpreter(std::shared_ptr<IDebuggerCallbacks> callbacks, Expr::IExprPtr expression, std::optional<Bytecode::Program> program, const std::string& conditionString) :
     m_callbacks(std::move(callbacks)),
     m_conditionExpression(std::move(expression)),
+    m_program(std::move(program)),
     m_conditionString(conditionString) {}
 
 }
\ No newline at end of file
@@ -1,8 +1,10 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <string>
 
+#include <Bytecode.h>
 #include <IDebuggerCallbacks.h>
 #include <IExpr.h>
 
@@ -14,14 +16,21 @@ public:
     static std::unique_ptr<ConditionInterpreter> CreateCondition(std::shared_ptr<IDebuggerCallbacks> callbacks, const std::string& conditionString);
 
     bool EvaluateCondition() const;
+    // The expression's value rather than whether it's truthy, such as a register for a tracepoint to record.
+    int EvaluateValue() const;
 
     std::string GetAsString() const;
 
 private:
-    ConditionInterpreter(std::shared_ptr<IDebuggerCallbacks> callbacks, Expr::IExprPtr expression, const std::string& conditionString);
+    // 'run' evaluates the compiled program, 'interpret' the expression when it couldn't be compiled.
+    template<typename RunFunc, typename InterpretFunc>
+    auto Evaluate(RunFunc&& run, InterpretFunc&& interpret) const;
+
+    ConditionInterpreter(std::shared_ptr<IDebuggerCallbacks> callbacks, Expr::IExprPtr expression, std::optional<Bytecode::Program> program, const std::string& conditionString);
 
     std::shared_ptr<IDebuggerCallbacks> m_callbacks;
     Expr::IExprPtr m_conditionExpression;
+    std::optional<Bytecode::Program> m_program; // Compiled form of the expression, when the Compiler supports it.
     std::string m_conditionString;
 };
 using ConditionPtr = std::unique_ptr<ConditionInterpreter>;
@@ -57,6 +57,20 @@ bool Interpreter::InterpretBoolean(const Expr::IExprPtr& expr) {
     }
 }
 
+int Interpreter::InterpretInteger(const Expr::IExprPtr& expr) {
+    if (expr == nullptr) { return 0; }
+    try {
+        const auto value = EvaluateExpression(expr.get());
+        if (IsNumeric(value)) { return GetValueAsInt(value); }
+
+        return IsTruthy(value) ? 1 : 0;
+    }
+    catch (const RuntimeError& error) {
+        m_errors->ReportRuntimeError(error);
+        throw;
+    }
+}
+
 VisitorValue Interpreter::VisitBinary(const Expr::Binary* expr) const {
     const auto left = EvaluateExpression(expr->m_left.get());
     const auto waitToEvaluateRight = expr->m_oper->GetType() == TokenType::QUESTION;
@@ -181,14 +195,12 @@ VisitorValue Interpreter::VisitUnary(const Expr::Unary* expr) const {
 }
 
 VisitorValue Interpreter::VisitVariable(const Expr::Variable* expr) const {
-    auto regset = m_callbacks->GetRegSet();
-
-    if (const auto& iter = regset.find(expr->m_name->GetLexeme());
-        iter == regset.end()) {
+    if (const auto id = m_callbacks->FindRegister(expr->m_name->GetLexeme());
+        id == InvalidRegisterId) {
         throw RuntimeError(expr->m_name, "Not a recognized identifier.");
     }
     else {
-        return VisitorValue{ static_cast<int>(iter->second) };
+        return VisitorValue{ static_cast<int>(m_callbacks->ReadRegister(id)) };
     }
 }
 
@@ -14,6 +14,8 @@ public:
 
     std::string InterpretAsString(const Expr::IExprPtr& expr);
     bool InterpretBoolean(const Expr::IExprPtr& expr);
+    // Numbers truncated to int, anything else 1 when truthy and 0 otherwise.
+    int InterpretInteger(const Expr::IExprPtr& expr);
 
     VisitorValue VisitBinary(const Expr::Binary* expr) const override;
     VisitorValue VisitGrouping(const Expr::Grouping* expr) const override;
@@ -0,0 +1,103 @@
+#include "VirtualMachine.h"
+
+#include "RuntimeError.h"
+
+#include <array>
+#include <limits>
+
+namespace {
+// Arithmetic is done unsigned so overflow wraps instead of being undefined.
+constexpr int Wrap(unsigned int value) {
+    return static_cast<int>(value);
+}
+}
+
+namespace Rdb {
+
+int VirtualMachine::Evaluate(const Bytecode::Program& program, IDebuggerCallbacks& callbacks) {
+    using Bytecode::OpCode;
+
+    std::array<int, Bytecode::MaxRegisters> r = {};
+    const auto* instructions = program.instructions.data();
+
+    std::size_t pc = 0;
+    while (true) {
+        const auto& [op, dst, a, b, imm] = instructions[pc++];
+        switch (op) {
+            case OpCode::LoadConst:
+                r[dst] = imm;
+                break;
+            case OpCode::LoadRegister:
+                r[dst] = static_cast<int>(callbacks.ReadRegister(RegisterId{ static_cast<unsigned int>(imm) }));
+                break;
+            case OpCode::ReadMemory:
+                r[dst] = static_cast<int>(callbacks.ReadMemory(static_cast<unsigned int>(r[a])));
+                break;
+            case OpCode::ReadBankableMemory:
+                r[dst] = static_cast<int>(callbacks.ReadBankableMemory(BankNum{ static_cast<unsigned int>(r[a]) }, static_cast<unsigned int>(r[b])));
+                break;
+            case OpCode::Move:
+                r[dst] = r[a];
+                break;
+            case OpCode::Not:
+                r[dst] = r[a] == 0 ? 1 : 0;
+                break;
+            case OpCode::Negate:
+                r[dst] = Wrap(0u - static_cast<unsigned int>(r[a]));
+                break;
+            case OpCode::Add:
+                r[dst] = Wrap(static_cast<unsigned int>(r[a]) + static_cast<unsigned int>(r[b]));
+                break;
+            case OpCode::Subtract:
+                r[dst] = Wrap(static_cast<unsigned int>(r[a]) - static_cast<unsigned int>(r[b]));
+                break;
+            case OpCode::Multiply:
+                r[dst] = Wrap(static_cast<unsigned int>(r[a]) * static_cast<unsigned int>(r[b]));
+                break;
+            case OpCode::Divide:
+                if (r[b] == 0) { throw RuntimeError(program.tokens[static_cast<std::size_t>(imm)], "Divide by zero error."); }
+                r[dst] = (r[a] == std::numeric_limits<int>::min() && r[b] == -1) ? r[a] : r[a] / r[b];
+                break;
+            case OpCode::BitwiseAnd:
+                r[dst] = r[a] & r[b];
+                break;
+            case OpCode::BitwiseOr:
+                r[dst] = r[a] | r[b];
+                break;
+            case OpCode::BitwiseXor:
+                r[dst] = r[a] ^ r[b];
+                break;
+            case OpCode::Equal:
+                r[dst] = r[a] == r[b];
+                break;
+            case OpCode::NotEqual:
+                r[dst] = r[a] != r[b];
+                break;
+            case OpCode::Greater:
+                r[dst] = r[a] > r[b];
+                break;
+            case OpCode::GreaterEqual:
+                r[dst] = r[a] >= r[b];
+                break;
+            case OpCode::Less:
+                r[dst] = r[a] < r[b];
+                break;
+            case OpCode::LessEqual:
+                r[dst] = r[a] <= r[b];
+                break;
+            case OpCode::Jump:
+                pc = static_cast<std::size_t>(imm);
+                break;
+            case OpCode::JumpIfFalse:
+                if (r[a] == 0) { pc = static_cast<std::size_t>(imm); }
+                break;
+            case OpCode::JumpIfTrue:
+                if (r[a] != 0) { pc = static_cast<std::size_t>(imm); }
+                break;
+            case OpCode::Return:
+                return r[a];
+        }
+    }
+}
+
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include "Bytecode.h"
+#include "IDebuggerCallbacks.h"
+
+namespace Rdb {
+
+class VirtualMachine {
+public:
+    // Runs a compiled condition and returns whether it's truthy. Throws RuntimeError the same way the Interpreter does.
+    static bool Run(const Bytecode::Program& program, IDebuggerCallbacks& callbacks) { return Evaluate(program, callbacks) != 0; }
+    // Runs a compiled expression and returns its value.
+    static int Evaluate(const Bytecode::Program& program, IDebuggerCallbacks& callbacks);
+};
+
+}
@@ -0,0 +1,117 @@
+#include "Compiler.h"
+
+#include "Interpreter.h"
+#include "MockDebuggerCallbacks.h"
+#include "Parser.h"
+#include "Scanner.h"
+#include "VirtualMachine.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include <string_view>
+
+using namespace Rdb;
+using namespace testing;
+
+namespace {
+Expr::IExprPtr Parse(std::string_view source) {
+    auto errors = std::make_shared<Errors>();
+    Scanner scanner(errors, source);
+    Parser parser(errors, scanner.ScanTokens());
+    return parser.ParseWithThrow();
+}
+}
+
+class CompilerTests : public ::testing::Test {
+public:
+    void SetUp() override {
+        ON_CALL(*m_callbacks, ReadMemory).WillByDefault([](unsigned int address) { return address + 1u; });
+        ON_CALL(*m_callbacks, ReadBankableMemory).WillByDefault([](BankNum bank, unsigned int address) { return static_cast<unsigned int>(bank) * 0x100u + address; });
+        ON_CALL(*m_callbacks, FindRegister).WillByDefault([](const std::string& name) {
+            if (name == "A") { return RegisterId{ 0 }; }
+            if (name == "HL") { return RegisterId{ 1 }; }
+            return InvalidRegisterId;
+        });
+        ON_CALL(*m_callbacks, ReadRegister).WillByDefault([](RegisterId id) { return id == RegisterId{ 0 } ? 5u : 0xC000u; });
+    }
+
+    // Checks the compiled program agrees with the tree walking interpreter.
+    void ExpectSameResult(std::string_view source) {
+        const auto expr = Parse(source);
+        const auto program = Compiler::Compile(expr, *m_callbacks);
+        ASSERT_TRUE(program.has_value()) << source;
+
+        Interpreter interpreter(m_callbacks, std::make_shared<Errors>());
+        EXPECT_EQ(VirtualMachine::Run(*program, *m_callbacks), interpreter.InterpretBoolean(expr)) << source;
+    }
+
+    std::shared_ptr<NiceMock<MockDebuggerCallbacks>> m_callbacks = std::make_shared<NiceMock<MockDebuggerCallbacks>>();
+};
+
+TEST_F(CompilerTests, Compile_MatchesInterpreter) {
+    static constexpr std::string_view expressions[] = {
+        "5 == 5",
+        "10 == 5",
+        "5 == 5 && (7 & 5) == 5",
+        "9",
+        "0",
+        "1 + 2 * 3 == 7",
+        "(1 + 2) * 3 != 9",
+        "10 / 3 == 3",
+        "-5 < 0",
+        "!0",
+        "!5",
+        "(6 > 2) == (6 >= 6)",
+        "3 <= 2 || 4 < 5",
+        "0 || 0",
+        "2 && 0",
+        "(5 == 5) == 1", // A bool is never equal to a number
+        "(5 == 5) != 1",
+        "1 ? 0 : 1",
+        "0 ? 0 : 7",
+        "1, 0",
+        "0, 1",
+        "A == 5",
+        "A + 1 == 6 && HL == 0xC000",
+        "*100 == 101",
+        "*(2:16) == 0x210",
+        "((1 | 2) ^ 7) == 4",
+    };
+
+    for (const auto expression : expressions) {
+        ExpectSameResult(expression);
+    }
+}
+
+TEST_F(CompilerTests, Compile_UnsupportedExpressions_FallBack) {
+    EXPECT_FALSE(Compiler::Compile(Parse("1.5 == 1.5"), *m_callbacks).has_value());
+    EXPECT_FALSE(Compiler::Compile(Parse("2:100"), *m_callbacks).has_value());
+    EXPECT_FALSE(Compiler::Compile(Parse("-(1 == 1)"), *m_callbacks).has_value());
+    EXPECT_FALSE(Compiler::Compile(Parse("1 || (1 == 1)"), *m_callbacks).has_value());
+    EXPECT_FALSE(Compiler::Compile(Parse("(1 | 2) ^ 7 == 4"), *m_callbacks).has_value()); // '==' binds tighter, a number xor a bool
+
+}
+
+TEST_F(CompilerTests, Run_DivideByZero_Throws) {
+    const auto program = Compiler::Compile(Parse("1 / (A - 5)"), *m_callbacks);
+    ASSERT_TRUE(program.has_value());
+    EXPECT_THROW(VirtualMachine::Run(*program, *m_callbacks), RuntimeError);
+}
+
+TEST_F(CompilerTests, Compile_UnknownRegister_Throws) {
+    EXPECT_CALL(*m_callbacks, ReadRegister).Times(0);
+    EXPECT_THROW(Compiler::Compile(Parse("B == 5"), *m_callbacks), RuntimeError);
+
+    // Checked even when the expression falls back to the interpreter.
+    EXPECT_THROW(Compiler::Compile(Parse("B == 1.5"), *m_callbacks), RuntimeError);
+}
+
+TEST_F(CompilerTests, Run_ReadsBoundRegistersOnly) {
+    const auto program = Compiler::Compile(Parse("A == 5 && A != 3"), *m_callbacks);
+    ASSERT_TRUE(program.has_value());
+
+    EXPECT_CALL(*m_callbacks, GetRegSet).Times(0);
+    EXPECT_CALL(*m_callbacks, ReadRegister(RegisterId{ 0 })).Times(2);
+    EXPECT_TRUE(VirtualMachine::Run(*program, *m_callbacks));
+}
@@ -63,18 +63,55 @@ TEST_F(ConditionInterpreterTests, SimpleConditions_StaticValues_HappyPath) {
 
 TEST_F(ConditionInterpreterTests, SimpleConditions_CheckRegisterValue_HappyPath) {
     static constexpr std::string_view registerA = "RegisterA";
+    static constexpr auto registerAId = RegisterId{ 3 };
     static constexpr auto testValue = 5;
-    RegSet regSet = { { std::string(registerA), 0 } };
-    EXPECT_CALL(*m_callbacks, GetRegSet).Times(1).WillRepeatedly(Return(regSet));
 
+    // Bound once when the condition is created, evaluation reads by id.
+    EXPECT_CALL(*m_callbacks, FindRegister(std::string(registerA))).Times(1).WillRepeatedly(Return(registerAId));
+    EXPECT_CALL(*m_callbacks, GetRegSet).Times(0);
     const auto condition = Rdb::ConditionInterpreter::CreateCondition(m_callbacks, fmt::format("{} == 5", registerA));
+
+    EXPECT_CALL(*m_callbacks, ReadRegister(registerAId)).Times(1).WillRepeatedly(Return(0));
     EXPECT_FALSE(condition->EvaluateCondition());
 
-    regSet[std::string(registerA)] = testValue;
-    EXPECT_CALL(*m_callbacks, GetRegSet).Times(1).WillRepeatedly(Return(regSet));
+    EXPECT_CALL(*m_callbacks, ReadRegister(registerAId)).Times(1).WillRepeatedly(Return(testValue));
     EXPECT_TRUE(condition->EvaluateCondition());
 }
 
+TEST_F(ConditionInterpreterTests, EvaluateValue_ReturnsExpressionValue) {
+    static constexpr auto registerAId = RegisterId{ 3 };
+
+    EXPECT_CALL(*m_callbacks, FindRegister(std::string("RegisterA"))).WillRepeatedly(Return(registerAId));
+    EXPECT_CALL(*m_callbacks, ReadRegister(registerAId)).WillRepeatedly(Return(0x42));
+    EXPECT_EQ(Rdb::ConditionInterpreter::CreateCondition(m_callbacks, "RegisterA")->EvaluateValue(), 0x42);
+    EXPECT_EQ(Rdb::ConditionInterpreter::CreateCondition(m_callbacks, "RegisterA + 2")->EvaluateValue(), 0x44);
+    EXPECT_EQ(Rdb::ConditionInterpreter::CreateCondition(m_callbacks, "RegisterA == 0x42")->EvaluateValue(), 1);
+}
+
+TEST_F(ConditionInterpreterTests, Evaluate_RuntimeError_ThrowsWithLine) {
+    EXPECT_CALL(*m_callbacks, ReadMemory(0x100)).WillRepeatedly(Return(0));
+    const auto condition = Rdb::ConditionInterpreter::CreateCondition(m_callbacks, "5 / *0x100 == 1");
+
+    // Compiled or interpreted, the error is reported with its line.
+    const auto expectRuntimeError = [](auto&& evaluate) {
+        try {
+            static_cast<void>(evaluate());
+            ADD_FAILURE() << "Expected a runtime error.";
+        }
+        catch (const std::runtime_error& error) {
+            EXPECT_THAT(error.what(), HasSubstr("Divide by zero error."));
+            EXPECT_THAT(error.what(), HasSubstr("[line"));
+        }
+    };
+    expectRuntimeError([&condition]() { return condition->EvaluateCondition(); });
+    expectRuntimeError([&condition]() { return condition->EvaluateValue(); });
+}
+
+TEST_F(ConditionInterpreterTests, SimpleConditions_UnknownRegister_ThrowsOnCreate) {
+    EXPECT_CALL(*m_callbacks, FindRegister).WillRepeatedly(Return(InvalidRegisterId));
+    EXPECT_THROW(Rdb::ConditionInterpreter::CreateCondition(m_callbacks, "RegisterB == 5"), std::runtime_error);
+}
+
 
 TEST_F(ConditionInterpreterTests, SimpleConditions_CheckAddress_HappyPath) {
     auto testMemory = 0;
@@ -5,10 +5,16 @@
 
 #include <fmt/core.h>
 
-#include <numeric>
+#include <algorithm>
+#include <filesystem>
 #include <stdexcept>
+#include <string>
+#include <vector>
 
 namespace {
+// Ranges from this size up, such as a whole ROM, are disassembled in parallel rather than through the instruction cache.
+constexpr size_t ParallelListSize = 0x4000;
+
 // Finds the first word in the command and the rest of the sentence. Will trim off spaces.
 std::pair<std::string_view, std::string_view> SplitFirstWord(std::string_view command) {
     // Find where first word starts and ends
@@ -25,7 +31,7 @@ std::pair<std::string_view, std::string_view> SplitFirstWord(std::string_view co
 
         // Only 1 word
         if (startCount != std::string_view::npos) {
-            return { { command.data() + startCount }, "" };
+            return { command.substr(startCount), "" };
         }
     }
 
@@ -34,9 +40,34 @@ std::pair<std::string_view, std::string_view> SplitFirstWord(std::string_view co
     //        ^
     const auto startCount2 = command.find_first_not_of(' ', endCount);
     if (startCount2 == std::string_view::npos) {
-        return { { command.data() + startCount, endCount }, {} };
+        return { command.substr(startCount, endCount - startCount), {} };
+    }
+    return { command.substr(startCount, endCount - startCount), command.substr(startCount2) };
+}
+
+std::vector<std::string> SplitWords(std::string_view sentence) {
+    std::vector<std::string> words;
+    while (!sentence.empty()) {
+        const auto [word, rest] = SplitFirstWord(sentence);
+        words.emplace_back(word);
+        sentence = rest;
+    }
+    return words;
+}
+
+// Expressions separated by ';', expressions can hold spaces and commas. Empty expressions are dropped.
+std::vector<std::string> SplitExpressions(std::string_view sentence) {
+    std::vector<std::string> expressions;
+    while (!sentence.empty()) {
+        const auto separator = sentence.find(';');
+        const auto expression = sentence.substr(0, separator);
+        sentence = separator == std::string_view::npos ? std::string_view{} : sentence.substr(separator + 1);
+
+        if (const auto start = expression.find_first_not_of(' '); start != std::string_view::npos) {
+            expressions.emplace_back(expression.substr(start, expression.find_last_not_of(' ') + 1 - start));
+        }
     }
-    return { { command.data() + startCount, endCount }, { command.data() + startCount2 } };
+    return expressions;
 }
 
 std::tuple<bool, BankNum, unsigned int> ParseAddress(std::string_view word) {
@@ -56,6 +87,19 @@ std::tuple<bool, BankNum, unsigned int> ParseAddress(std::string_view word) {
 
     return { false, {}, {} };
 }
+
+std::tuple<bool, BankNum, unsigned int, unsigned int> ParseAddressRange(std::string_view word) {
+    // <address>-<address>
+    // <bank>:<address>-<address>
+    const auto separator = word.find('-');
+    if (separator == std::string_view::npos) { return { false, {}, {}, {} }; }
+
+    const auto [isStartNumber, bank, startAddress] = ParseAddress(word.substr(0, separator));
+    const auto [isEndNumber, endAddress] = Rdb::ParseNumber(std::string(word.substr(separator + 1)));
+    if (!isStartNumber || !isEndNumber || endAddress < startAddress) { return { false, {}, {}, {} }; }
+
+    return { true, bank, startAddress, endAddress };
+}
 }
 
 namespace Rdb {
@@ -129,6 +173,18 @@ bool ConsoleInterpreter::AdvanceDebugger(const std::string& command) {
         else if (word == "l" || word == "list") {
             if (ListCommand(sentence)) { return false; }
         }
+        else if (word == "trace") {
+            if (TraceCommand(sentence)) { return false; }
+        }
+        else if (word == "tracepoint") {
+            if (TracepointCommand(sentence)) { return false; }
+        }
+        else if (word == "profile") {
+            if (ProfileCommand(sentence)) { return false; }
+        }
+        else if (word == "coverage") {
+            if (CoverageCommand(sentence)) { return false; }
+        }
         else if (word == "set") {
             if (SetCommand(sentence)) { return false; }
         }
@@ -377,6 +433,12 @@ bool ConsoleInterpreter::WatchCommand(std::string_view command) {
         return m_debugger->SetWatchpoint(address, bankNum) != std::numeric_limits<BreakNum>::max();
     }
 
+    // watch <address-address>
+    if (auto [isRange, bankNum, startAddress, endAddress] = ParseAddressRange(word);
+        isRange && sentence.empty()) {
+        return m_debugger->SetWatchpointRange(startAddress, endAddress, bankNum) != std::numeric_limits<BreakNum>::max();
+    }
+
     // watch <register>
     if (!word.empty() && sentence.empty()) {
         return m_debugger->SetWatchpoint(std::string(word)) != std::numeric_limits<BreakNum>::max();
@@ -395,6 +457,12 @@ bool ConsoleInterpreter::RwatchCommand(std::string_view command) {
         return m_debugger->SetReadWatchpoint(address, bankNum) != std::numeric_limits<BreakNum>::max();
     }
 
+    // rwatch <address-address>
+    if (auto [isRange, bankNum, startAddress, endAddress] = ParseAddressRange(word);
+        isRange && sentence.empty()) {
+        return m_debugger->SetReadWatchpointRange(startAddress, endAddress, bankNum) != std::numeric_limits<BreakNum>::max();
+    }
+
     // Unsure if worth supporting, would require some sort of feedback from emulator on every read.
     // watch <register>
     /*if (!word.empty() && sentence.empty()) {
@@ -412,7 +480,12 @@ bool ConsoleInterpreter::AwatchCommand(std::string_view command) {
     if (auto [isNumber, bankNum, address] = ParseAddress(word);
         isNumber && sentence.empty()) {
         return m_debugger->SetAnyWatchpoint(address, bankNum) != std::numeric_limits<BreakNum>::max();
-        return true;
+    }
+
+    // awatch <address-address>
+    if (auto [isRange, bankNum, startAddress, endAddress] = ParseAddressRange(word);
+        isRange && sentence.empty()) {
+        return m_debugger->SetAnyWatchpointRange(startAddress, endAddress, bankNum) != std::numeric_limits<BreakNum>::max();
     }
 
     // Unsure if worth supporting, would require some sort of feedback from emulator on every read.
@@ -431,7 +504,10 @@ bool ConsoleInterpreter::PrintCommand(std::string_view command) {
     if (sentence.empty()) {
         // print ("reg" || "register")
         if (word == "reg" || word == "registers") {
-            const auto regSet = m_callbacks->GetRegSet();
+            RegSet regSet;
+            for (const auto& reg : m_callbacks->GetRegisterFile()) {
+                regSet.emplace(reg.name, m_callbacks->ReadRegister(reg.id));
+            }
             SetCommandResponse(DebuggerPrintFormat::PrintAllRegisters(regSet));
             return true;
         }
@@ -444,11 +520,11 @@ bool ConsoleInterpreter::PrintCommand(std::string_view command) {
             return true;
         }
 
-        // print <register>
-        const auto regSet = m_callbacks->GetRegSet();
-        if (auto reg = regSet.find(std::string(word));
-            reg != regSet.end()) {
-            SetCommandResponse(DebuggerPrintFormat::PrintRegister(reg->first, reg->second) + "\n");
+        // print <register>, found in the register file rather than with FindRegister, printing doesn't hold on to an id.
+        const auto registers = m_callbacks->GetRegisterFile();
+        if (const auto reg = std::ranges::find(registers, word, &RegisterDescription::name);
+            reg != registers.end()) {
+            SetCommandResponse(DebuggerPrintFormat::PrintRegister(reg->name, m_callbacks->ReadRegister(reg->id)) + "\n");
             return true;
         }
     }
@@ -462,11 +538,8 @@ bool ConsoleInterpreter::ListCommand(std::string_view command) {
 
     const auto handleResponse = [this](const CommandList& commands) {
         if (!commands.empty()) {
-            auto command = commands.rbegin();
-            auto lastAddress = command->first;
-
-            const auto& args = command->second.arguments;
-            m_settings.listAddress = std::accumulate(args.begin(), args.end(), lastAddress + 1, [](auto sum, auto arg) { return sum + GetArgTypeLength(arg->type); });
+            const auto& [lastAddress, instruction] = *commands.rbegin();
+            m_settings.listAddress = lastAddress + instruction.length;
         }
     };
 
@@ -474,7 +547,7 @@ bool ConsoleInterpreter::ListCommand(std::string_view command) {
     if (word.empty()) {
         auto address = m_settings.listNext ? m_settings.listAddress : m_callbacks->GetPcReg();
         auto commands = m_debugger->GetCommandInfoList(address, static_cast<unsigned int>(m_settings.listSize));
-        SetCommandResponse(DebuggerPrintFormat::PrintInstructions(m_callbacks, commands));
+        SetCommandResponse(DebuggerPrintFormat::PrintInstructions(commands));
         handleResponse(commands);
         m_settings.listNext = true;
         return true;
@@ -484,7 +557,7 @@ bool ConsoleInterpreter::ListCommand(std::string_view command) {
     if (const auto [isNumber, address] = Rdb::ParseNumber(std::string(word));
         isNumber && sentence.empty()) {
         auto commands = m_debugger->GetCommandInfoList(address, static_cast<unsigned int>(m_settings.listSize));
-        SetCommandResponse(DebuggerPrintFormat::PrintInstructions(m_callbacks, commands));
+        SetCommandResponse(DebuggerPrintFormat::PrintInstructions(commands));
         handleResponse(commands);
         m_settings.listNext = true;
         return true;
@@ -498,9 +571,18 @@ bool ConsoleInterpreter::ListCommand(std::string_view command) {
             return false;
         }
 
-        auto commands = m_debugger->GetCommandInfoList(address1, size_t{ address2 }); // address to address
-        SetCommandResponse(DebuggerPrintFormat::PrintInstructions(m_callbacks, commands));
-        handleResponse(commands);
+        if (size_t{ address2 } - address1 < ParallelListSize) {
+            auto commands = m_debugger->GetCommandInfoList(address1, size_t{ address2 }); // address to address
+            SetCommandResponse(DebuggerPrintFormat::PrintInstructions(commands));
+            handleResponse(commands);
+        }
+        else {
+            const auto disassembly = m_debugger->Disassemble(address1, size_t{ address2 }); // may be a whole ROM
+            SetCommandResponse(DebuggerPrintFormat::PrintInstructions(disassembly));
+            if (!disassembly.empty()) {
+                m_settings.listAddress = disassembly.back().address + disassembly.back().instruction.length;
+            }
+        }
         m_settings.listNext = true;
         return true;
     }
@@ -509,6 +591,172 @@ bool ConsoleInterpreter::ListCommand(std::string_view command) {
     return false;
 }
 
+bool ConsoleInterpreter::TraceCommand(std::string_view command) {
+    static constexpr size_t DefaultTraceSize = 100'000;
+    m_settings.commandResponse.clear();
+    const auto [word, sentence] = SplitFirstWord(command);
+
+    // trace on [<count> [<reg> ...]]
+    if (word == "on") {
+        if (sentence.empty()) {
+            m_debugger->EnableTrace(DefaultTraceSize);
+            return true;
+        }
+
+        const auto [countWord, registers] = SplitFirstWord(sentence);
+        const auto [isNumber, count] = Rdb::ParseNumber(std::string(countWord));
+        if (!isNumber) { return false; }
+
+        m_debugger->EnableTrace(count, SplitWords(registers));
+        return true;
+    }
+
+    // trace file <path> [<reg> ...]
+    if (word == "file" && !sentence.empty()) {
+        const auto [path, registers] = SplitFirstWord(sentence);
+        m_debugger->EnableTraceFile(std::filesystem::path(path), SplitWords(registers));
+        return true;
+    }
+
+    // trace off
+    if (word == "off" && sentence.empty()) {
+        m_debugger->DisableTrace();
+        return true;
+    }
+
+    // trace dump [<count>]
+    if (word == "dump") {
+        auto count = m_settings.listSize;
+        if (!sentence.empty()) {
+            const auto [isNumber, number] = Rdb::ParseNumber(std::string(sentence));
+            if (!isNumber) { return false; }
+            count = number;
+        }
+        const auto records = m_debugger->GetTrace().Last(count);
+        SetCommandResponse(DebuggerPrintFormat::PrintTrace(records, m_debugger->GetTraceRegisters()));
+        return true;
+    }
+    return false;
+}
+
+bool ConsoleInterpreter::TracepointCommand(std::string_view command) {
+    m_settings.commandResponse.clear();
+    const auto [word, sentence] = SplitFirstWord(command);
+
+    // tracepoint log [<count>]
+    if (word == "log") {
+        auto count = m_settings.listSize;
+        if (!sentence.empty()) {
+            const auto [isNumber, number] = Rdb::ParseNumber(std::string(sentence));
+            if (!isNumber) { return false; }
+            count = number;
+        }
+        const auto hits = m_debugger->GetTracepointLog().Last(count);
+        SetCommandResponse(DebuggerPrintFormat::PrintTracepointLog(hits, m_debugger->GetBreakpointInfoList()));
+        return true;
+    }
+
+    // tracepoint clear
+    if (word == "clear" && sentence.empty()) {
+        m_debugger->ClearTracepointLog();
+        return true;
+    }
+
+    // tracepoint <address> [<expression>[; <expression> ...]]
+    if (auto [isNumber, bankNum, address] = ParseAddress(word);
+        isNumber) {
+        m_debugger->SetTracepoint(address, SplitExpressions(sentence), bankNum);
+        return true;
+    }
+    return false;
+}
+
+bool ConsoleInterpreter::ProfileCommand(std::string_view command) {
+    m_settings.commandResponse.clear();
+    const auto [word, sentence] = SplitFirstWord(command);
+
+    // profile on
+    if (word == "on" && sentence.empty()) {
+        m_debugger->EnableProfile();
+        return true;
+    }
+
+    // profile off
+    if (word == "off" && sentence.empty()) {
+        m_debugger->DisableProfile();
+        return true;
+    }
+
+    // profile [<count>]
+    auto count = m_settings.listSize;
+    if (!word.empty()) {
+        const auto [isNumber, number] = Rdb::ParseNumber(std::string(word));
+        if (!isNumber || !sentence.empty()) { return false; }
+        count = number;
+    }
+
+    // Banked addresses are disassembled from whichever bank is mapped there now.
+    const auto& profile = m_debugger->GetProfile();
+    const auto hotspots = profile.TopAddresses(count);
+    CommandList instructions;
+    for (const auto& hotspot : hotspots) {
+        instructions.merge(m_debugger->GetCommandInfoList(hotspot.address, 1U));
+    }
+    const auto ranges = profile.TopRanges(count);
+    std::vector<CommandList> listings;
+    for (const auto& range : ranges) {
+        listings.push_back(m_debugger->GetCommandInfoList(range.startAddress, size_t{ range.endAddress }));
+    }
+    SetCommandResponse(DebuggerPrintFormat::PrintProfile(profile.Total(), hotspots, instructions, ranges, listings));
+    return true;
+}
+
+bool ConsoleInterpreter::CoverageCommand(std::string_view command) {
+    m_settings.commandResponse.clear();
+    const auto [word, sentence] = SplitFirstWord(command);
+
+    // coverage on
+    if (word == "on" && sentence.empty()) {
+        m_debugger->EnableCoverage();
+        return true;
+    }
+
+    // coverage off
+    if (word == "off" && sentence.empty()) {
+        m_debugger->DisableCoverage();
+        return true;
+    }
+
+    // coverage save <path>
+    if (word == "save" && !sentence.empty()) {
+        m_debugger->GetCoverage().Save(std::filesystem::path(sentence));
+        return true;
+    }
+
+    // coverage
+    if (word.empty()) {
+        SetCommandResponse(DebuggerPrintFormat::PrintCoverage(m_debugger->GetCoverage()));
+        return true;
+    }
+
+    // coverage <address-address>
+    if (const auto [isNumber, address1, address2] = Rdb::ParseNumberPair(std::string(word), "-");
+        isNumber && sentence.empty() && address1 <= address2) {
+        Disassembly disassembly;
+        if (size_t{ address2 } - address1 < ParallelListSize) {
+            for (const auto& [address, instruction] : m_debugger->GetCommandInfoList(address1, size_t{ address2 })) {
+                disassembly.push_back({ address, instruction });
+            }
+        }
+        else {
+            disassembly = m_debugger->Disassemble(address1, size_t{ address2 });
+        }
+        SetCommandResponse(DebuggerPrintFormat::PrintInstructions(disassembly, m_debugger->GetCoverage()));
+        return true;
+    }
+    return false;
+}
+
 bool ConsoleInterpreter::SetCommand(std::string_view command) {
     m_settings.commandResponse.clear();
     const auto [word, sentence] = SplitFirstWord(command);
@@ -48,6 +48,10 @@ private:
     bool AwatchCommand(std::string_view command);
     bool PrintCommand(std::string_view command);
     bool ListCommand(std::string_view command);
+    bool TraceCommand(std::string_view command);
+    bool TracepointCommand(std::string_view command);
+    bool ProfileCommand(std::string_view command);
+    bool CoverageCommand(std::string_view command);
     bool SetCommand(std::string_view command);
     bool ShowCommand(std::string_view command);
 
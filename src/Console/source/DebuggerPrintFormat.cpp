@@ -6,9 +6,11 @@
 #include <NamedType/named_type.hpp>
 #include <fmt/core.h>
 
+#include <algorithm>
 #include <cstdio>
 #include <iomanip>
 #include <iostream>
+#include <iterator>
 #include <map>
 #include <numeric>
 #include <sstream>
@@ -27,6 +29,7 @@ static const std::map<BreakType, std::string> BreakTypeToString = {
     { BreakType::AnyWatchpoint, "AnyWatchpoint" },
     { BreakType::Breakpoint, "Breakpoint" },
     { BreakType::Catchpoint, "Catchpoint" },
+    { BreakType::Tracepoint, "Tracepoint" },
 };
 
 static const std::map<BreakDisposition, std::string> BreakDispToString = {
@@ -72,6 +75,36 @@ std::string to_string(BankNum bankNum) {
     return std::to_string(static_cast<unsigned int>(bankNum));
 }
 
+// "--" for AnyBank, when no bank was reported as mapped.
+std::string PrintBank(BankNum bank) {
+    return bank == AnyBank ? std::string("--") : fmt::format("{:02X}", static_cast<unsigned int>(bank));
+}
+
+std::string PrintInstruction(size_t address, const DecodedInstruction& instruction) {
+    std::stringstream msg;
+    msg << to_string(static_cast<uint16_t>(address), true) << "  " << instruction.Name() << "\t  "; // TODO: opcodeLength is not accounted for
+    std::string temp = msg.str();
+
+    if (instruction.operation != nullptr) {
+        const auto& arguments = instruction.operation->arguments;
+        for (auto index = 0U; index < arguments.size(); ++index) {
+            const auto& arg = arguments[index];
+            const auto value = instruction.argumentValues[index];
+            if (arg->indirectArg && arg->type != ArgumentType::REG) { temp += "("; }
+
+            if ((arg->type == ArgumentType::S8BIT) || (arg->type == ArgumentType::U8BIT)) { temp += to_string(static_cast<uint8_t>(value), true); }
+            else if ((arg->type == ArgumentType::S16BIT) || (arg->type == ArgumentType::U16BIT)) { temp += to_string(static_cast<uint16_t>(value), true); }
+            // else if ((arg->type == ArgumentType::S32BIT) || (arg->type == ArgumentType::U32BIT)) {}
+            else { temp += arg->name; }
+
+            if (arg->indirectArg && arg->type != ArgumentType::REG) { temp += ")"; }
+            if (index + 1 < arguments.size()) { temp += ", "; }
+        }
+    }
+    temp += "\n";
+    return temp;
+}
+
 // TODO: Command "info line" doesn't have much use right now. Maybe should remove.
 // TODO: Will need to do an optimization pass on string operations later.
 // TODO: Look for a more expandable solution. C++20 std::format may be worth looking at when available.
@@ -108,9 +141,9 @@ static constexpr std::string_view generalHelp =
     "(w)atch <address> -- break on next instruction that writes to the specified address and its value changes\n"
     "rwatch <address> -- break on next instruction that reads from the specified address and its value changes\n"
     "awatch <address> -- break on next instruction that either reads from or writes to the specified address and its value changes\n"
-    "(w)atch <address-address> -- break on next instruction that writes to the specified address and its value changes\n"
-    "rwatch <address-address> -- break on next instruction that reads from the specified address and its value changes\n"
-    "awatch <address-address> -- break on next instruction that reads from or writes to the specified address and its value changes\n"
+    "(w)atch <address-address> -- break on next instruction that writes to any address in the range\n"
+    "rwatch <address-address> -- break on next instruction that reads from any address in the range\n"
+    "awatch <address-address> -- break on next instruction that reads from or writes to any address in the range\n"
     ""
     "\n"
     "(p)rint <address> -- print value at address\n"
@@ -118,6 +151,26 @@ static constexpr std::string_view generalHelp =
     "(l)ist <address> -- print instructions at address\n"
     "(l)ist <address-address> -- print instructions from range of addresses\n"
     "\n"
+    "trace on -- record the last 100000 executed instructions\n"
+    "trace on <count> <reg> ... -- record the last count instructions, at most 1000000, along with up to 4 registers\n"
+    "trace file <path> <reg> ... -- stream every executed instruction to a binary trace file, read it with RdbTraceDump\n"
+    "trace off -- stop recording, the recorded instructions are kept and a trace file is closed\n"
+    "trace dump <count> -- print the last count recorded instructions\n"
+    "\n"
+    "tracepoint <address> <expression>; ... -- log up to 4 expressions each time address is executed, without stopping\n"
+    "tracepoint log <count> -- print the last count logged tracepoint hits\n"
+    "tracepoint clear -- empty the tracepoint log\n"
+    "\n"
+    "profile on -- count how often each address is executed, restarting the counts\n"
+    "profile off -- stop counting, the counts are kept\n"
+    "profile <count> -- print the count most executed addresses and ranges\n"
+    "\n"
+    "coverage on -- mark every address executed, read or written, restarting the coverage\n"
+    "coverage off -- stop marking, the coverage is kept\n"
+    "coverage -- print how much of the address space was executed, read and written\n"
+    "coverage <address-address> -- print instructions from range of addresses marked by their coverage\n"
+    "coverage save <path> -- write the coverage to a binary file\n"
+    "\n"
     "set <debugger variable> <count> -- set the size of list commands output\n"
     "show <debugger variable> -- print debugger variable value\n";
 }
@@ -144,7 +197,7 @@ std::string PrintBreakpointHit(BreakInfo breakInfo) {
 }
 
 std::string PrintWatchpointHit(BreakInfo breakInfo) {
-    return fmt::format("Watchpoint {}: at {}\nOld value = {}\nNew value = {}", static_cast<unsigned int>(breakInfo.breakpointNumber), to_string(static_cast<uint16_t>(breakInfo.address), true), breakInfo.oldWatchValue, breakInfo.currentWatchValue);
+    return fmt::format("Watchpoint {}: at {}\nOld value = {}\nNew value = {}", static_cast<unsigned int>(breakInfo.breakpointNumber), to_string(static_cast<uint16_t>(breakInfo.watchAddress), true), breakInfo.oldWatchValue, breakInfo.currentWatchValue);
 }
 
 std::string PrintTimerHelp() { return "TODO: write help\n"; }
@@ -166,7 +219,10 @@ std::string PrintBreakInfo(const BreakList& breakInfo) {
         Address,
         What);
     for (const auto& info : breakInfo) {
-        const auto what = (info.second.bankNumber != AnyBank) ? "Bank: "s + to_string(info.second.bankNumber) : ""s;
+        auto what = (info.second.bankNumber != AnyBank) ? "Bank: "s + to_string(info.second.bankNumber) : ""s;
+        if (info.second.length > 1) {
+            what += fmt::format("{}To: 0x{:016X}", what.empty() ? "" : " ", info.second.address + info.second.length - 1);
+        }
         breakInfoStr += fmt::format(
             "{: <8d}{: <15s}{: <5s}{: <4s}0x{:016X} {}\n",
             static_cast<unsigned int>(info.first),
@@ -176,7 +232,10 @@ std::string PrintBreakInfo(const BreakList& breakInfo) {
             info.second.address,
             what);
         if (info.second.condition != nullptr) {
-            breakInfoStr += fmt::format("{: <8}stop only if {}\n", std::string(), info.second.condition->GetAsString());
+            breakInfoStr += fmt::format("{: <8}{} only if {}\n", std::string(), info.second.type == BreakType::Tracepoint ? "trace" : "stop", info.second.condition->GetAsString());
+        }
+        for (const auto& value : info.second.traceValues) {
+            breakInfoStr += fmt::format("{: <8}collect {}\n", std::string(), value->GetAsString());
         }
         if (info.second.timesHit != 0U) {
             breakInfoStr += fmt::format("{} already hit {} times\n", BreakTypeToString.at(info.second.type), info.second.timesHit);
@@ -215,34 +274,137 @@ std::string PrintAddressInfo(const AddrInfo& info) {
     return msg.str();
 }
 
-std::string PrintInstructions(const std::shared_ptr<Rdb::IDebuggerCallbacks>& callbacks, const CommandList& commandInfo) {
+std::string PrintInstructions(const CommandList& commandInfo) {
     std::string temp;
-    for (const auto& info : commandInfo) {
-        std::stringstream msg;
-        msg << to_string(static_cast<uint16_t>(info.first), true) << "  " << info.second.info->name << "\t  "; // TODO: opcodeLength is not accounted for
+    for (const auto& [address, instruction] : commandInfo) {
+        temp += PrintInstruction(address, instruction);
+    }
+    return temp;
+}
 
-        // TODO: need to rethink this. Can't assume the memory value that is read from the callback.
-        temp += msg.str();
+std::string PrintInstructions(const Disassembly& disassembly) {
+    std::string temp;
+    for (const auto& [address, instruction] : disassembly) {
+        temp += PrintInstruction(address, instruction);
+    }
+    return temp;
+}
 
-        const auto byte = static_cast<uint8_t>(callbacks->ReadMemory(static_cast<unsigned int>(info.first) + 1));
-        const auto word = static_cast<uint16_t>((callbacks->ReadMemory(static_cast<unsigned int>(info.first) + 2U) << 8U) | byte); // TODO: Code smell, this doesn't look like the best way to do this!
+std::string PrintInstructions(const Disassembly& disassembly, const Rdb::CodeCoverage& coverage) {
+    const auto isCovered = [&coverage](Rdb::CoverageKind kind, const DisassembledInstruction& entry) {
+        for (auto offset = 0U; offset < std::max(entry.instruction.length, 1U); ++offset) {
+            if (coverage.IsCovered(kind, AnyBank, static_cast<unsigned int>(entry.address + offset))) { return true; }
+        }
+        return false;
+    };
 
-        for (const auto& arg : info.second.arguments) {
-            if (arg->indirectArg && arg->type != ArgumentType::REG) { temp += "("; }
+    std::string temp;
+    size_t executed = 0;
+    for (const auto& entry : disassembly) {
+        const auto isExecuted = coverage.IsCovered(Rdb::CoverageKind::Executed, AnyBank, static_cast<unsigned int>(entry.address));
+        executed += isExecuted ? 1 : 0;
+        temp += isExecuted ? 'X' : '-';
+        temp += isCovered(Rdb::CoverageKind::Read, entry) ? 'R' : '-';
+        temp += isCovered(Rdb::CoverageKind::Written, entry) ? 'W' : '-';
+        temp += "  " + PrintInstruction(entry.address, entry.instruction);
+    }
+    if (!disassembly.empty()) {
+        temp += fmt::format("{} of {} instructions executed ({:.1f}%).\n", executed, disassembly.size(),
+                            100.0 * static_cast<double>(executed) / static_cast<double>(disassembly.size()));
+    }
+    return temp;
+}
 
-            if ((arg->type == ArgumentType::S8BIT) || (arg->type == ArgumentType::U8BIT)) { temp += to_string(byte, true); }
-            else if ((arg->type == ArgumentType::S16BIT) || (arg->type == ArgumentType::U16BIT)) { temp += to_string(word, true); }
-            // else if ((arg->type == ArgumentType::S32BIT) || (arg->type == ArgumentType::U32BIT)) {}
-            else { temp += arg->name; }
+std::string PrintTrace(std::span<const Rdb::TraceRecord> records, const std::vector<std::string>& registers) {
+    if (records.empty()) { return "Trace is empty.\n"; }
 
-            if (arg->indirectArg && arg->type != ArgumentType::REG) { temp += ")"; }
-            if (arg != info.second.arguments.back()) { temp += ", "; }
+    std::string temp;
+    auto out = std::back_inserter(temp);
+    for (const auto& record : records) {
+        fmt::format_to(out, "{}  {}  ", to_string(static_cast<uint16_t>(record.pc), true), PrintBank(record.bank));
+
+        for (size_t i = 0; i < Rdb::TraceRecord::MaxBytes; ++i) {
+            if (i < record.length) { fmt::format_to(out, "{:02X} ", record.bytes[i]); }
+            else { temp += "   "; }
+        }
+        for (size_t i = 0; i < registers.size(); ++i) {
+            fmt::format_to(out, " {}={:#x}", registers[i], record.registers[i]);
+        }
+        temp += "\n";
+    }
+    return temp;
+}
+
+std::string PrintTracepointLog(std::span<const Rdb::TracepointHit> hits, const BreakList& tracepoints) {
+    if (hits.empty()) { return "Tracepoint log is empty.\n"; }
+
+    std::string temp;
+    auto out = std::back_inserter(temp);
+    for (const auto& hit : hits) {
+        fmt::format_to(out, "{}  #{}", to_string(static_cast<uint16_t>(hit.pc), true), static_cast<unsigned int>(hit.breakpointNumber));
+        // A deleted tracepoint's values are printed unlabelled.
+        const auto iter = tracepoints.find(hit.breakpointNumber);
+        for (size_t i = 0; i < hit.count; ++i) {
+            const auto value = (hit.errors & (1U << i)) != 0 ? std::string("<error>") : fmt::format("{:#x}", static_cast<unsigned int>(hit.values[i]));
+            if (iter != tracepoints.end() && i < iter->second.traceValues.size()) {
+                fmt::format_to(out, "  {}={}", iter->second.traceValues[i]->GetAsString(), value);
+            }
+            else {
+                fmt::format_to(out, "  {}", value);
+            }
         }
         temp += "\n";
     }
     return temp;
 }
 
+std::string PrintProfile(std::uint64_t total, std::span<const Rdb::ProfileHotspot> hotspots, const CommandList& instructions,
+                         std::span<const Rdb::ProfileRange> ranges, std::span<const CommandList> listings) {
+    if (total == 0) { return "No instructions profiled.\n"; }
+
+    const auto percent = [total](std::uint64_t count) { return 100.0 * static_cast<double>(count) / static_cast<double>(total); };
+    std::string temp;
+    auto out = std::back_inserter(temp);
+    fmt::format_to(out, "{} instructions profiled.\n\nHottest addresses:\n", total);
+    for (const auto& hotspot : hotspots) {
+        fmt::format_to(out, "{:>12}  {:5.1f}%  {}  ", hotspot.count, percent(hotspot.count), PrintBank(hotspot.bank));
+        if (const auto iter = instructions.find(hotspot.address); iter != instructions.end()) {
+            temp += PrintInstruction(iter->first, iter->second);
+        }
+        else {
+            temp += to_string(static_cast<uint16_t>(hotspot.address), true) + "\n";
+        }
+    }
+
+    temp += "\nHottest ranges:\n";
+    for (size_t i = 0; i < ranges.size(); ++i) {
+        const auto& range = ranges[i];
+        fmt::format_to(out, "{:>12}  {:5.1f}%  {}  {}-{}\n", range.count, percent(range.count), PrintBank(range.bank),
+                       to_string(static_cast<uint16_t>(range.startAddress), true), to_string(static_cast<uint16_t>(range.endAddress), true));
+        if (i < listings.size()) {
+            for (const auto& [address, instruction] : listings[i]) {
+                temp += "                            " + PrintInstruction(address, instruction);
+            }
+        }
+    }
+    return temp;
+}
+
+std::string PrintCoverage(const Rdb::CodeCoverage& coverage) {
+    const auto size = coverage.AddressSpaceSize();
+    if (size == 0) { return "No coverage recorded.\n"; }
+
+    std::string temp;
+    auto out = std::back_inserter(temp);
+    const auto print = [&out, size](std::string_view name, size_t count) {
+        fmt::format_to(out, "{:<9} {:>8} addresses  {:5.1f}%\n", name, count, 100.0 * static_cast<double>(count) / static_cast<double>(size));
+    };
+    print("Executed", coverage.Count(Rdb::CoverageKind::Executed));
+    print("Read", coverage.Count(Rdb::CoverageKind::Read));
+    print("Written", coverage.Count(Rdb::CoverageKind::Written));
+    return temp;
+}
+
 std::string PrintListsize(const unsigned int listsize) {
     return std::string("Number of source lines debugger will list by default is ") + std::to_string(listsize) + ".\n";
 }
@@ -1,11 +1,17 @@
 #pragma once
 
+#include <cstdint>
 #include <map>
+#include <span>
 #include <string>
 #include <vector>
 
+#include "CodeCoverage.h"
 #include "DebuggerCallbacks.h"
 #include "DebuggerCommon.h"
+#include "ExecutionProfile.h"
+#include "TraceBuffer.h"
+#include "TracepointLog.h"
 
 namespace DebuggerPrintFormat {
 // Help print
@@ -33,7 +39,23 @@ std::string PrintMemoryMappedRegInfo(const RegInfo& info);
 std::string PrintAddressInfo(const AddrInfo& info);
 
 // Opcode Instruction print
-std::string PrintInstructions(const std::shared_ptr<Rdb::IDebuggerCallbacks>& callbacks, const CommandList& commandInfo);
+std::string PrintInstructions(const CommandList& commandInfo);
+std::string PrintInstructions(const Disassembly& disassembly);
+// Marks each instruction X when executed, R and W when any of its bytes were read or written, followed by the executed share.
+std::string PrintInstructions(const Disassembly& disassembly, const Rdb::CodeCoverage& coverage);
+
+// Trace print, 'registers' names the traced registers in the order they were recorded.
+std::string PrintTrace(std::span<const Rdb::TraceRecord> records, const std::vector<std::string>& registers);
+
+// Tracepoint log print, values are labelled with the expressions of the tracepoints in 'tracepoints'.
+std::string PrintTracepointLog(std::span<const Rdb::TracepointHit> hits, const BreakList& tracepoints);
+
+// Profile print, 'instructions' holds the instruction at each hot address and 'listings' the instructions of each range.
+std::string PrintProfile(std::uint64_t total, std::span<const Rdb::ProfileHotspot> hotspots, const CommandList& instructions,
+                         std::span<const Rdb::ProfileRange> ranges, std::span<const CommandList> listings);
+
+// Coverage print, addresses of each kind covered out of the covered address space.
+std::string PrintCoverage(const Rdb::CodeCoverage& coverage);
 
 // Set Variable print
 std::string PrintListsize(unsigned int listsize);
@@ -0,0 +1,70 @@
+// Prints a binary trace file written by "trace file", see Rdb::TraceFileWriter.
+// Usage: RdbTraceDump <trace file> [<count>]
+// Prints every record, or only the last 'count' records.
+
+#include "DebuggerPrintFormat.h"
+#include "DebuggerStringParser.h"
+#include "TraceBuffer.h"
+#include "TraceFile.h"
+
+#include <fmt/core.h>
+
+#include <cstdio>
+#include <exception>
+#include <string>
+#include <vector>
+
+namespace {
+// Printed in batches so a trace of hours never has to fit in memory.
+static constexpr size_t BatchSize = 4096;
+
+void PrintAll(Rdb::TraceFileReader& reader) {
+    std::vector<Rdb::TraceRecord> batch;
+    batch.reserve(BatchSize);
+    while (const auto record = reader.Next()) {
+        batch.push_back(*record);
+        if (batch.size() == BatchSize) {
+            fmt::print("{}", DebuggerPrintFormat::PrintTrace(batch, reader.Registers()));
+            batch.clear();
+        }
+    }
+    if (!batch.empty()) {
+        fmt::print("{}", DebuggerPrintFormat::PrintTrace(batch, reader.Registers()));
+    }
+}
+
+void PrintLast(Rdb::TraceFileReader& reader, size_t count) {
+    Rdb::TraceBuffer last(count);
+    while (const auto record = reader.Next()) {
+        last.Append() = *record;
+    }
+    fmt::print("{}", DebuggerPrintFormat::PrintTrace(last.Last(count), reader.Registers()));
+}
+}
+
+int main(int argc, char** argv) {
+    if (argc != 2 && argc != 3) {
+        fmt::print(stderr, "Usage: RdbTraceDump <trace file> [<count>]\n");
+        return 1;
+    }
+
+    try {
+        Rdb::TraceFileReader reader(argv[1]); // NOLINT (cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        if (argc == 2) {
+            PrintAll(reader);
+            return 0;
+        }
+
+        const auto [isNumber, count] = Rdb::ParseNumber(std::string(argv[2])); // NOLINT (cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        if (!isNumber || count == 0) {
+            fmt::print(stderr, "RdbTraceDump: '{}' isn't a count.\n", argv[2]); // NOLINT (cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            return 1;
+        }
+        PrintLast(reader, count);
+    }
+    catch (const std::exception& e) {
+        fmt::print(stderr, "RdbTraceDump: {}\n", e.what());
+        return 1;
+    }
+    return 0;
+}
@@ -2,6 +2,7 @@
 
 #include "RetroDebuggerCommon.h"
 
+#include <array>
 #include <limits>
 
 enum DbgRegName {};
@@ -46,37 +47,6 @@ struct comp
     }
 };
 
-// TODO: clean this up
-// TODO: there is overlap with other structs here, need to clean up xml and then merge the ideas
-// TODO: remove AUTO, its not needed and should never be the end type
-enum class ArgumentType : int {
-    UNKOWN = 0,
-    AUTO,
-    CONSTANT,
-    REG,
-    CONDITIONAL,
-    S8BIT,
-    S16BIT,
-    S32BIT,
-    U8BIT,
-    U16BIT,
-    U32BIT
-};
-
-enum class RegOperationType : int {
-    NONE = 0,
-    POSTINC,
-    POSTDEC,
-    PREINC,
-    PREDEC,
-    REG_OFFSET_ADD,
-    REG_OFFSET_SUB,
-    REG_OFFSET_U8BIT,
-    REG_OFFSET_U16BIT,
-    REG_OFFSET_S8BIT,
-    REG_OFFSET_S16BIT
-};
-
 typedef unsigned int OpcodeLength;
 
 // TODO: is the Reset method a good idea?
@@ -187,7 +157,7 @@ struct Argument
     std::string name;
     std::string reg;
 };
-using ArgumentPtr = std::shared_ptr<Argument>;
+using ArgumentPtr = std::shared_ptr<const Argument>;
 
 // TODO: Consider adding error info
 struct OperationInfo
@@ -197,7 +167,7 @@ struct OperationInfo
     std::string name;
     bool isJump;
 };
-using OperationInfoPtr = std::shared_ptr<OperationInfo>;
+using OperationInfoPtr = std::shared_ptr<const OperationInfo>;
 
 struct Operation
 {
@@ -214,20 +184,28 @@ struct Operations
     ExtendedOpcodeToOperation extendedOperations = {};
 };
 
-inline unsigned int GetArgTypeLength(ArgumentType argType) {
-    switch (argType) {
-        case ArgumentType::S8BIT:
-        case ArgumentType::U8BIT:
-            return 1;
-        case ArgumentType::S16BIT:
-        case ArgumentType::U16BIT:
-            return 2;
-        case ArgumentType::S32BIT:
-        case ArgumentType::U32BIT:
-            return 4;
-        default:
-            return 0; // TODO: Should this fail?
-    }
-}
+// One decoded instruction, holds its own operand values so separate decodes never share state.
+// 'operation' points into the debugger's operation tables, valid until the operations are reset or set again.
+struct DecodedInstruction
+{
+    static constexpr size_t MaxArguments = 4;
+
+    [[nodiscard]] std::string Name() const { return operation != nullptr ? operation->info->name : std::to_string(opcode); }
+    [[nodiscard]] bool IsJump() const { return operation != nullptr && operation->info->isJump; }
+
+    const Operation* operation = nullptr; // Null for an undefined opcode.
+    unsigned int opcode = 0; // Last opcode read, names an undefined opcode.
+    unsigned int length = 0; // Size in bytes, opcodes and arguments.
+    std::array<unsigned int, MaxArguments> argumentValues = {}; // Immediate value read for each argument, by argument index.
+};
+
+using CommandList = std::map<size_t, DecodedInstruction>;
+
+struct DisassembledInstruction
+{
+    size_t address = 0;
+    DecodedInstruction instruction = {};
+};
 
-using CommandList = std::map<size_t, Operation>;
\ No newline at end of file
+// Instructions in address order, as produced by a bulk disassembly.
+using Disassembly = std::vector<DisassembledInstruction>;
\ No newline at end of file
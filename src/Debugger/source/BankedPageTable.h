@@ -0,0 +1,87 @@
+#pragma once
+
+#include "RetroDebuggerCommon.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace Rdb {
+
+// Per-address data kept apart for each bank mapped over an address, allocated a page of addresses at a time.
+// The data of the bank currently mapped over an address is one lookup through a table of slices, which MapBank updates.
+// Banks are tracked in slices of SliceSize addresses, a bank mapped part way into a slice is tracked from the next slice.
+// Each element holds the data of AddressesPerElement addresses, a slice never splits an element.
+template<typename ElementType, unsigned int PageSize, unsigned int SliceSize, unsigned int AddressesPerElement = 1>
+class BankedPageTable {
+    static_assert(SliceSize % AddressesPerElement == 0 && PageSize % SliceSize == 0);
+
+public:
+    using Page = std::array<ElementType, PageSize / AddressesPerElement>;
+    using PageKey = std::pair<BankNum, unsigned int>; // Bank and page number.
+
+    // Drops all the data and tracks addresses below 'addressSpaceSize', every address starts out in AnyBank.
+    void Reset(size_t addressSpaceSize) {
+        m_pages.clear();
+        const auto sliceCount = (addressSpaceSize + SliceSize - 1) / SliceSize;
+        m_slices.assign(sliceCount, nullptr);
+        m_sliceBanks.assign(sliceCount, AnyBank);
+        if (addressSpaceSize != 0) {
+            MapBank(AnyBank, 0, static_cast<unsigned int>(addressSpaceSize - 1));
+        }
+    }
+
+    // 'bank' is now mapped over [startAddress, endAddress].
+    void MapBank(BankNum bank, unsigned int startAddress, unsigned int endAddress) {
+        const auto firstSlice = (static_cast<size_t>(startAddress) + SliceSize - 1) / SliceSize;
+        const auto lastSlice = std::min<size_t>(endAddress / SliceSize, m_slices.size() - 1);
+        for (auto slice = firstSlice; slice <= lastSlice && slice < m_slices.size(); ++slice) {
+            m_slices[slice] = Get(bank, static_cast<unsigned int>(slice * SliceSize));
+            m_sliceBanks[slice] = bank;
+        }
+    }
+
+    // First element of the mapped bank's slice holding 'address', null outside the tracked address space.
+    [[nodiscard]] ElementType* Mapped(unsigned int address) {
+        const auto slice = address / SliceSize;
+        return slice < m_slices.size() ? m_slices[slice] : nullptr;
+    }
+
+    [[nodiscard]] const ElementType* Mapped(unsigned int address) const {
+        const auto slice = address / SliceSize;
+        return slice < m_slices.size() ? m_slices[slice] : nullptr;
+    }
+
+    // Only meaningful inside the tracked address space.
+    [[nodiscard]] BankNum MappedBank(unsigned int address) const { return m_sliceBanks[address / SliceSize]; }
+    [[nodiscard]] bool Contains(unsigned int address) const { return address / SliceSize < m_slices.size(); }
+
+    // Element of 'address' in 'bank', its page is allocated if it has none yet.
+    ElementType* Get(BankNum bank, unsigned int address) {
+        auto& page = m_pages[{ bank, address / PageSize }];
+        if (!page) {
+            page = std::make_unique<Page>();
+        }
+        return page->data() + ((address % PageSize) / AddressesPerElement);
+    }
+
+    // Null when the page of 'address' in 'bank' was never allocated.
+    [[nodiscard]] const ElementType* Find(BankNum bank, unsigned int address) const {
+        const auto iter = m_pages.find({ bank, address / PageSize });
+        return iter == m_pages.end() ? nullptr : iter->second->data() + ((address % PageSize) / AddressesPerElement);
+    }
+
+    // Ordered by bank then address.
+    [[nodiscard]] const std::map<PageKey, std::unique_ptr<Page>>& Pages() const { return m_pages; }
+
+private:
+    std::map<PageKey, std::unique_ptr<Page>> m_pages = {};
+    std::vector<ElementType*> m_slices = {}; // Data of the bank currently mapped over each slice.
+    std::vector<BankNum> m_sliceBanks = {};
+};
+
+}
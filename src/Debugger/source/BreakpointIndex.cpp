@@ -0,0 +1,77 @@
+#include "BreakpointIndex.h"
+
+#include <algorithm>
+
+namespace {
+bool InsertSorted(std::vector<BreakInfo*>& list, BreakInfo& breakInfo) {
+    const auto iter = std::ranges::lower_bound(list, breakInfo.breakpointNumber, {}, &BreakInfo::breakpointNumber);
+    if (iter != list.end() && (*iter)->breakpointNumber == breakInfo.breakpointNumber) { return false; }
+
+    list.insert(iter, &breakInfo);
+    return true;
+}
+
+void EraseSorted(std::vector<BreakInfo*>& list, BreakNum breakNum) {
+    if (const auto iter = std::ranges::lower_bound(list, breakNum, {}, &BreakInfo::breakpointNumber);
+        iter != list.end() && (*iter)->breakpointNumber == breakNum) {
+        list.erase(iter);
+    }
+}
+}
+
+namespace Rdb {
+
+void BreakpointIndex::Insert(BreakInfo& breakInfo) {
+    auto& entry = m_entries[breakInfo.address];
+    if (breakInfo.bankNumber == AnyBank) {
+        InsertSorted(entry.unbanked, breakInfo);
+    }
+    else {
+        InsertSorted(entry.banked[breakInfo.bankNumber], breakInfo);
+    }
+
+    if (breakInfo.address < DenseAddressLimit) {
+        m_denseAddresses[breakInfo.address / BitsPerWord] |= std::uint64_t{ 1 } << (breakInfo.address % BitsPerWord);
+    }
+}
+
+void BreakpointIndex::Erase(const BreakInfo& breakInfo) {
+    auto entryIter = m_entries.find(breakInfo.address);
+    if (entryIter == m_entries.end()) { return; }
+
+    auto& entry = entryIter->second;
+    if (breakInfo.bankNumber == AnyBank) {
+        EraseSorted(entry.unbanked, breakInfo.breakpointNumber);
+    }
+    else if (auto bankIter = entry.banked.find(breakInfo.bankNumber);
+             bankIter != entry.banked.end()) {
+        EraseSorted(bankIter->second, breakInfo.breakpointNumber);
+        if (bankIter->second.empty()) { entry.banked.erase(bankIter); }
+    }
+
+    if (entry.unbanked.empty() && entry.banked.empty()) {
+        m_entries.erase(entryIter);
+        if (breakInfo.address < DenseAddressLimit) {
+            m_denseAddresses[breakInfo.address / BitsPerWord] &= ~(std::uint64_t{ 1 } << (breakInfo.address % BitsPerWord));
+        }
+    }
+}
+
+void BreakpointIndex::Clear() {
+    m_entries.clear();
+    m_denseAddresses.fill(0);
+}
+
+const BreakpointIndex::AddressEntry* BreakpointIndex::Find(unsigned int address) const {
+    if (address < DenseAddressLimit) {
+        if ((m_denseAddresses[address / BitsPerWord] & (std::uint64_t{ 1 } << (address % BitsPerWord))) == 0) { return nullptr; }
+    }
+    else if (m_entries.empty()) {
+        return nullptr;
+    }
+
+    const auto iter = m_entries.find(address);
+    return iter != m_entries.end() ? &iter->second : nullptr;
+}
+
+}
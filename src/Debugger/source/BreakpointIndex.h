@@ -0,0 +1,38 @@
+#pragma once
+
+#include "RetroDebuggerCommon.h"
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+namespace Rdb {
+
+// Address lookup for enabled code breakpoints, so the per-instruction check is a single probe instead of a walk over every breakpoint.
+// Entries point into the BreakpointManager's list and are kept in breakpoint number order.
+class BreakpointIndex {
+public:
+    struct AddressEntry {
+        std::vector<BreakInfo*> unbanked = {};
+        std::map<BankNum, std::vector<BreakInfo*>> banked = {};
+    };
+
+    void Insert(BreakInfo& breakInfo);
+    void Erase(const BreakInfo& breakInfo);
+    void Clear();
+
+    [[nodiscard]] const AddressEntry* Find(unsigned int address) const;
+    [[nodiscard]] bool Empty() const { return m_entries.empty(); }
+
+private:
+    // Addresses in the first 64K are filtered through a bitmap first, which covers the whole address space of most 8-bit systems.
+    static constexpr unsigned int DenseAddressLimit = 0x10000u;
+    static constexpr unsigned int BitsPerWord = 64u;
+
+    std::array<std::uint64_t, DenseAddressLimit / BitsPerWord> m_denseAddresses = {};
+    std::unordered_map<unsigned int, AddressEntry> m_entries = {};
+};
+
+}
@@ -1,10 +1,24 @@
 #pragma once
 
+#include "BreakpointIndex.h"
+#include "ConditionInterpreter.h"
 #include "DebuggerCommon.h"
+#include "DebuggerError.h"
+#include "DebuggerOperations.h"
 #include "IDebuggerCallbacks.h"
+#include "MemoryAccessBuffer.h"
+#include "TracepointLog.h"
+#include "WatchpointIndex.h"
 
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <concepts>
 #include <limits>
 #include <map>
+#include <memory>
+#include <span>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -13,9 +27,13 @@ namespace Rdb {
 static constexpr BreakNum MaxBreakpointNumber = BreakNum{ std::numeric_limits<unsigned int>::max() };
 static constexpr unsigned int MaxAddress = std::numeric_limits<unsigned int>::max();
 
-class DebuggerOperations;
+// Callbacks the breakpoint manager can be built on. Passing a concrete 'final' type lets the compiler
+// devirtualize and inline the PC and memory reads made every instruction, IDebuggerCallbacks keeps them type-erased.
+template<typename CallbacksType>
+concept DebuggerCallbacksType = std::derived_from<CallbacksType, IDebuggerCallbacks>;
 
-class BreakpointManager {
+template<DebuggerCallbacksType CallbacksType>
+class BasicBreakpointManager {
     enum class DebugOperation {
         RunOp = 0,
         StepOp,
@@ -23,7 +41,9 @@ class BreakpointManager {
     };
 
 public:
-    explicit BreakpointManager(std::shared_ptr<DebuggerOperations> operations, std::shared_ptr<IDebuggerCallbacks> callbacks);
+    static constexpr size_t DefaultTracepointLogSize = 10'000;
+
+    explicit BasicBreakpointManager(std::shared_ptr<DebuggerOperations> operations, std::shared_ptr<CallbacksType> callbacks);
 
     bool CheckBreakpoints(BreakInfo& breakInfo);
 
@@ -35,10 +55,21 @@ public:
 
     void SetCondition(BreakNum breakNum, const std::string& condition);
 
+    // Logs the value of up to TracepointHit::MaxValues expressions each time 'address' is executed, without stopping.
+    // The log is allocated with the first tracepoint.
+    BreakNum SetTracepoint(unsigned int address, const std::vector<std::string>& expressions, BankNum bank = AnyBank);
+    [[nodiscard]] const TracepointLog& GetTracepointLog() const { return m_tracepointLog; }
+    void ClearTracepointLog() { m_tracepointLog.Clear(); }
+
     BreakNum SetWatchpoint(unsigned int address, BankNum bank = AnyBank);
     BreakNum SetReadWatchpoint(unsigned int address, BankNum bank = AnyBank);
     BreakNum SetAnyWatchpoint(unsigned int address, BankNum bank = AnyBank);
 
+    // Watch every address from 'address' to 'endAddress', inclusive.
+    BreakNum SetWatchpointRange(unsigned int address, unsigned int endAddress, BankNum bank = AnyBank);
+    BreakNum SetReadWatchpointRange(unsigned int address, unsigned int endAddress, BankNum bank = AnyBank);
+    BreakNum SetAnyWatchpointRange(unsigned int address, unsigned int endAddress, BankNum bank = AnyBank);
+
     BreakNum SetWatchpoint(const std::string& name);
     // Do we want to watch reads of registers? Would require a feedback from emulator and would likely not have value.
     /*BreakNum SetReadWatchpoint(const std::string& name);
@@ -50,22 +81,674 @@ public:
     BreakList GetBreakpointInfoList(const std::vector<BreakNum>& list = {});
 
     // Hooks
-    void ReadMemoryHook(BankNum bankNum, unsigned int address, const std::vector<std::byte>& bytes);
-    void WriteMemoryHook(BankNum bankNum, unsigned int address, const std::vector<std::byte>& bytes);
+    void ReadMemoryHook(BankNum bankNum, unsigned int address, std::span<const std::byte> bytes);
+    void WriteMemoryHook(BankNum bankNum, unsigned int address, std::span<const std::byte> bytes);
+    // Single access of 'width' bytes, nothing is copied or allocated.
+    void ReadMemoryHook(BankNum bankNum, unsigned int address, unsigned int value, unsigned int width);
+    void WriteMemoryHook(BankNum bankNum, unsigned int address, unsigned int value, unsigned int width);
+    // Kept so brace lists still convert, spans can't be built from an initializer list.
+    void ReadMemoryHook(BankNum bankNum, unsigned int address, const std::vector<std::byte>& bytes) { ReadMemoryHook(bankNum, address, std::span<const std::byte>{ bytes }); }
+    void WriteMemoryHook(BankNum bankNum, unsigned int address, const std::vector<std::byte>& bytes) { WriteMemoryHook(bankNum, address, std::span<const std::byte>{ bytes }); }
+    // Every access made during an instruction in one call.
+    void MemoryAccessHook(std::span<const MemoryAccess> accesses);
 
 private:
+    BreakNum NextBreakNum();
+    BreakNum AddBreakInfo(const BreakInfo& breakInfo);
+    void IndexBreakInfo(BreakInfo& breakInfo);
+    void UnindexBreakInfo(const BreakInfo& breakInfo);
     BreakInfo CheckBreakInfo();
+    // True when 'breakInfo' stops execution, a tracepoint is logged and execution continues.
+    bool HitCodeBreakpoint(BreakInfo& breakInfo, unsigned int pc);
+    bool HitWatchpoint(BreakInfo& breakInfo);
+    bool HitWatchpointRange(BreakInfo& breakInfo);
     bool HandleBreakInfo(const BreakInfo& info);
     bool ModifyBreak(const std::vector<BreakNum>& list, bool isEnabled);
 
     std::map<BreakNum, BreakInfo> m_breakpoints = {};
+    // Lookups into m_breakpoints, map nodes are stable so these stay valid until the breakpoint is deleted.
+    BreakpointIndex m_breakpointIndex = {};
+    WatchpointIndex m_readWatchIndex = {};
+    WatchpointIndex m_writeWatchIndex = {};
+    std::vector<BreakInfo*> m_watchpoints = {}; // In breakpoint number order.
+    std::vector<BreakInfo*> m_codeCandidates = {}; // Reused by CheckBreakInfo, so checking doesn't allocate.
+    TracepointLog m_tracepointLog;
     std::shared_ptr<DebuggerOperations> m_operations;
-    std::shared_ptr<IDebuggerCallbacks> m_callbacks;
+    std::shared_ptr<CallbacksType> m_callbacks;
 
     DebugOperation m_debugOp = DebugOperation::RunOp;
     unsigned int m_instructionsToStep = 0;
 
     BreakNum m_breakPointCounter = BreakNum{ 1 };
+    bool m_hooksReportAccesses = false; // Set by the first memory hook, ranged watchpoints stop polling every address.
 };
 
+namespace Detail {
+inline BreakInfo BreakPoint(BreakNum breakNumber, unsigned int address, BankNum bankNumber = AnyBank) {
+    return BreakInfo{
+        .address = address,
+        .breakpointNumber = breakNumber,
+        .bankNumber = bankNumber,
+        .type = BreakType::Breakpoint,
+    };
+}
+
+template<DebuggerCallbacksType CallbacksType>
+unsigned int ReadWatchedMemory(CallbacksType& callbacks, BankNum bankNumber, unsigned int address) {
+    return bankNumber == AnyBank ? callbacks.ReadMemory(address) : callbacks.ReadBankableMemory(bankNumber, address);
+}
+
+// Only kept for ranges, a single address is compared against currentWatchValue.
+template<DebuggerCallbacksType CallbacksType>
+std::vector<unsigned int> ReadRangeWatchValues(CallbacksType& callbacks, BankNum bankNumber, unsigned int address, unsigned int length) {
+    std::vector<unsigned int> values = {};
+    if (length > 1) {
+        values.reserve(length);
+        for (auto offset = 0u; offset < length; ++offset) {
+            values.push_back(ReadWatchedMemory(callbacks, bankNumber, address + offset));
+        }
+    }
+    return values;
+}
+
+template<DebuggerCallbacksType CallbacksType>
+BreakInfo WatchPoint(CallbacksType& callbacks, BreakNum breakNumber, unsigned int address, BankNum bankNumber = AnyBank, unsigned int length = 1) {
+    return BreakInfo{
+        .address = address,
+        .length = length,
+        .breakpointNumber = breakNumber,
+        .bankNumber = bankNumber,
+        .currentWatchValue = callbacks.ReadMemory(address),
+        .watchAddress = address,
+        .rangeWatchValues = ReadRangeWatchValues(callbacks, bankNumber, address, length),
+        .type = BreakType::Watchpoint,
+    };
+}
+
+template<DebuggerCallbacksType CallbacksType>
+BreakInfo ReadWatchPoint(CallbacksType& callbacks, BreakNum breakNumber, unsigned int address, BankNum bankNumber = AnyBank, unsigned int length = 1) {
+    return BreakInfo{
+        .address = address,
+        .length = length,
+        .breakpointNumber = breakNumber,
+        .bankNumber = bankNumber,
+        .currentWatchValue = callbacks.ReadMemory(address),
+        .watchAddress = address,
+        .type = BreakType::ReadWatchpoint,
+    };
+}
+
+template<DebuggerCallbacksType CallbacksType>
+BreakInfo AnyWatchPoint(CallbacksType& callbacks, BreakNum breakNumber, unsigned int address, BankNum bankNumber = AnyBank, unsigned int length = 1) {
+    return BreakInfo{
+        .address = address,
+        .length = length,
+        .breakpointNumber = breakNumber,
+        .bankNumber = bankNumber,
+        .currentWatchValue = callbacks.ReadMemory(address),
+        .watchAddress = address,
+        .rangeWatchValues = ReadRangeWatchValues(callbacks, bankNumber, address, length),
+        .type = BreakType::AnyWatchpoint,
+    };
+}
+
+inline BreakInfo TracePoint(BreakNum breakNumber, unsigned int address, BankNum bankNumber = AnyBank) {
+    return BreakInfo{
+        .address = address,
+        .breakpointNumber = breakNumber,
+        .bankNumber = bankNumber,
+        .type = BreakType::Tracepoint,
+    };
+}
+
+// Found by the PC rather than by watching memory.
+inline bool IsCodeBreakpoint(const BreakInfo& breakInfo) {
+    return breakInfo.type == BreakType::Breakpoint || breakInfo.type == BreakType::Tracepoint;
+}
+
+// Number of addresses in an inclusive range.
+inline unsigned int RangeLength(unsigned int address, unsigned int endAddress) {
+    if (endAddress < address || (endAddress - address) == std::numeric_limits<unsigned int>::max()) {
+        throw DebuggerError(fmt::format("Invalid watch range 0x{:X}-0x{:X}.", address, endAddress));
+    }
+    return endAddress - address + 1;
+}
+
+// TODO: May want to consider redoing design so we return the BreakInfo instead of tunneling a BreakInfo object.
+// Current design has breakpoint info passed in as ref so it can be assigned, this represents an invalid or uninteresting breakpoint.
+inline BreakInfo ContinuePoint() {
+    return BreakInfo{
+        .breakpointNumber = MaxBreakpointNumber,
+        .disp = BreakDisposition::Delete,
+        .isEnabled = false,
+    };
+}
+
+// Watch a register
+template<DebuggerCallbacksType CallbacksType>
+BreakInfo WatchPoint(CallbacksType& callbacks, BreakNum breakNumber, const std::string& registerName) {
+    if (const auto id = callbacks.FindRegister(registerName);
+        id != InvalidRegisterId) {
+        return BreakInfo{
+            .address = std::numeric_limits<unsigned int>::max(),
+            .breakpointNumber = breakNumber,
+            .currentWatchValue = callbacks.ReadRegister(id),
+            .type = BreakType::Watchpoint,
+            .regName = registerName,
+            .registerId = id,
+        };
+    }
+    else {
+        throw DebuggerError(fmt::format("Failed to watch unrecognized identifier '{}'.", registerName));
+    }
+}
+
+template<DebuggerCallbacksType CallbacksType>
+BreakInfo ReadWatchPoint(CallbacksType& callbacks, BreakNum breakNumber, const std::string& registerName) {
+    if (const auto id = callbacks.FindRegister(registerName);
+        id != InvalidRegisterId) {
+        return BreakInfo{
+            .address = std::numeric_limits<unsigned int>::max(),
+            .breakpointNumber = breakNumber,
+            .currentWatchValue = callbacks.ReadRegister(id),
+            .type = BreakType::ReadWatchpoint,
+            .regName = registerName,
+            .registerId = id,
+        };
+    }
+    else {
+        throw DebuggerError(fmt::format("Failed to watch unrecognized identifier '{}'.", registerName));
+    }
+}
+
+template<DebuggerCallbacksType CallbacksType>
+BreakInfo AnyWatchPoint(CallbacksType& callbacks, BreakNum breakNumber, const std::string& registerName) {
+    if (const auto id = callbacks.FindRegister(registerName);
+        id != InvalidRegisterId) {
+        return BreakInfo{
+            .address = std::numeric_limits<unsigned int>::max(),
+            .breakpointNumber = breakNumber,
+            .currentWatchValue = callbacks.ReadRegister(id),
+            .type = BreakType::AnyWatchpoint,
+            .regName = registerName,
+            .registerId = id,
+        };
+    }
+    else {
+        throw DebuggerError(fmt::format("Failed to watch unrecognized identifier '{}'.", registerName));
+    }
+}
+
+template<DebuggerCallbacksType CallbacksType>
+unsigned int GetWatchpointValue(CallbacksType& callbacks, const BreakInfo& breakInfo) {
+    if (breakInfo.isEnabled) {
+        if (breakInfo.regName.empty()) {
+            return breakInfo.bankNumber == AnyBank ? callbacks.ReadMemory(breakInfo.address) : callbacks.ReadBankableMemory(breakInfo.bankNumber, breakInfo.address);
+        }
+        else {
+            return callbacks.ReadRegister(breakInfo.registerId);
+        }
+    }
+    return {};
+}
+
+// Offset of the first address of a ranged watchpoint whose value changed, the range's length when none did.
+template<DebuggerCallbacksType CallbacksType>
+size_t FindChangedOffset(CallbacksType& callbacks, const BreakInfo& breakInfo) {
+    for (size_t offset = 0; offset < breakInfo.rangeWatchValues.size(); ++offset) {
+        if (ReadWatchedMemory(callbacks, breakInfo.bankNumber, breakInfo.address + static_cast<unsigned int>(offset)) != breakInfo.rangeWatchValues[offset]) {
+            return offset;
+        }
+    }
+    return breakInfo.rangeWatchValues.size();
+}
+
+}
+
+template<DebuggerCallbacksType CallbacksType>
+BasicBreakpointManager<CallbacksType>::BasicBreakpointManager(std::shared_ptr<DebuggerOperations> operations, std::shared_ptr<CallbacksType> callbacks) :
+    m_operations(std::move(operations)),
+    m_callbacks(std::move(callbacks)) {}
+
+template<DebuggerCallbacksType CallbacksType>
+bool BasicBreakpointManager<CallbacksType>::CheckBreakpoints(BreakInfo& breakInfo) {
+    breakInfo = CheckBreakInfo();
+    return HandleBreakInfo(breakInfo);
+}
+
+template<DebuggerCallbacksType CallbacksType>
+bool BasicBreakpointManager<CallbacksType>::Run(const unsigned int numBreakpointsToSkip) {
+    m_debugOp = DebugOperation::RunOp;
+    m_instructionsToStep = numBreakpointsToSkip;
+    return false;
+}
+
+template<DebuggerCallbacksType CallbacksType>
+bool BasicBreakpointManager<CallbacksType>::RunInstructions(const unsigned int numInstructions) {
+    m_debugOp = DebugOperation::StepOp;
+    m_instructionsToStep = numInstructions;
+    return true;
+}
+
+template<DebuggerCallbacksType CallbacksType>
+bool BasicBreakpointManager<CallbacksType>::RunTillJump() {
+    m_debugOp = DebugOperation::FinishOp;
+    return true;
+}
+
+template<DebuggerCallbacksType CallbacksType>
+BreakNum BasicBreakpointManager<CallbacksType>::SetBreakpoint(const unsigned int address) {
+    const BreakInfo breakpoint = Detail::BreakPoint(NextBreakNum(), address);
+    return AddBreakInfo(breakpoint);
+}
+
+template<DebuggerCallbacksType CallbacksType>
+BreakNum BasicBreakpointManager<CallbacksType>::SetBreakpoint(const BankNum bank, const unsigned int address) {
+    const BreakInfo breakpoint = Detail::BreakPoint(NextBreakNum(), address, bank);
+    return AddBreakInfo(breakpoint);
+}
+
+template<DebuggerCallbacksType CallbacksType>
+void BasicBreakpointManager<CallbacksType>::SetCondition(BreakNum breakNum, const std::string& condition) {
+    auto iter = m_breakpoints.find(breakNum);
+    if (iter == m_breakpoints.end()) {
+        throw DebuggerError(fmt::format("{}", static_cast<unsigned int>(breakNum)));
+    }
+    iter->second.condition = ConditionInterpreter::CreateCondition(m_callbacks, condition);
+}
+
+template<DebuggerCallbacksType CallbacksType>
+BreakNum BasicBreakpointManager<CallbacksType>::SetTracepoint(unsigned int address, const std::vector<std::string>& expressions, BankNum bank) {
+    if (expressions.size() > TracepointHit::MaxValues) {
+        throw DebuggerError(fmt::format("At most {} values can be traced.", TracepointHit::MaxValues));
+    }
+
+    BreakInfo tracepoint = Detail::TracePoint(BreakNum{}, address, bank);
+    for (const auto& expression : expressions) {
+        auto value = ConditionInterpreter::CreateCondition(m_callbacks, expression);
+        if (value == nullptr) {
+            throw DebuggerError("Tracepoint expressions can't be empty.");
+        }
+        tracepoint.traceValues.push_back(std::move(value));
+    }
+
+    if (m_tracepointLog.Capacity() == 0) {
+        m_tracepointLog.Reset(DefaultTracepointLogSize);
+    }
+    tracepoint.breakpointNumber = NextBreakNum();
+    return AddBreakInfo(tracepoint);
+}
+
+template<DebuggerCallbacksType CallbacksType>
+BreakNum BasicBreakpointManager<CallbacksType>::SetWatchpoint(const unsigned int address, BankNum bankNum) {
+    const BreakInfo breakpoint = Detail::WatchPoint(*m_callbacks, NextBreakNum(), address, bankNum);
+    return AddBreakInfo(breakpoint);
+}
+
+template<DebuggerCallbacksType CallbacksType>
+BreakNum BasicBreakpointManager<CallbacksType>::SetReadWatchpoint(unsigned int address, BankNum bank) {
+    const BreakInfo breakpoint = Detail::ReadWatchPoint(*m_callbacks, NextBreakNum(), address, bank);
+    return AddBreakInfo(breakpoint);
+}
+
+template<DebuggerCallbacksType CallbacksType>
+BreakNum BasicBreakpointManager<CallbacksType>::SetAnyWatchpoint(unsigned int address, BankNum bank) {
+    const BreakInfo breakpoint = Detail::AnyWatchPoint(*m_callbacks, NextBreakNum(), address, bank);
+    return AddBreakInfo(breakpoint);
+}
+
+template<DebuggerCallbacksType CallbacksType>
+BreakNum BasicBreakpointManager<CallbacksType>::SetWatchpointRange(unsigned int address, unsigned int endAddress, BankNum bank) {
+    const auto length = Detail::RangeLength(address, endAddress); // Validated before a breakpoint number is used up.
+    const BreakInfo breakpoint = Detail::WatchPoint(*m_callbacks, NextBreakNum(), address, bank, length);
+    return AddBreakInfo(breakpoint);
+}
+
+template<DebuggerCallbacksType CallbacksType>
+BreakNum BasicBreakpointManager<CallbacksType>::SetReadWatchpointRange(unsigned int address, unsigned int endAddress, BankNum bank) {
+    const auto length = Detail::RangeLength(address, endAddress);
+    const BreakInfo breakpoint = Detail::ReadWatchPoint(*m_callbacks, NextBreakNum(), address, bank, length);
+    return AddBreakInfo(breakpoint);
+}
+
+template<DebuggerCallbacksType CallbacksType>
+BreakNum BasicBreakpointManager<CallbacksType>::SetAnyWatchpointRange(unsigned int address, unsigned int endAddress, BankNum bank) {
+    const auto length = Detail::RangeLength(address, endAddress);
+    const BreakInfo breakpoint = Detail::AnyWatchPoint(*m_callbacks, NextBreakNum(), address, bank, length);
+    return AddBreakInfo(breakpoint);
+}
+
+template<DebuggerCallbacksType CallbacksType>
+BreakNum BasicBreakpointManager<CallbacksType>::SetWatchpoint(const std::string& name) {
+    const BreakInfo breakpoint = Detail::WatchPoint(*m_callbacks, NextBreakNum(), name);
+    return AddBreakInfo(breakpoint);
+}
+
+// BreakNum BasicBreakpointManager::SetReadWatchpoint(const std::string& name) {
+//    const BreakInfo breakpoint = Detail::ReadWatchPoint(*m_callbacks, NextBreakNum(), name);
+//    m_breakpoints.emplace(breakpoint.breakpointNumber, breakpoint);
+//
+//    return breakpoint.breakpointNumber;
+//}
+//
+// BreakNum BasicBreakpointManager::SetAnyWatchpoint(const std::string& name) {
+//    const BreakInfo breakpoint = Detail::AnyWatchPoint(*m_callbacks, NextBreakNum(), name);
+//    m_breakpoints.emplace(breakpoint.breakpointNumber, breakpoint);
+//
+//    return breakpoint.breakpointNumber;
+//}
+
+template<DebuggerCallbacksType CallbacksType>
+bool BasicBreakpointManager<CallbacksType>::EnableBreakpoints(const std::vector<BreakNum>& list) {
+    return ModifyBreak(list, true);
+}
+
+template<DebuggerCallbacksType CallbacksType>
+bool BasicBreakpointManager<CallbacksType>::DisableBreakpoints(const std::vector<BreakNum>& list) {
+    return ModifyBreak(list, false);
+}
+
+template<DebuggerCallbacksType CallbacksType>
+bool BasicBreakpointManager<CallbacksType>::DeleteBreakpoints(const std::vector<BreakNum>& list) {
+    // If no breakpoints are specified, delete them all
+    if (list.empty()) {
+        m_breakpointIndex.Clear();
+        m_readWatchIndex.Clear();
+        m_writeWatchIndex.Clear();
+        m_watchpoints.clear();
+        m_breakpoints.clear();
+        m_breakPointCounter = BreakNum{ 1u };
+    }
+
+    // Delete breakpoints from list
+    auto breakPointDeleted = false;
+    for (const auto& breakpointNum : list) {
+        if (auto iter = m_breakpoints.find(breakpointNum);
+            iter != m_breakpoints.end()) {
+            breakPointDeleted = true;
+            UnindexBreakInfo(iter->second);
+            std::erase(m_watchpoints, &iter->second);
+            m_breakpoints.erase(iter);
+        }
+    }
+    return breakPointDeleted;
+}
+
+template<DebuggerCallbacksType CallbacksType>
+BreakList BasicBreakpointManager<CallbacksType>::GetBreakpointInfoList(const std::vector<BreakNum>& list) {
+    if (list.empty()) { return m_breakpoints; }
+
+    BreakList tempMap = {};
+    for (const auto& breakpointNum : list) {
+        if (auto iter = m_breakpoints.find(breakpointNum);
+            iter != m_breakpoints.end()) {
+            tempMap.emplace(*iter);
+        }
+    }
+    return tempMap;
+}
+
+template<DebuggerCallbacksType CallbacksType>
+void BasicBreakpointManager<CallbacksType>::ReadMemoryHook(BankNum bankNum, unsigned int address, std::span<const std::byte> bytes) {
+    m_hooksReportAccesses = true;
+    m_readWatchIndex.MarkHits(bankNum, address, bytes.size());
+}
+
+template<DebuggerCallbacksType CallbacksType>
+void BasicBreakpointManager<CallbacksType>::WriteMemoryHook(BankNum bankNum, unsigned int address, std::span<const std::byte> bytes) {
+    m_hooksReportAccesses = true;
+    m_writeWatchIndex.MarkHits(bankNum, address, bytes.size());
+}
+
+// Watchpoints re-read their value when checked, only the accessed range matters here.
+template<DebuggerCallbacksType CallbacksType>
+void BasicBreakpointManager<CallbacksType>::ReadMemoryHook(BankNum bankNum, unsigned int address, unsigned int /*value*/, unsigned int width) {
+    m_hooksReportAccesses = true;
+    m_readWatchIndex.MarkHits(bankNum, address, width);
+}
+
+template<DebuggerCallbacksType CallbacksType>
+void BasicBreakpointManager<CallbacksType>::WriteMemoryHook(BankNum bankNum, unsigned int address, unsigned int /*value*/, unsigned int width) {
+    m_hooksReportAccesses = true;
+    m_writeWatchIndex.MarkHits(bankNum, address, width);
+}
+
+template<DebuggerCallbacksType CallbacksType>
+void BasicBreakpointManager<CallbacksType>::MemoryAccessHook(std::span<const MemoryAccess> accesses) {
+    m_hooksReportAccesses = true;
+    if (m_readWatchIndex.Empty() && m_writeWatchIndex.Empty()) { return; }
+
+    // Each access is checked against the watched pages on its own, scattered accesses don't widen the check.
+    for (const auto& access : accesses) {
+        auto& watchIndex = access.type == MemoryAccessType::Read ? m_readWatchIndex : m_writeWatchIndex;
+        watchIndex.MarkHits(access.bank, access.address, access.width);
+    }
+}
+
+template<DebuggerCallbacksType CallbacksType>
+BreakInfo BasicBreakpointManager<CallbacksType>::CheckBreakInfo() {
+    // Code breakpoints, only the ones set at the current PC need to be looked at. A banked one also needs its bank mapped there.
+    const auto pcReg = m_callbacks->GetPcReg();
+    m_codeCandidates.clear();
+    if (const auto* entry = m_breakpointIndex.Find(pcReg)) {
+        m_codeCandidates.insert(m_codeCandidates.end(), entry->unbanked.begin(), entry->unbanked.end());
+        for (const auto& [bankNum, breakpoints] : entry->banked) {
+            if (m_callbacks->CheckBankableMemoryLocation(bankNum, pcReg)) {
+                m_codeCandidates.insert(m_codeCandidates.end(), breakpoints.begin(), breakpoints.end());
+            }
+        }
+        if (!entry->banked.empty()) {
+            std::ranges::sort(m_codeCandidates, {}, &BreakInfo::breakpointNumber);
+        }
+    }
+
+    // Breakpoints are checked in number order, code breakpoints and watchpoints interleaved, the first hit is returned.
+    auto code = m_codeCandidates.begin();
+    auto watch = m_watchpoints.begin();
+    while (code != m_codeCandidates.end() || watch != m_watchpoints.end()) {
+        if (watch == m_watchpoints.end() || (code != m_codeCandidates.end() && (*code)->breakpointNumber < (*watch)->breakpointNumber)) {
+            if (HitCodeBreakpoint(**code, pcReg)) { return **code; }
+            ++code;
+        }
+        else {
+            if (HitWatchpoint(**watch)) { return **watch; }
+            ++watch;
+        }
+    }
+
+    return Detail::ContinuePoint();
+}
+
+template<DebuggerCallbacksType CallbacksType>
+bool BasicBreakpointManager<CallbacksType>::HitCodeBreakpoint(BreakInfo& breakInfo, unsigned int pc) {
+    if (breakInfo.condition != nullptr && !breakInfo.condition->EvaluateCondition()) { return false; }
+
+    ++breakInfo.timesHit;
+    if (breakInfo.type != BreakType::Tracepoint) { return true; }
+
+    // Only the raw values are captured here, formatting waits until the log is read.
+    auto& hit = m_tracepointLog.Append();
+    hit.breakpointNumber = breakInfo.breakpointNumber;
+    hit.pc = pc;
+    hit.count = static_cast<std::uint8_t>(breakInfo.traceValues.size());
+    hit.errors = 0;
+    for (size_t i = 0; i < breakInfo.traceValues.size(); ++i) {
+        // A failing value is marked in the hit rather than stopping the emulator.
+        try {
+            hit.values[i] = breakInfo.traceValues[i]->EvaluateValue();
+        }
+        catch (const std::runtime_error&) {
+            hit.values[i] = 0;
+            hit.errors |= static_cast<std::uint8_t>(1U << i);
+        }
+    }
+    return false;
+}
+
+template<DebuggerCallbacksType CallbacksType>
+bool BasicBreakpointManager<CallbacksType>::HitWatchpoint(BreakInfo& breakInfo) {
+    if (!breakInfo.isEnabled) { return false; }
+    if (!breakInfo.rangeWatchValues.empty()) { return HitWatchpointRange(breakInfo); }
+
+    // Watching an address
+    if (const auto currentWatchValue = Detail::GetWatchpointValue(*m_callbacks, breakInfo);
+        breakInfo.externalHit || (breakInfo.type != BreakType::ReadWatchpoint && breakInfo.currentWatchValue != currentWatchValue)) {
+        if (breakInfo.condition == nullptr || breakInfo.condition->EvaluateCondition()) {
+            breakInfo.oldWatchValue = breakInfo.currentWatchValue;
+            breakInfo.currentWatchValue = currentWatchValue;
+            ++breakInfo.timesHit;
+            breakInfo.externalHit = false; // Clear the external hit
+            return true;
+        }
+    }
+    return false;
+}
+
+// The memory hooks report the address accessed, only that one is compared. An emulator that never calls the hooks
+// has every address of the range polled on every check instead, one read per watched address each instruction.
+template<DebuggerCallbacksType CallbacksType>
+bool BasicBreakpointManager<CallbacksType>::HitWatchpointRange(BreakInfo& breakInfo) {
+    auto& values = breakInfo.rangeWatchValues;
+    size_t offset = 0;
+    if (breakInfo.externalHit) {
+        offset = breakInfo.watchAddress - breakInfo.address;
+    }
+    else if (m_hooksReportAccesses) {
+        return false;
+    }
+    else {
+        offset = Detail::FindChangedOffset(*m_callbacks, breakInfo);
+        if (offset == values.size()) { return false; }
+    }
+    if (breakInfo.condition != nullptr && !breakInfo.condition->EvaluateCondition()) { return false; }
+
+    // A poll refreshes the addresses after the changed one too, so one hit takes in all of the change.
+    const auto refreshEnd = breakInfo.externalHit ? offset + 1 : values.size();
+    breakInfo.watchAddress = breakInfo.address + static_cast<unsigned int>(offset);
+    breakInfo.oldWatchValue = values[offset];
+    for (auto refresh = offset; refresh < refreshEnd; ++refresh) {
+        values[refresh] = Detail::ReadWatchedMemory(*m_callbacks, breakInfo.bankNumber, breakInfo.address + static_cast<unsigned int>(refresh));
+    }
+    breakInfo.currentWatchValue = values[offset];
+    ++breakInfo.timesHit;
+    breakInfo.externalHit = false;
+    return true;
+}
+
+template<DebuggerCallbacksType CallbacksType>
+bool BasicBreakpointManager<CallbacksType>::HandleBreakInfo(const BreakInfo& info) {
+    // TODO: Need to know how this should interact with continue like operations, for now always break on valid non-standard breakpoints.
+    if (info.type != BreakType::Breakpoint && info.breakpointNumber != MaxBreakpointNumber) { return true; }
+
+    // Check if we should actually break the program, run/step operations can ignore breaks.
+    const auto breakpointHit = (info.type == BreakType::Breakpoint && info.breakpointNumber != MaxBreakpointNumber);
+    switch (m_debugOp) {
+        case DebugOperation::RunOp:
+            if ((m_instructionsToStep == 0) && breakpointHit) {
+                return true;
+            }
+            if (breakpointHit) {
+                --m_instructionsToStep;
+            }
+            break;
+        case DebugOperation::StepOp:
+            if ((m_instructionsToStep == 0) || breakpointHit) {
+                return true;
+            }
+            --m_instructionsToStep;
+            break;
+        case DebugOperation::FinishOp:
+            if (m_operations) {
+                static constexpr auto byteSize = 8U;
+                const auto pcReg = m_callbacks->GetPcReg();
+                const auto cmd = m_callbacks->ReadMemory(pcReg);
+
+                if (m_operations->IsExtensionOpcode(cmd)) {
+                    const auto extendedCommand = m_callbacks->ReadMemory(pcReg + m_operations->GetOpcodeLength() / byteSize);
+                    if (m_operations->IsJumpOperation(cmd, extendedCommand)) {
+                        return true;
+                    }
+                }
+                else if (m_operations->IsJumpOperation(cmd)) {
+                    return true;
+                }
+            }
+            break;
+    };
+    return false;
+}
+
+template<DebuggerCallbacksType CallbacksType>
+bool BasicBreakpointManager<CallbacksType>::ModifyBreak(const std::vector<BreakNum>& list, bool isEnabled) {
+    bool foundBreakpoint = false;
+    for (const auto& breakpointNum : list) {
+        if (auto iter = m_breakpoints.find(breakpointNum);
+            iter != m_breakpoints.end()) {
+            foundBreakpoint = true;
+            iter->second.isEnabled = isEnabled;
+            if (isEnabled) {
+                IndexBreakInfo(iter->second);
+            }
+            else {
+                UnindexBreakInfo(iter->second);
+            }
+        }
+    }
+    return foundBreakpoint;
+}
+
+template<DebuggerCallbacksType CallbacksType>
+BreakNum BasicBreakpointManager<CallbacksType>::AddBreakInfo(const BreakInfo& breakInfo) {
+    auto iter = m_breakpoints.emplace(breakInfo.breakpointNumber, breakInfo).first;
+    if (!Detail::IsCodeBreakpoint(iter->second)) {
+        // Watchpoints stay listed until deleted, disabled ones are skipped when polled.
+        m_watchpoints.push_back(&iter->second);
+    }
+    IndexBreakInfo(iter->second);
+
+    return breakInfo.breakpointNumber;
+}
+
+template<DebuggerCallbacksType CallbacksType>
+void BasicBreakpointManager<CallbacksType>::IndexBreakInfo(BreakInfo& breakInfo) {
+    if (!breakInfo.isEnabled) { return; }
+
+    if (Detail::IsCodeBreakpoint(breakInfo)) {
+        m_breakpointIndex.Insert(breakInfo);
+        return;
+    }
+
+    // Register watchpoints have no memory address for the hooks to report.
+    if (!breakInfo.regName.empty()) { return; }
+
+    if (breakInfo.type == BreakType::ReadWatchpoint || breakInfo.type == BreakType::AnyWatchpoint) {
+        m_readWatchIndex.Insert(breakInfo);
+    }
+    if (breakInfo.type == BreakType::Watchpoint || breakInfo.type == BreakType::AnyWatchpoint) {
+        m_writeWatchIndex.Insert(breakInfo);
+    }
+}
+
+template<DebuggerCallbacksType CallbacksType>
+void BasicBreakpointManager<CallbacksType>::UnindexBreakInfo(const BreakInfo& breakInfo) {
+    if (Detail::IsCodeBreakpoint(breakInfo)) {
+        m_breakpointIndex.Erase(breakInfo);
+        return;
+    }
+
+    m_readWatchIndex.Erase(breakInfo);
+    m_writeWatchIndex.Erase(breakInfo);
+}
+
+template<DebuggerCallbacksType CallbacksType>
+BreakNum BasicBreakpointManager<CallbacksType>::NextBreakNum() {
+    const auto breakNum = m_breakPointCounter;
+    m_breakPointCounter = BreakNum{ static_cast<unsigned int>(m_breakPointCounter) + 1u };
+    return breakNum;
+}
+
+// The type-erased manager is compiled once in BreakpointManager.cpp.
+extern template class BasicBreakpointManager<IDebuggerCallbacks>;
+using BreakpointManager = BasicBreakpointManager<IDebuggerCallbacks>;
+
 }
\ No newline at end of file
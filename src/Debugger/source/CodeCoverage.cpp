@@ -0,0 +1,153 @@
+#include "CodeCoverage.h"
+
+#include "BinaryIo.h"
+#include "DebuggerError.h"
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <bit>
+#include <fstream>
+#include <iterator>
+#include <ranges>
+#include <type_traits>
+
+namespace {
+static constexpr std::uint32_t Magic = 0x43424452; // "RDBC"
+static constexpr std::uint32_t FormatVersion = 1;
+// A whole address space is allocated up front, about 3/4 of a byte per address for the bits and slices of each kind.
+// Bounded to a 24-bit address bus, around 12 MiB, so a corrupt size can't allocate gigabytes.
+static constexpr std::uint64_t MaxAddressSpaceSize = std::uint64_t{ 1 } << 24U;
+}
+
+namespace Rdb {
+
+CodeCoverage::CodeCoverage(size_t addressSpaceSize) {
+    Reset(addressSpaceSize);
+}
+
+void CodeCoverage::Reset(size_t addressSpaceSize) {
+    m_addressSpaceSize = addressSpaceSize;
+    for (auto& bits : m_bits) {
+        bits.Reset(addressSpaceSize);
+    }
+}
+
+void CodeCoverage::MapBank(BankNum bank, unsigned int startAddress, unsigned int endAddress) {
+    for (auto& bits : m_bits) {
+        bits.MapBank(bank, startAddress, endAddress);
+    }
+}
+
+bool CodeCoverage::IsCovered(CoverageKind kind, BankNum bank, unsigned int address) const {
+    const auto& bits = m_bits[static_cast<size_t>(kind)];
+    if (!bits.Contains(address)) { return false; }
+
+    const auto* word = bank == AnyBank || bits.MappedBank(address) == bank ? bits.Mapped(address) : bits.Find(bank, address);
+    return word != nullptr && (*word & (std::uint64_t{ 1 } << (address % SliceSize))) != 0;
+}
+
+size_t CodeCoverage::Count(CoverageKind kind) const {
+    size_t count = 0;
+    for (const auto& page : m_bits[static_cast<size_t>(kind)].Pages() | std::views::values) {
+        for (const auto word : *page) {
+            count += static_cast<size_t>(std::popcount(word));
+        }
+    }
+    return count;
+}
+
+std::vector<std::byte> CodeCoverage::Serialize() const {
+    std::vector<std::byte> data;
+    PutRaw(data, Magic);
+    PutRaw(data, FormatVersion);
+    PutRaw(data, static_cast<std::uint64_t>(m_addressSpaceSize));
+
+    const auto isMarked = [](const auto& entry) { return std::ranges::any_of(*entry.second, [](std::uint64_t word) { return word != 0; }); };
+    size_t pageCount = 0;
+    for (const auto& bits : m_bits) {
+        pageCount += static_cast<size_t>(std::ranges::count_if(bits.Pages(), isMarked));
+    }
+    PutRaw(data, static_cast<std::uint32_t>(pageCount));
+    for (size_t kind = 0; kind < KindCount; ++kind) {
+        for (const auto& entry : m_bits[kind].Pages()) {
+            if (!isMarked(entry)) { continue; }
+
+            const auto& [bank, pageNumber] = entry.first;
+            PutRaw(data, static_cast<std::underlying_type_t<CoverageKind>>(kind));
+            PutRaw(data, static_cast<std::underlying_type_t<BankNum>>(bank));
+            PutRaw(data, static_cast<std::uint32_t>(pageNumber));
+            for (const auto word : *entry.second) {
+                PutRaw(data, word);
+            }
+        }
+    }
+    return data;
+}
+
+std::optional<CodeCoverage> CodeCoverage::Deserialize(std::span<const std::byte> data) {
+    std::uint32_t magic = 0;
+    std::uint32_t version = 0;
+    std::uint64_t addressSpaceSize = 0;
+    std::uint32_t pageCount = 0;
+    if (!GetRaw(data, magic) || magic != Magic || !GetRaw(data, version) || version != FormatVersion || !GetRaw(data, addressSpaceSize) ||
+        addressSpaceSize > MaxAddressSpaceSize || !GetRaw(data, pageCount)) {
+        return std::nullopt;
+    }
+
+    CodeCoverage coverage(static_cast<size_t>(addressSpaceSize));
+    for (auto i = 0U; i < pageCount; ++i) {
+        std::underlying_type_t<CoverageKind> kind = 0;
+        std::underlying_type_t<BankNum> bank = 0;
+        std::uint32_t pageNumber = 0;
+        if (!GetRaw(data, kind) || kind >= KindCount || !GetRaw(data, bank) || !GetRaw(data, pageNumber) ||
+            std::uint64_t{ pageNumber } * PageSize >= addressSpaceSize) {
+            return std::nullopt;
+        }
+
+        // Copied into the page rather than replacing it, the slice table may already point into it.
+        auto* words = coverage.m_bits[kind].Get(BankNum{ bank }, pageNumber * PageSize);
+        for (size_t word = 0; word < std::tuple_size_v<Bits::Page>; ++word) {
+            if (!GetRaw(data, words[word])) { return std::nullopt; } // NOLINT (cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+    }
+
+    if (!data.empty()) { return std::nullopt; }
+    return coverage;
+}
+
+void CodeCoverage::Save(const std::filesystem::path& path) const {
+    const auto data = Serialize();
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file || !file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()))) { // NOLINT (cppcoreguidelines-pro-type-reinterpret-cast)
+        throw DebuggerError(fmt::format("Can't write coverage file '{}'.", path.string()));
+    }
+}
+
+CodeCoverage CodeCoverage::Load(const std::filesystem::path& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw DebuggerError(fmt::format("Can't open coverage file '{}'.", path.string()));
+    }
+
+    const std::vector<char> contents{ std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+    auto coverage = Deserialize(std::as_bytes(std::span{ contents }));
+    if (!coverage) {
+        throw DebuggerError(fmt::format("'{}' isn't a version {} coverage file.", path.string(), FormatVersion));
+    }
+    return std::move(*coverage);
+}
+
+void CodeCoverage::MarkRange(CoverageKind kind, BankNum bank, unsigned int address, size_t size) {
+    auto& bits = m_bits[static_cast<size_t>(kind)];
+    for (auto end = address + size; address < end && bits.Contains(address); ++address) {
+        if (bank == AnyBank || bits.MappedBank(address) == bank) {
+            Mark(bits, address);
+        }
+        else {
+            *bits.Get(bank, address) |= std::uint64_t{ 1 } << (address % SliceSize);
+        }
+    }
+}
+
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "BankedPageTable.h"
+#include "RetroDebuggerCommon.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace Rdb {
+
+enum class CoverageKind : std::uint8_t {
+    Executed = 0,
+    Read,
+    Written,
+};
+
+// One bit per address for each kind of access, kept apart for each bank mapped over an address.
+class CodeCoverage {
+public:
+    static constexpr unsigned int SliceSize = 64; // Addresses in one word of bits.
+    static constexpr unsigned int PageSize = 0x1000; // Bits are allocated a page of addresses at a time.
+    static constexpr size_t KindCount = 3;
+
+    explicit CodeCoverage(size_t addressSpaceSize = 0);
+
+    // Drops all coverage and covers addresses below 'addressSpaceSize', every address starts out in AnyBank.
+    void Reset(size_t addressSpaceSize);
+    // 'bank' is now mapped over [startAddress, endAddress].
+    void MapBank(BankNum bank, unsigned int startAddress, unsigned int endAddress);
+
+    // Addresses outside the covered address space aren't marked.
+    void MarkExecuted(unsigned int address) { Mark(m_bits[0], address); }
+    // 'size' bytes from 'address' in 'bank', AnyBank is whichever bank is mapped there now.
+    void MarkRead(BankNum bank, unsigned int address, size_t size) { MarkRange(CoverageKind::Read, bank, address, size); }
+    void MarkWritten(BankNum bank, unsigned int address, size_t size) { MarkRange(CoverageKind::Written, bank, address, size); }
+
+    // AnyBank checks whichever bank is mapped there now.
+    [[nodiscard]] bool IsCovered(CoverageKind kind, BankNum bank, unsigned int address) const;
+    // Addresses marked in any bank.
+    [[nodiscard]] size_t Count(CoverageKind kind) const;
+    [[nodiscard]] size_t AddressSpaceSize() const { return m_addressSpaceSize; }
+
+    // Only pages with an address marked are stored.
+    [[nodiscard]] std::vector<std::byte> Serialize() const;
+    // Empty when the data isn't coverage of this format, is truncated or covers more than a 24-bit address space.
+    [[nodiscard]] static std::optional<CodeCoverage> Deserialize(std::span<const std::byte> data);
+    // Throw DebuggerError when the file can't be written or read.
+    void Save(const std::filesystem::path& path) const;
+    [[nodiscard]] static CodeCoverage Load(const std::filesystem::path& path);
+
+private:
+    using Bits = BankedPageTable<std::uint64_t, PageSize, SliceSize, SliceSize>;
+
+    static void Mark(Bits& bits, unsigned int address) {
+        if (auto* word = bits.Mapped(address)) {
+            *word |= std::uint64_t{ 1 } << (address % SliceSize);
+        }
+    }
+
+    void MarkRange(CoverageKind kind, BankNum bank, unsigned int address, size_t size);
+
+    std::array<Bits, KindCount> m_bits = {}; // By kind.
+    size_t m_addressSpaceSize = 0;
+};
+
+}
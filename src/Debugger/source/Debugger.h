@@ -1,12 +1,35 @@
 #pragma once
 
 #include "BreakpointManager.h"
+#include "CodeCoverage.h"
+#include "DebuggerOperations.h"
+#include "Disassembler.h"
+#include "ExecutionProfile.h"
+#include "InstructionCache.h"
+#include "TraceBuffer.h"
+#include "TraceFile.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <filesystem>
+#include <limits>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
 
 namespace Rdb {
 
-class Debugger {
+// Debugger built on a concrete callbacks type, see DebuggerCallbacksType.
+template<DebuggerCallbacksType CallbacksType>
+class BasicDebugger {
 public:
-    Debugger(std::shared_ptr<IDebuggerCallbacks> callbacks);
+    static constexpr size_t DefaultProfileSize = 0x10000;
+    static constexpr size_t DefaultCoverageSize = 0x10000;
+    static constexpr size_t MaxTraceSize = 1'000'000; // 32 MB of records.
+
+    BasicDebugger(std::shared_ptr<CallbacksType> callbacks);
     bool CheckBreakpoints(BreakInfo& breakInfo);
 
     bool Run(unsigned int numBreakpointsToSkip = 0);
@@ -18,10 +41,19 @@ public:
 
     void SetCondition(BreakNum breakNum, const std::string& condition);
 
+    // Logs the expressions' values each time 'address' is executed and continues, see BreakpointManager::SetTracepoint.
+    BreakNum SetTracepoint(unsigned int address, const std::vector<std::string>& expressions, BankNum bankNumber = AnyBank);
+    [[nodiscard]] const TracepointLog& GetTracepointLog() const { return m_breakManager.GetTracepointLog(); }
+    void ClearTracepointLog() { m_breakManager.ClearTracepointLog(); }
+
     BreakNum SetWatchpoint(unsigned int address, BankNum bankNumber = AnyBank);
     BreakNum SetReadWatchpoint(unsigned int address, BankNum bankNumber = AnyBank);
     BreakNum SetAnyWatchpoint(unsigned int address, BankNum bankNumber = AnyBank);
 
+    BreakNum SetWatchpointRange(unsigned int address, unsigned int endAddress, BankNum bankNumber = AnyBank);
+    BreakNum SetReadWatchpointRange(unsigned int address, unsigned int endAddress, BankNum bankNumber = AnyBank);
+    BreakNum SetAnyWatchpointRange(unsigned int address, unsigned int endAddress, BankNum bankNumber = AnyBank);
+
     BreakNum SetWatchpoint(const std::string& name);
     // Do we want to watch reads of registers? Would require a feedback from emulator and would likely not have value.
     /*BreakNum SetReadWatchpoint(const std::string& name);
@@ -36,21 +68,530 @@ public:
 
     CommandList GetCommandInfoList(size_t address, unsigned int numInstructions);
     CommandList GetCommandInfoList(size_t address, size_t endAddress); // TODO: May make sense to use a strongly typed Address type.
+    // Decodes [address, endAddress] in parallel for large ranges, such as a whole ROM. Bypasses the instruction cache.
+    // Like GetCommandInfoList, only the operands of an instruction running past endAddress are read after it.
+    Disassembly Disassemble(size_t address, size_t endAddress);
     BreakList GetBreakpointInfoList(const std::vector<unsigned int>& list = {});
     std::vector<RegisterInfoPtr> GetRegisterInfoList();
 
     // bool ParseXmlFile(const std::string& filename);
     void ResetOperations();
     void SetOperations(const XmlOperationsMap& operations);
+    void SetOperations(StaticOperationsTables operations);
+
+    // Records every instruction CheckBreakpoints sees into a buffer of the last 'capacity' instructions, at most MaxTraceSize,
+    // along with up to TraceRecord::MaxRegisters of the named registers. Replaces any earlier trace,
+    // tracing is left off if closing an earlier trace file or starting this trace throws.
+    void EnableTrace(size_t capacity, const std::vector<std::string>& registers = {});
+    // Streams every instruction to a binary trace file instead, see TraceFileWriter. Replaces any earlier trace the same way.
+    void EnableTraceFile(const std::filesystem::path& path, const std::vector<std::string>& registers = {});
+    // Also closes a trace file, throws DebuggerError if writing it failed.
+    void DisableTrace();
+
+    // Counts every instruction CheckBreakpoints sees by its address and mapped bank, restarting any earlier counts.
+    void EnableProfile(size_t addressSpaceSize = DefaultProfileSize);
+    void DisableProfile(); // The counts are kept for reporting.
+    [[nodiscard]] bool IsProfiling() const { return m_isProfiling; }
+    [[nodiscard]] const ExecutionProfile& GetProfile() const { return m_profile; }
+    // Marks every address CheckBreakpoints executes and the memory hooks read or write, by mapped bank. Restarts any earlier coverage.
+    void EnableCoverage(size_t addressSpaceSize = DefaultCoverageSize);
+    void DisableCoverage(); // The coverage is kept for reporting.
+    [[nodiscard]] bool IsCovering() const { return m_isCovering; }
+    [[nodiscard]] const CodeCoverage& GetCoverage() const { return m_coverage; }
+    [[nodiscard]] bool IsTracing() const { return m_isTracing; }
+    [[nodiscard]] const TraceBuffer& GetTrace() const { return m_trace; }
+    [[nodiscard]] const std::vector<std::string>& GetTraceRegisters() const { return m_traceRegisterNames; }
+
+    // Memory written here is never expected to change, decoded listings of it are kept across writes.
+    void SetReadOnlyMemory(unsigned int startAddress, unsigned int endAddress);
 
     // Hooks
-    void ReadMemoryHook(BankNum bankNum, unsigned int address, const std::vector<std::byte>& bytes);
-    void WriteMemoryHook(BankNum bankNum, unsigned int address, const std::vector<std::byte>& bytes);
+    void ReadMemoryHook(BankNum bankNum, unsigned int address, std::span<const std::byte> bytes);
+    void WriteMemoryHook(BankNum bankNum, unsigned int address, std::span<const std::byte> bytes);
+    void ReadMemoryHook(BankNum bankNum, unsigned int address, unsigned int value, unsigned int width);
+    void WriteMemoryHook(BankNum bankNum, unsigned int address, unsigned int value, unsigned int width);
+    // Drains every access buffered during the instruction.
+    void MemoryAccessHook(MemoryAccessBuffer& accesses);
+    void BankSwitchHook(BankNum bankNum, unsigned int startAddress, unsigned int endAddress);
 
 private:
-    std::shared_ptr<IDebuggerCallbacks> m_callbacks;
+    // Memory read ahead with ReadMemoryBlock while listing or tracing, so neither is a ReadMemory call per byte.
+    struct MemoryWindow {
+        static constexpr size_t Size = 256;
+
+        size_t address = 0;
+        size_t size = 0;
+        size_t lastAddress = std::numeric_limits<size_t>::max(); // Block reads stop here.
+        bool unavailable = false; // No block reader, or the opcodes aren't byte wide.
+        std::array<std::byte, Size> bytes = {};
+    };
+
+    DecodedInstruction GetCachedInstruction(size_t address, MemoryWindow& window);
+    DecodedInstruction GetCachedInstruction(BankNum bank, size_t address, MemoryWindow& window);
+    void FillWindow(size_t address, MemoryWindow& window);
+    std::vector<RegisterId> FindTraceRegisters(const std::vector<std::string>& registers);
+    void RecordTrace();
+    void RecordTrace(TraceRecord& record);
+
+    std::shared_ptr<CallbacksType> m_callbacks;
     std::shared_ptr<DebuggerOperations> m_operations;
-    BreakpointManager m_breakManager;
+    BasicBreakpointManager<CallbacksType> m_breakManager;
+    InstructionCache m_instructionCache = {};
+    TraceBuffer m_trace;
+    std::vector<RegisterId> m_traceRegisters = {};
+    std::vector<std::string> m_traceRegisterNames = {};
+    std::unique_ptr<TraceFileWriter> m_traceFile = {}; // Set while streaming to a file rather than m_trace.
+    MemoryWindow m_traceWindow = {}; // Refilled with each traced instruction's bytes.
+    bool m_isTracing = false;
+    ExecutionProfile m_profile;
+    bool m_isProfiling = false;
+    CodeCoverage m_coverage;
+    bool m_isCovering = false;
 };
 
-}
\ No newline at end of file
+namespace Detail {
+inline std::vector<BreakNum> ToBreakNumList(const std::vector<unsigned int>& list) {
+    std::vector<BreakNum> breakpoints(list.size());
+    std::ranges::transform(list, breakpoints.begin(), [](unsigned int breakpoint) { return BreakNum{ breakpoint }; });
+
+    return breakpoints;
+}
+}
+
+template<DebuggerCallbacksType CallbacksType>
+BasicDebugger<CallbacksType>::BasicDebugger(std::shared_ptr<CallbacksType> callbacks) :
+    m_callbacks(std::move(callbacks)),
+    m_operations(std::make_shared<DebuggerOperations>(m_callbacks)),
+    m_breakManager(m_operations, m_callbacks) {}
+
+template<DebuggerCallbacksType CallbacksType>
+bool BasicDebugger<CallbacksType>::CheckBreakpoints(BreakInfo& breakInfo) {
+    if (m_isProfiling || m_isCovering) {
+        const auto pc = m_callbacks->GetPcReg();
+        if (m_isProfiling) { m_profile.Count(pc); }
+        if (m_isCovering) { m_coverage.MarkExecuted(pc); }
+    }
+    if (m_isTracing) {
+        RecordTrace();
+    }
+    return m_breakManager.CheckBreakpoints(breakInfo);
+}
+
+template<DebuggerCallbacksType CallbacksType>
+bool BasicDebugger<CallbacksType>::Run(const unsigned int numBreakpointsToSkip) {
+    return m_breakManager.Run(numBreakpointsToSkip);
+}
+
+template<DebuggerCallbacksType CallbacksType>
+bool BasicDebugger<CallbacksType>::RunInstructions(const unsigned int numInstructions) {
+    return m_breakManager.RunInstructions(numInstructions);
+}
+
+template<DebuggerCallbacksType CallbacksType>
+bool BasicDebugger<CallbacksType>::RunTillJump() {
+    return m_breakManager.RunTillJump();
+}
+
+template<DebuggerCallbacksType CallbacksType>
+BreakNum BasicDebugger<CallbacksType>::SetBreakpoint(const unsigned int address) {
+    // TODO: should the address be checked?
+    return m_breakManager.SetBreakpoint(address);
+}
+
+template<DebuggerCallbacksType CallbacksType>
+BreakNum BasicDebugger<CallbacksType>::SetBreakpoint(BankNum bank, const unsigned int address) {
+    // TODO: should the address be checked?
+    return m_breakManager.SetBreakpoint(BankNum{ bank }, address);
+}
+
+template<DebuggerCallbacksType CallbacksType>
+void BasicDebugger<CallbacksType>::SetCondition(BreakNum breakNum, const std::string& condition) {
+    m_breakManager.SetCondition(breakNum, condition);
+}
+
+template<DebuggerCallbacksType CallbacksType>
+BreakNum BasicDebugger<CallbacksType>::SetTracepoint(unsigned int address, const std::vector<std::string>& expressions, BankNum bankNumber) {
+    return m_breakManager.SetTracepoint(address, expressions, bankNumber);
+}
+
+template<DebuggerCallbacksType CallbacksType>
+BreakNum BasicDebugger<CallbacksType>::SetWatchpoint(const unsigned int address, BankNum bankNumber) {
+    return m_breakManager.SetWatchpoint(address, bankNumber);
+}
+
+template<DebuggerCallbacksType CallbacksType>
+BreakNum BasicDebugger<CallbacksType>::SetReadWatchpoint(unsigned int address, BankNum bankNumber) {
+    return m_breakManager.SetReadWatchpoint(address, bankNumber);
+}
+
+template<DebuggerCallbacksType CallbacksType>
+BreakNum BasicDebugger<CallbacksType>::SetAnyWatchpoint(unsigned int address, BankNum bankNumber) {
+    return m_breakManager.SetAnyWatchpoint(address, bankNumber);
+}
+
+template<DebuggerCallbacksType CallbacksType>
+BreakNum BasicDebugger<CallbacksType>::SetWatchpointRange(unsigned int address, unsigned int endAddress, BankNum bankNumber) {
+    return m_breakManager.SetWatchpointRange(address, endAddress, bankNumber);
+}
+
+template<DebuggerCallbacksType CallbacksType>
+BreakNum BasicDebugger<CallbacksType>::SetReadWatchpointRange(unsigned int address, unsigned int endAddress, BankNum bankNumber) {
+    return m_breakManager.SetReadWatchpointRange(address, endAddress, bankNumber);
+}
+
+template<DebuggerCallbacksType CallbacksType>
+BreakNum BasicDebugger<CallbacksType>::SetAnyWatchpointRange(unsigned int address, unsigned int endAddress, BankNum bankNumber) {
+    return m_breakManager.SetAnyWatchpointRange(address, endAddress, bankNumber);
+}
+
+template<DebuggerCallbacksType CallbacksType>
+BreakNum BasicDebugger<CallbacksType>::SetWatchpoint(const std::string& name) {
+    return m_breakManager.SetWatchpoint(name);
+}
+
+// BreakNum BasicDebugger::SetReadWatchpoint(const std::string& name) {
+//     return m_breakManager.SetReadWatchpoint(name);
+// }
+//
+// BreakNum BasicDebugger::SetAnyWatchpoint(const std::string& name) {
+//     return m_breakManager.SetAnyWatchpoint(name);
+// }
+
+template<DebuggerCallbacksType CallbacksType>
+bool BasicDebugger<CallbacksType>::EnableBreakpoints(const std::vector<unsigned int>& list) {
+    return m_breakManager.EnableBreakpoints(Detail::ToBreakNumList(list));
+}
+
+template<DebuggerCallbacksType CallbacksType>
+bool BasicDebugger<CallbacksType>::DisableBreakpoints(const std::vector<unsigned int>& list) {
+    return m_breakManager.DisableBreakpoints(Detail::ToBreakNumList(list));
+}
+
+template<DebuggerCallbacksType CallbacksType>
+bool BasicDebugger<CallbacksType>::DeleteBreakpoints(const std::vector<unsigned int>& list) {
+    return m_breakManager.DeleteBreakpoints(Detail::ToBreakNumList(list));
+}
+
+template<DebuggerCallbacksType CallbacksType>
+BreakList BasicDebugger<CallbacksType>::GetBreakpointInfoList(const std::vector<unsigned int>& list) {
+    return m_breakManager.GetBreakpointInfoList(Detail::ToBreakNumList(list));
+}
+
+// RegInfo BasicDebugger::GetRegInfo(const int /*reg*/) { return {}; } // TODO: need to redo RegInfo
+
+template<DebuggerCallbacksType CallbacksType>
+AddrInfo BasicDebugger<CallbacksType>::GetRomInfo(const unsigned int address) {
+    return { address, m_callbacks->ReadMemory(address) };
+}
+
+template<DebuggerCallbacksType CallbacksType>
+std::vector<RegisterInfoPtr> BasicDebugger<CallbacksType>::GetRegisterInfoList() {
+    return m_operations->GetRegisters();
+}
+
+template<DebuggerCallbacksType CallbacksType>
+void BasicDebugger<CallbacksType>::ResetOperations() {
+    m_operations->Reset();
+    m_instructionCache.Clear();
+}
+
+template<DebuggerCallbacksType CallbacksType>
+void BasicDebugger<CallbacksType>::SetOperations(const XmlOperationsMap& operations) {
+    m_operations->SetOperations(operations);
+    m_instructionCache.Clear();
+}
+
+template<DebuggerCallbacksType CallbacksType>
+void BasicDebugger<CallbacksType>::SetOperations(StaticOperationsTables operations) {
+    m_operations->SetOperations(operations);
+    m_instructionCache.Clear();
+}
+
+template<DebuggerCallbacksType CallbacksType>
+void BasicDebugger<CallbacksType>::SetReadOnlyMemory(unsigned int startAddress, unsigned int endAddress) {
+    m_instructionCache.SetReadOnly(startAddress, endAddress);
+}
+
+template<DebuggerCallbacksType CallbacksType>
+void BasicDebugger<CallbacksType>::ReadMemoryHook(BankNum bankNum, unsigned int address, std::span<const std::byte> bytes) {
+    m_breakManager.ReadMemoryHook(bankNum, address, bytes);
+    if (m_isCovering) {
+        m_coverage.MarkRead(bankNum, address, bytes.size());
+    }
+}
+
+template<DebuggerCallbacksType CallbacksType>
+void BasicDebugger<CallbacksType>::WriteMemoryHook(BankNum bankNum, unsigned int address, std::span<const std::byte> bytes) {
+    m_breakManager.WriteMemoryHook(bankNum, address, bytes);
+    m_instructionCache.Invalidate(bankNum, address, bytes.size());
+    if (m_isCovering) {
+        m_coverage.MarkWritten(bankNum, address, bytes.size());
+    }
+}
+
+template<DebuggerCallbacksType CallbacksType>
+void BasicDebugger<CallbacksType>::ReadMemoryHook(BankNum bankNum, unsigned int address, unsigned int value, unsigned int width) {
+    m_breakManager.ReadMemoryHook(bankNum, address, value, width);
+    if (m_isCovering) {
+        m_coverage.MarkRead(bankNum, address, width);
+    }
+}
+
+template<DebuggerCallbacksType CallbacksType>
+void BasicDebugger<CallbacksType>::WriteMemoryHook(BankNum bankNum, unsigned int address, unsigned int value, unsigned int width) {
+    m_breakManager.WriteMemoryHook(bankNum, address, value, width);
+    m_instructionCache.Invalidate(bankNum, address, width);
+    if (m_isCovering) {
+        m_coverage.MarkWritten(bankNum, address, width);
+    }
+}
+
+template<DebuggerCallbacksType CallbacksType>
+void BasicDebugger<CallbacksType>::MemoryAccessHook(MemoryAccessBuffer& accesses) {
+    accesses.Drain([this](std::span<const MemoryAccess> batch) {
+        m_breakManager.MemoryAccessHook(batch);
+        for (const auto& access : batch) {
+            if (access.type == MemoryAccessType::Write) {
+                m_instructionCache.Invalidate(access.bank, access.address, access.width);
+                if (m_isCovering) { m_coverage.MarkWritten(access.bank, access.address, access.width); }
+            }
+            else if (m_isCovering) {
+                m_coverage.MarkRead(access.bank, access.address, access.width);
+            }
+        }
+    });
+}
+
+template<DebuggerCallbacksType CallbacksType>
+void BasicDebugger<CallbacksType>::BankSwitchHook(BankNum bankNum, unsigned int startAddress, unsigned int endAddress) {
+    m_instructionCache.MapBank(bankNum, startAddress, endAddress);
+    if (m_isProfiling) {
+        m_profile.MapBank(bankNum, startAddress, endAddress);
+    }
+    if (m_isCovering) {
+        m_coverage.MapBank(bankNum, startAddress, endAddress);
+    }
+}
+
+template<DebuggerCallbacksType CallbacksType>
+CommandList BasicDebugger<CallbacksType>::GetCommandInfoList(size_t address, const unsigned int numInstructions) {
+    CommandList operations;
+    MemoryWindow window;
+    for (auto i = 0U; i < numInstructions; ++i) {
+        const auto instruction = GetCachedInstruction(address, window);
+        operations.emplace(address, instruction);
+        address += instruction.length;
+    }
+    return operations;
+}
+
+template<DebuggerCallbacksType CallbacksType>
+CommandList BasicDebugger<CallbacksType>::GetCommandInfoList(size_t address, size_t endAddress) {
+    CommandList operations;
+    MemoryWindow window;
+    // Only the last instruction's operands are read past endAddress, as a block read could run off the end of memory.
+    const auto lookahead = m_operations->MaxInstructionLength() - size_t{ 1 };
+    window.lastAddress = endAddress + std::min(lookahead, std::numeric_limits<size_t>::max() - endAddress);
+    while (address <= endAddress) {
+        const auto instruction = GetCachedInstruction(address, window);
+        operations.emplace(address, instruction);
+        address += instruction.length;
+    }
+    return operations;
+}
+
+template<DebuggerCallbacksType CallbacksType>
+void BasicDebugger<CallbacksType>::EnableTrace(size_t capacity, const std::vector<std::string>& registers) {
+    if (capacity == 0 || capacity > MaxTraceSize) {
+        throw DebuggerError(fmt::format("Trace size must be from 1 to {}.", MaxTraceSize));
+    }
+    auto registerIds = FindTraceRegisters(registers);
+
+    DisableTrace();
+    m_trace.Reset(capacity);
+    m_traceRegisters = std::move(registerIds);
+    m_traceRegisterNames = registers;
+    m_isTracing = true;
+}
+
+template<DebuggerCallbacksType CallbacksType>
+void BasicDebugger<CallbacksType>::EnableTraceFile(const std::filesystem::path& path, const std::vector<std::string>& registers) {
+    auto registerIds = FindTraceRegisters(registers);
+    DisableTrace(); // Closed before the new file is opened, in case it's the same file.
+    auto traceFile = std::make_unique<TraceFileWriter>(path, registers);
+
+    m_traceFile = std::move(traceFile);
+    m_trace.Reset(0);
+    m_traceRegisters = std::move(registerIds);
+    m_traceRegisterNames = registers;
+    m_isTracing = true;
+}
+
+template<DebuggerCallbacksType CallbacksType>
+void BasicDebugger<CallbacksType>::DisableTrace() {
+    m_isTracing = false; // The records are kept so the trace can still be dumped.
+    if (m_traceFile) {
+        const auto traceFile = std::move(m_traceFile);
+        traceFile->Close();
+    }
+}
+
+template<DebuggerCallbacksType CallbacksType>
+void BasicDebugger<CallbacksType>::EnableProfile(size_t addressSpaceSize) {
+    m_profile.Reset(addressSpaceSize);
+    m_instructionCache.ForEachMappedBank([this](BankNum bank, unsigned int startAddress, unsigned int endAddress) { m_profile.MapBank(bank, startAddress, endAddress); });
+    m_isProfiling = true;
+}
+
+template<DebuggerCallbacksType CallbacksType>
+void BasicDebugger<CallbacksType>::DisableProfile() {
+    m_isProfiling = false;
+}
+
+template<DebuggerCallbacksType CallbacksType>
+void BasicDebugger<CallbacksType>::EnableCoverage(size_t addressSpaceSize) {
+    m_coverage.Reset(addressSpaceSize);
+    m_instructionCache.ForEachMappedBank([this](BankNum bank, unsigned int startAddress, unsigned int endAddress) { m_coverage.MapBank(bank, startAddress, endAddress); });
+    m_isCovering = true;
+}
+
+template<DebuggerCallbacksType CallbacksType>
+void BasicDebugger<CallbacksType>::DisableCoverage() {
+    m_isCovering = false;
+}
+
+template<DebuggerCallbacksType CallbacksType>
+std::vector<RegisterId> BasicDebugger<CallbacksType>::FindTraceRegisters(const std::vector<std::string>& registers) {
+    if (registers.size() > TraceRecord::MaxRegisters) {
+        throw DebuggerError(fmt::format("At most {} registers can be traced.", TraceRecord::MaxRegisters));
+    }
+
+    std::vector<RegisterId> registerIds;
+    for (const auto& name : registers) {
+        const auto id = m_callbacks->FindRegister(name);
+        if (id == InvalidRegisterId) {
+            throw DebuggerError(fmt::format("Unknown register '{}'.", name));
+        }
+        registerIds.push_back(id);
+    }
+    return registerIds;
+}
+
+template<DebuggerCallbacksType CallbacksType>
+Disassembly BasicDebugger<CallbacksType>::Disassemble(size_t address, size_t endAddress) {
+    if (address > endAddress) { return {}; }
+    if (!m_operations->CanDecodeBytes()) {
+        Disassembly disassembly;
+        for (const auto& [instructionAddress, instruction] : GetCommandInfoList(address, endAddress)) {
+            disassembly.push_back({ instructionAddress, instruction });
+        }
+        return disassembly;
+    }
+
+    // Memory is read up front on this thread, so the callbacks needn't be thread safe. The lookahead is clamped
+    // as GetCommandInfoList's is, so the last instruction decodes the same operands.
+    const auto size = endAddress - address + 1;
+    const auto lookahead = m_operations->MaxInstructionLength() - size_t{ 1 };
+    std::vector<std::byte> memory(size + std::min(lookahead, std::numeric_limits<size_t>::max() - endAddress));
+    if (!m_callbacks->ReadMemoryBlock(AnyBank, static_cast<unsigned int>(address), memory)) {
+        for (size_t i = 0; i < memory.size(); ++i) {
+            memory[i] = static_cast<std::byte>(m_callbacks->ReadMemory(static_cast<unsigned int>(address + i)));
+        }
+    }
+    return Disassembler(*m_operations).Disassemble(address, memory, size);
+}
+
+template<DebuggerCallbacksType CallbacksType>
+DecodedInstruction BasicDebugger<CallbacksType>::GetCachedInstruction(size_t address, MemoryWindow& window) {
+    return GetCachedInstruction(m_instructionCache.BankAt(static_cast<unsigned int>(address)), address, window);
+}
+
+template<DebuggerCallbacksType CallbacksType>
+DecodedInstruction BasicDebugger<CallbacksType>::GetCachedInstruction(BankNum bank, size_t address, MemoryWindow& window) {
+    const auto cacheAddress = static_cast<unsigned int>(address);
+    if (const auto* instruction = m_instructionCache.Find(bank, cacheAddress)) {
+        return *instruction;
+    }
+
+    const auto maxLength = m_operations->MaxInstructionLength();
+    if (!window.unavailable && (!m_operations->CanDecodeBytes() || maxLength > MemoryWindow::Size)) {
+        window.unavailable = true;
+    }
+    if (!window.unavailable && (address < window.address || address + maxLength > window.address + window.size)) {
+        FillWindow(address, window);
+    }
+
+    const auto instruction = window.unavailable ? m_operations->Decode(address)
+                                                : m_operations->Decode(address, std::span{ window.bytes }.first(window.size).subspan(address - window.address));
+    m_instructionCache.Insert(bank, cacheAddress, instruction);
+    return instruction;
+}
+
+// Reads from 'address' up to the window's last address, a window cut short by it is decoded through ReadMemory, see Decode.
+template<DebuggerCallbacksType CallbacksType>
+void BasicDebugger<CallbacksType>::FillWindow(size_t address, MemoryWindow& window) {
+    const auto readSize = std::min(MemoryWindow::Size - 1, window.lastAddress - address) + 1;
+    window.address = address;
+    window.size = 0;
+    // A block reader that fills less than it's asked for leaves zeros, not bytes of the last window.
+    const auto refill = std::span{ window.bytes }.first(readSize);
+    std::ranges::fill(refill, std::byte{ 0 });
+    if (m_callbacks->ReadMemoryBlock(AnyBank, static_cast<unsigned int>(address), refill)) {
+        window.size = readSize;
+    }
+    else {
+        window.unavailable = true;
+    }
+}
+
+template<DebuggerCallbacksType CallbacksType>
+void BasicDebugger<CallbacksType>::RecordTrace() {
+    if (m_traceFile) {
+        TraceRecord record;
+        RecordTrace(record);
+        m_traceFile->Write(record);
+    }
+    else {
+        RecordTrace(m_trace.Append());
+    }
+}
+
+template<DebuggerCallbacksType CallbacksType>
+void BasicDebugger<CallbacksType>::RecordTrace(TraceRecord& record) {
+    const auto pc = m_callbacks->GetPcReg();
+    const auto bank = m_instructionCache.BankAt(pc);
+
+    // One block read per instruction, decoded straight from the window. Memory may have changed since the last one.
+    // Tracing skips the listing cache, written code would be invalidated and inserted again on every pass.
+    // Only without a block reader does it go through the cache, where a hit saves the ReadMemory calls of a decode.
+    const auto maxLength = m_operations->MaxInstructionLength();
+    m_traceWindow.unavailable = !m_operations->CanDecodeBytes() || maxLength > MemoryWindow::Size;
+    if (!m_traceWindow.unavailable) {
+        m_traceWindow.lastAddress = size_t{ pc } + maxLength - 1;
+        FillWindow(pc, m_traceWindow);
+    }
+    const auto instruction = m_traceWindow.unavailable ? GetCachedInstruction(bank, pc, m_traceWindow)
+                                                       : m_operations->Decode(pc, std::span{ m_traceWindow.bytes }.first(m_traceWindow.size));
+    const auto length = std::min<size_t>(instruction.length, TraceRecord::MaxBytes);
+
+    record.pc = pc;
+    record.bank = bank;
+    record.length = static_cast<std::uint8_t>(length);
+    if (!m_traceWindow.unavailable) {
+        std::ranges::transform(std::span{ m_traceWindow.bytes }.first(length), record.bytes.begin(), [](std::byte value) { return std::to_integer<std::uint8_t>(value); });
+    }
+    else {
+        for (size_t i = 0; i < length; ++i) {
+            record.bytes[i] = static_cast<std::uint8_t>(m_callbacks->ReadMemory(pc + static_cast<unsigned int>(i)));
+        }
+    }
+    for (size_t i = 0; i < m_traceRegisters.size(); ++i) {
+        record.registers[i] = m_callbacks->ReadRegister(m_traceRegisters[i]);
+    }
+}
+
+// The type-erased debugger is compiled once in Debugger.cpp.
+extern template class BasicDebugger<IDebuggerCallbacks>;
+using Debugger = BasicDebugger<IDebuggerCallbacks>;
+
+}
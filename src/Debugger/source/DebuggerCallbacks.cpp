@@ -1,6 +1,14 @@
 #include "DebuggerCallbacks.h"
 
+#include "DebuggerError.h"
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <limits>
+#include <ranges>
 
 namespace Rdb {
 
@@ -33,11 +41,154 @@ unsigned int DebuggerCallbacks::ReadBankableMemory(BankNum bank, unsigned int ad
     return std::numeric_limits<unsigned int>::max();
 }
 
+bool DebuggerCallbacks::ReadMemoryBlock(BankNum bank, unsigned int address, std::span<std::byte> buffer) {
+    if (m_readMemoryBlock_cb) {
+        m_readMemoryBlock_cb(bank, address, buffer);
+        return true;
+    }
+    return false;
+}
+
 RegSet DebuggerCallbacks::GetRegSet() {
     if (m_getRegSet_cb) {
         return m_getRegSet_cb();
     }
-    return {};
+
+    RegSet regset;
+    for (const auto& reg : m_registerFile) {
+        regset.emplace(reg.name, ReadRegister(reg.id));
+    }
+    return regset;
+}
+
+RegisterId DebuggerCallbacks::FindRegister(const std::string& name) {
+    if (!m_registerFile.empty()) {
+        const auto iter = std::ranges::find(m_registerFile, name, &RegisterDescription::name);
+        if (iter == m_registerFile.end()) { return InvalidRegisterId; }
+        m_hasResolvedRegisters = true;
+        return iter->id;
+    }
+
+    if (std::ranges::find(m_registerNames, name, &NamedRegister::name) == m_registerNames.end() && !GetRegSet().contains(name)) {
+        return InvalidRegisterId;
+    }
+
+    const auto id = NamedRegisterId(name);
+    m_registerNames[static_cast<size_t>(id)].isHeld = true;
+    m_hasResolvedRegisters = true;
+    return id;
+}
+
+unsigned int DebuggerCallbacks::ReadRegister(RegisterId id) {
+    if (m_readRegister_cb) {
+        return m_readRegister_cb(id);
+    }
+    if (m_registerStruct) {
+        return ReadRegisterStruct(id);
+    }
+
+    if (const auto index = static_cast<size_t>(id);
+        index < m_registerNames.size()) {
+        if (!m_regSetSnapshot) {
+            m_regSetSnapshot = GetRegSet();
+        }
+        if (const auto iter = m_regSetSnapshot->find(m_registerNames[index].name);
+            iter != m_regSetSnapshot->end()) {
+            return iter->second;
+        }
+    }
+    return std::numeric_limits<unsigned int>::max();
+}
+
+RegisterFile DebuggerCallbacks::GetRegisterFile() {
+    if (!m_registerFile.empty()) {
+        return m_registerFile;
+    }
+
+    RegisterFile registers;
+    for (const auto& name : GetRegSet() | std::views::keys) {
+        registers.push_back({ .name = name, .id = NamedRegisterId(name) });
+    }
+    return registers;
+}
+
+RegisterId DebuggerCallbacks::NamedRegisterId(const std::string& name) {
+    const auto iter = std::ranges::find(m_registerNames, name, &NamedRegister::name);
+    if (iter != m_registerNames.end()) {
+        return RegisterId{ static_cast<unsigned int>(iter - m_registerNames.begin()) };
+    }
+    m_registerNames.push_back({ .name = name });
+    return RegisterId{ static_cast<unsigned int>(m_registerNames.size() - 1) };
+}
+
+unsigned int DebuggerCallbacks::ReadRegisterStruct(RegisterId id) const {
+    const auto index = static_cast<size_t>(id);
+    if (index >= m_registerLookup.size() || m_registerLookup[index] == m_registerFile.size()) {
+        return std::numeric_limits<unsigned int>::max();
+    }
+
+    const auto& reg = m_registerFile[m_registerLookup[index]];
+    const auto* location = m_registerStruct + reg.offset;
+    switch (reg.width) {
+        case sizeof(uint8_t):
+            return static_cast<unsigned int>(*location);
+        case sizeof(uint16_t): {
+            uint16_t value{};
+            std::memcpy(&value, location, sizeof(value));
+            return value;
+        }
+        default: {
+            uint32_t value{};
+            std::memcpy(&value, location, sizeof(value));
+            return value;
+        }
+    }
+}
+
+void DebuggerCallbacks::DeclareRegisterFile(RegisterFile registers) {
+    size_t registerCount = 0;
+    for (const auto& reg : registers) {
+        if (reg.id == InvalidRegisterId) {
+            throw DebuggerError(fmt::format("Register '{}' has an invalid id.", reg.name));
+        }
+        if (static_cast<size_t>(reg.id) >= MaxRegisterIds) {
+            throw DebuggerError(fmt::format("Register '{}' has id {}, ids must be below {}.", reg.name, static_cast<unsigned int>(reg.id), MaxRegisterIds));
+        }
+        if (reg.width != sizeof(uint8_t) && reg.width != sizeof(uint16_t) && reg.width != sizeof(uint32_t)) {
+            throw DebuggerError(fmt::format("Register '{}' has unsupported width {}.", reg.name, reg.width));
+        }
+        if (std::ranges::count(registers, reg.name, &RegisterDescription::name) > 1 || std::ranges::count(registers, reg.id, &RegisterDescription::id) > 1) {
+            throw DebuggerError(fmt::format("Register '{}' is declared more than once.", reg.name));
+        }
+        registerCount = std::max(registerCount, static_cast<size_t>(reg.id) + 1);
+    }
+
+    // Resolved ids are held elsewhere, they'd silently read another register if they changed.
+    const auto keepsId = [&registers](const std::string& name, RegisterId id) {
+        const auto iter = std::ranges::find(registers, name, &RegisterDescription::name);
+        return iter != registers.end() && iter->id == id;
+    };
+    const auto throwIdChanged = [](const std::string& name, RegisterId id) {
+        throw DebuggerError(fmt::format("Register '{}' is already in use as id {}, it must keep that id.", name, static_cast<unsigned int>(id)));
+    };
+    if (m_hasResolvedRegisters) {
+        for (const auto& reg : m_registerFile) {
+            if (!keepsId(reg.name, reg.id)) { throwIdChanged(reg.name, reg.id); }
+        }
+    }
+    for (size_t i = 0; i < m_registerNames.size(); ++i) {
+        if (const auto id = RegisterId{ static_cast<unsigned int>(i) };
+            m_registerNames[i].isHeld && !keepsId(m_registerNames[i].name, id)) {
+            throwIdChanged(m_registerNames[i].name, id);
+        }
+    }
+
+    m_registerLookup.assign(registerCount, registers.size());
+    for (size_t i = 0; i < registers.size(); ++i) {
+        m_registerLookup[static_cast<size_t>(registers[i].id)] = i;
+    }
+    m_registerFile = std::move(registers);
+    m_registerNames.clear();
 }
 
 // Callback Setter APIs
@@ -57,8 +208,25 @@ void DebuggerCallbacks::SetReadBankableMemoryCallback(Rdb::ReadBankableMemoryFun
     m_readBankableMemory_cb = std::move(readBankableMemory_cb);
 }
 
+void DebuggerCallbacks::SetReadMemoryBlockCallback(Rdb::ReadMemoryBlockFunc readMemoryBlock_cb) {
+    m_readMemoryBlock_cb = std::move(readMemoryBlock_cb);
+}
+
 void DebuggerCallbacks::SetGetRegSetCallback(Rdb::GetRegSetFunc getRegSet_cb) {
     m_getRegSet_cb = std::move(getRegSet_cb);
+    m_regSetSnapshot.reset();
+}
+
+void DebuggerCallbacks::SetRegisterFile(RegisterFile registers, Rdb::ReadRegisterFunc readRegister_cb) {
+    DeclareRegisterFile(std::move(registers));
+    m_readRegister_cb = std::move(readRegister_cb);
+    m_registerStruct = nullptr;
+}
+
+void DebuggerCallbacks::SetRegisterFile(RegisterFile registers, const void* registerStruct) {
+    DeclareRegisterFile(std::move(registers));
+    m_readRegister_cb = nullptr;
+    m_registerStruct = static_cast<const std::byte*>(registerStruct);
 }
 
 }
\ No newline at end of file
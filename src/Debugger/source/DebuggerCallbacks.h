@@ -2,22 +2,43 @@
 
 #include "IDebuggerCallbacks.h"
 
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <vector>
+
 namespace Rdb {
 
 class DebuggerCallbacks : public IDebuggerCallbacks {
 public:
+    // Register ids index a lookup table, so they're kept small.
+    static constexpr size_t MaxRegisterIds = 1024;
+
     unsigned int GetPcReg() override;
     unsigned int ReadMemory(unsigned int address) override;
     bool CheckBankableMemoryLocation(BankNum bank, unsigned int address) override;
     unsigned int ReadBankableMemory(BankNum bank, unsigned int address) override;
+    bool ReadMemoryBlock(BankNum bank, unsigned int address, std::span<std::byte> buffer) override;
     RegSet GetRegSet() override;
+    RegisterId FindRegister(const std::string& name) override;
+    unsigned int ReadRegister(RegisterId id) override;
+    // Without a register file this lists the GetRegSet names with ids for ReadRegister. Unlike FindRegister's,
+    // these ids aren't held, a register file declared later may give the names other ids.
+    RegisterFile GetRegisterFile() override;
+
+    // Without a register file, reads by id share one GetRegSet call until this is called. Called once per instruction.
+    void InvalidateRegisterSnapshot() { m_regSetSnapshot.reset(); }
 
     // Set Callbacks
     void SetGetPcRegCallback(Rdb::GetProgramCounterFunc getPcReg_cb);
     void SetReadMemoryCallback(Rdb::ReadMemoryFunc readMemory_cb);
     void SetCheckBankableMemoryLocationCallback(Rdb::CheckBankableMemoryLocationFunc CheckBankableMemoryLocation_cb);
     void SetReadBankableMemoryCallback(Rdb::ReadBankableMemoryFunc readBankableMemory_cb);
+    void SetReadMemoryBlockCallback(Rdb::ReadMemoryBlockFunc readMemoryBlock_cb);
     void SetGetRegSetCallback(Rdb::GetRegSetFunc getRegSet_cb);
+    // Throws DebuggerError for an invalid register file. Can be declared again, but a register resolved by FindRegister keeps its id.
+    void SetRegisterFile(RegisterFile registers, Rdb::ReadRegisterFunc readRegister_cb);
+    void SetRegisterFile(RegisterFile registers, const void* registerStruct);
 
 private:
     // Callback functions
@@ -25,7 +46,28 @@ private:
     Rdb::ReadMemoryFunc m_readMemory_cb;
     Rdb::CheckBankableMemoryLocationFunc m_CheckBankableMemoryLocation_cb;
     Rdb::ReadBankableMemoryFunc m_readBankableMemory_cb;
+    Rdb::ReadMemoryBlockFunc m_readMemoryBlock_cb;
     Rdb::GetRegSetFunc m_getRegSet_cb;
+    Rdb::ReadRegisterFunc m_readRegister_cb;
+
+    // Declared register file, when empty registers fall back to the GetRegSet callback.
+    RegisterFile m_registerFile;
+    // Index into m_registerFile for each RegisterId, used when reading through m_registerStruct.
+    std::vector<size_t> m_registerLookup;
+    const std::byte* m_registerStruct = nullptr;
+
+    struct NamedRegister {
+        std::string name;
+        bool isHeld = false; // Resolved by FindRegister, a register file declared later must keep its id.
+    };
+    // Names handed out ids without a register file, a RegisterId is the index into this list.
+    std::vector<NamedRegister> m_registerNames;
+    bool m_hasResolvedRegisters = false; // Set once FindRegister hands out an id, conditions, watchpoints and traces hold on to it.
+    std::optional<RegSet> m_regSetSnapshot; // See InvalidateRegisterSnapshot.
+
+    void DeclareRegisterFile(RegisterFile registers);
+    RegisterId NamedRegisterId(const std::string& name);
+    unsigned int ReadRegisterStruct(RegisterId id) const;
 };
 
 }
\ No newline at end of file
@@ -1,6 +1,11 @@
 #include "DebuggerOperations.h"
 
+#include "DebuggerError.h"
+
+#include <fmt/core.h>
+
 #include <algorithm>
+#include <functional>
 #include <memory>
 #include <ranges>
 
@@ -12,6 +17,10 @@ Rdb::DebuggerOperations::DebuggerOperations(std::shared_ptr<IDebuggerCallbacks>
 void DebuggerOperations::Reset() {
     m_operations = {};
     m_jumpOperations = {};
+    m_decodeTable = {};
+    m_extendedDecodeTables.clear();
+    m_maxInstructionLength = 0;
+    m_decodesBytes = false;
 }
 
 Operations DebuggerOperations::GetOperations() const {
@@ -26,62 +35,150 @@ std::vector<RegisterInfoPtr> DebuggerOperations::GetRegisters() const {
     return m_registerList;
 }
 
-// TODO: optimize, there is some repeated stuff here
-size_t DebuggerOperations::GetOperation(size_t address, Operation& operation) {
+DecodedInstruction DebuggerOperations::Decode(size_t address) const {
+    if (m_decodeTable.entries.empty()) {
+        return DecodeFromMaps(address);
+    }
+    return DecodeFromTables(address, [this](size_t readAddress) { return m_callbacks->ReadMemory(static_cast<unsigned int>(readAddress)); });
+}
+
+DecodedInstruction DebuggerOperations::Decode(size_t address, std::span<const std::byte> memory) const {
+    if (!m_decodesBytes || memory.size() < m_maxInstructionLength) {
+        return Decode(address);
+    }
+    return DecodeFromTables(address, [address, memory](size_t readAddress) { return std::to_integer<unsigned int>(memory[readAddress - address]); });
+}
+
+bool DebuggerOperations::CanDecodeBytes() const {
+    return m_decodesBytes;
+}
+
+unsigned int DebuggerOperations::MaxInstructionLength() const {
+    return m_maxInstructionLength;
+}
+
+template<typename ReadFunc>
+DecodedInstruction DebuggerOperations::DecodeFromTables(size_t address, const ReadFunc& read) const {
+    DecodedInstruction instruction;
+    instruction.opcode = read(address++);
+    if (instruction.opcode >= m_decodeTable.entries.size()) {
+        // TODO: add error info, opcode length is too great
+        instruction.length = m_operations.opcodeLength;
+        return instruction;
+    }
+
+    const auto* decoded = &m_decodeTable.entries[instruction.opcode];
+    if (decoded->extendedTable != DecodedOperation::NoExtendedTable) {
+        // TODO: Chained extended Opcodes?
+        const auto& extendedTable = m_extendedDecodeTables[decoded->extendedTable];
+        instruction.opcode = read(address++);
+        if (instruction.opcode >= extendedTable.entries.size() || extendedTable.entries[instruction.opcode].operation == nullptr) {
+            instruction.length = (extendedTable.opcodeLength * 2) / 8U;
+            return instruction;
+        }
+        decoded = &extendedTable.entries[instruction.opcode];
+    }
+
+    // A null operation is an unrecognized opcode, may not be an error. Could be unrelated bytes being read from memory that don't correspond to a command.
+    // Or an undefined command.
+    instruction.operation = decoded->operation;
+    instruction.length = decoded->length;
+    if (instruction.operation != nullptr) {
+        ReadArguments(address, instruction, read);
+    }
+    return instruction;
+}
+
+OpcodeLength DebuggerOperations::GetOpcodeLength() const {
+    return m_operations.opcodeLength;
+}
+
+bool DebuggerOperations::IsExtensionOpcode(unsigned int opcode) const {
+    if (!m_decodeTable.entries.empty()) {
+        return opcode < m_decodeTable.entries.size() && m_decodeTable.entries[opcode].extendedTable != DecodedOperation::NoExtendedTable;
+    }
+    return !m_operations.operations.contains(opcode) && m_operations.extendedOperations.contains(opcode);
+}
+
+bool DebuggerOperations::IsJumpOperation(unsigned int opcode) const {
+    if (!m_decodeTable.entries.empty()) {
+        return opcode < m_decodeTable.jumps.size() && m_decodeTable.jumps[opcode];
+    }
+    return m_jumpOperations.operations.contains(opcode);
+}
+
+bool DebuggerOperations::IsJumpOperation(unsigned int extensionOpcode, unsigned int opcode) const {
+    if (!m_decodeTable.entries.empty()) {
+        if (!IsExtensionOpcode(extensionOpcode)) { return false; }
+        const auto& jumps = m_extendedDecodeTables[m_decodeTable.entries[extensionOpcode].extendedTable].jumps;
+        return opcode < jumps.size() && jumps[opcode];
+    }
+    const auto iter = m_jumpOperations.extendedOperations.find(extensionOpcode);
+    return iter != m_jumpOperations.extendedOperations.end() && iter->second.operations.contains(opcode);
+}
+
+// Used when an opcode length is too large to decode through a dense table.
+DecodedInstruction DebuggerOperations::DecodeFromMaps(size_t address) const {
     // Read the opcode
     static constexpr auto byteSize = 8U;
-    const auto opcode1 = m_callbacks->ReadMemory(static_cast<unsigned int>(address++));
+    const auto readMemory = [this](size_t readAddress) { return m_callbacks->ReadMemory(static_cast<unsigned int>(readAddress)); };
+    DecodedInstruction instruction;
+    instruction.opcode = readMemory(address++);
 
     // Check for a bad opcode, "opcode greater than the emulated systems opcode length"
     // This is likely an error if the set up ReadMemory callback.
     // For now return the opcode number read and then return the expected size to go to the next address.
-    if (opcode1 >= (1U << m_operations.opcodeLength)) {
+    if (instruction.opcode >= (1U << m_operations.opcodeLength)) {
         // TODO: add error info, opcode length is too great
-        auto name = std::to_string(opcode1);
-        operation.info = std::make_shared<OperationInfo>(name, false);
-        return m_operations.opcodeLength;
+        instruction.length = m_operations.opcodeLength;
+        return instruction;
     }
 
     // Check opcodes for the read opcode
-    if (m_operations.operations.contains(opcode1)) {
-        operation = m_operations.operations.at(opcode1);
-        auto numOpcodes = (m_operations.opcodeLength / byteSize); // length in bytes
-        for (const auto& arg : operation.arguments) {
-            const auto argLength = GetArgTypeLength(arg->type);
-            for (auto i = 0U; i < argLength; ++i) {
-                const auto bitShift = byteSize * i;
-                arg->operationValue |= m_callbacks->ReadMemory(static_cast<unsigned int>(address++)) << bitShift;
-            }
-            numOpcodes += argLength;
-        }
-        return numOpcodes;
+    if (const auto iter = m_operations.operations.find(instruction.opcode);
+        iter != m_operations.operations.end()) {
+        instruction.operation = &iter->second;
+        instruction.length = static_cast<unsigned int>((m_operations.opcodeLength / byteSize) + ReadArguments(address, instruction, readMemory)); // length in bytes
     }
-    else if (m_operations.extendedOperations.contains(opcode1)) {
-        const auto& extOperations = m_operations.extendedOperations.at(opcode1);
-        const auto opcode2 = m_callbacks->ReadMemory(static_cast<unsigned int>(address++));
-        auto numOpcodes = (extOperations.opcodeLength * 2) / byteSize; // Extended Opcode and Opcode.
-        operation = extOperations.operations.at(opcode2);
-
+    else if (const auto extIter = m_operations.extendedOperations.find(instruction.opcode);
+             extIter != m_operations.extendedOperations.end()) {
+        const auto& extOperations = extIter->second;
+        instruction.opcode = readMemory(address++);
+        const auto numOpcodes = (extOperations.opcodeLength * 2) / byteSize; // Extended Opcode and Opcode.
+        instruction.length = numOpcodes;
         // TODO: Chained extended Opcodes?
-        for (const auto& arg : operation.arguments) {
-            // TODO: immediate values a bit hacky, assumes a byte being read back
-            //       Need to add the ability to specify ReadMemory callbacks size.
-            const auto argLength = GetArgTypeLength(arg->type);
-            for (auto i = 0U; i < argLength; ++i) {
-                const auto bitShift = byteSize * i;
-                arg->operationValue |= m_callbacks->ReadMemory(static_cast<unsigned int>(address++)) << bitShift;
-            }
-            numOpcodes += argLength;
+        if (const auto opIter = extOperations.operations.find(instruction.opcode);
+            opIter != extOperations.operations.end()) {
+            instruction.operation = &opIter->second;
+            instruction.length += static_cast<unsigned int>(ReadArguments(address, instruction, readMemory));
         }
-        return numOpcodes;
     }
     else {
         // Unrecognized opcode, may not be an error. Could be unrelated bytes being read from memory that don't correspond to a command.
         // Or an undefined command.
-        auto name = std::to_string(opcode1);
-        operation.info = std::make_shared<OperationInfo>(name, false);
-        return 1;
+        instruction.length = 1;
+    }
+    return instruction;
+}
+
+// Reads the immediate values following the opcode into the instruction, returns the number of bytes read.
+template<typename ReadFunc>
+size_t DebuggerOperations::ReadArguments(size_t address, DecodedInstruction& instruction, const ReadFunc& read) const {
+    static constexpr auto byteSize = 8U;
+    size_t argumentsLength = 0;
+    for (auto index = 0U; const auto& arg : instruction.operation->arguments) {
+        // TODO: immediate values a bit hacky, assumes a byte being read back
+        //       Need to add the ability to specify ReadMemory callbacks size.
+        const auto argLength = GetArgTypeLength(arg->type);
+        unsigned int value = 0;
+        for (auto i = 0U; i < argLength; ++i) {
+            const auto bitShift = byteSize * i;
+            value |= read(address++) << bitShift;
+        }
+        instruction.argumentValues[index++] = value;
+        argumentsLength += argLength;
     }
+    return argumentsLength;
 }
 
 void DebuggerOperations::SetOperations(const XmlOperationsMap& XmlOperations) {
@@ -103,7 +200,44 @@ void DebuggerOperations::SetOperations(const XmlOperationsMap& XmlOperations) {
         }
     }
 
-    // Rad through all opcodes and note the Jump opcodes
+    BuildJumpOperations();
+    if (LayOutDecodeTables()) {
+        FillDecodeTables();
+        FinishDecodeTables();
+    }
+}
+
+// Converted straight from the compiled tables, the decode tables use their precomputed argument lengths.
+void DebuggerOperations::SetOperations(StaticOperationsTables operations) {
+    // Merged into operations set earlier, the tables don't hold every opcode then.
+    const auto isMerging = !m_operations.operations.empty() || !m_operations.extendedOperations.empty();
+    for (const auto& table : operations) {
+        if (table.key == NormalOperationsKey) {
+            for (const auto& operation : table.operations) {
+                ConvertOperation(m_operations.operations, operation);
+            }
+            m_operations.opcodeLength = table.opcodeLength;
+        }
+        else {
+            Operations operationsMap;
+            for (const auto& operation : table.operations) {
+                ConvertOperation(operationsMap.operations, operation);
+            }
+            operationsMap.opcodeLength = table.opcodeLength;
+            m_operations.extendedOperations.emplace(table.key, std::move(operationsMap));
+            // TODO: Chained extended Opcodes?
+        }
+    }
+
+    BuildJumpOperations();
+    if (LayOutDecodeTables()) {
+        isMerging ? FillDecodeTables() : FillDecodeTables(operations);
+        FinishDecodeTables();
+    }
+}
+
+// Read through all opcodes and note the Jump opcodes
+void DebuggerOperations::BuildJumpOperations() {
     m_jumpOperations.opcodeLength = m_operations.opcodeLength;
     for (const auto& operation : m_operations.operations) {
         if (operation.second.info->isJump) {
@@ -111,54 +245,178 @@ void DebuggerOperations::SetOperations(const XmlOperationsMap& XmlOperations) {
         }
     }
     // TODO: Chained extended Opcodes?
-    for (const auto& operations : m_operations.extendedOperations) {
-        for (const auto& operation : operations.second.operations) {
+    for (const auto& [extensionOpcode, extOperations] : m_operations.extendedOperations) {
+        Operations jumpOperations = { .opcodeLength = extOperations.opcodeLength };
+        for (const auto& operation : extOperations.operations) {
             if (operation.second.info->isJump) {
-                m_jumpOperations.extendedOperations.emplace(operations);
+                jumpOperations.operations.emplace(operation);
             }
         }
+        if (!jumpOperations.operations.empty()) {
+            m_jumpOperations.extendedOperations.insert_or_assign(extensionOpcode, std::move(jumpOperations));
+        }
     }
 }
 
-// TODO: clean this up.
-void DebuggerOperations::ConvertOperation(OpcodeToOperation& operationMap, const XmlDebuggerOperation& xmlOperation) {
-    const auto findMatchingOperationName = [xmlOperation](const std::shared_ptr<OperationInfo>& operation) -> bool { return operation->name == xmlOperation.command; };
-
+bool DebuggerOperations::LayOutDecodeTables() {
+    m_decodeTable = {};
+    m_extendedDecodeTables.clear();
+    m_maxInstructionLength = 0;
+    m_decodesBytes = false;
 
-    OperationInfoPtr operationInfoPtr;
-    const auto findResult = std::find_if(m_operationList.begin(), m_operationList.end(), findMatchingOperationName);
-    if (findResult == m_operationList.end()) {
-        auto operationInfo = std::make_shared<OperationInfo>(xmlOperation.command, xmlOperation.isJump);
+    const auto tooLarge = [](const Operations& operations) { return operations.opcodeLength > MaxDenseOpcodeLength; };
+    if (tooLarge(m_operations) || std::ranges::any_of(m_operations.extendedOperations | std::views::values, tooLarge)) {
+        return false;
+    }
 
-        operationInfoPtr = m_operationList.emplace_back(operationInfo);
+    m_decodeTable.opcodeLength = m_operations.opcodeLength;
+    m_decodeTable.entries.resize(size_t{ 1 } << m_operations.opcodeLength);
+    m_decodeTable.jumps.resize(m_decodeTable.entries.size());
+    for (const auto opcode : m_jumpOperations.operations | std::views::keys) {
+        if (opcode < m_decodeTable.jumps.size()) { m_decodeTable.jumps[opcode] = true; }
     }
-    else {
-        operationInfoPtr = *findResult;
+
+    // TODO: Chained extended Opcodes?
+    for (const auto& [extensionOpcode, extOperations] : m_operations.extendedOperations) {
+        if (extensionOpcode >= m_decodeTable.entries.size()) { continue; }
+        if (m_operations.operations.contains(extensionOpcode)) { continue; } // A normal operation takes priority over the extension.
+
+        DecodeTable table;
+        table.opcodeLength = extOperations.opcodeLength;
+        table.entries.resize(size_t{ 1 } << extOperations.opcodeLength);
+        table.jumps.resize(table.entries.size());
+        for (const auto& [opcode, operation] : extOperations.operations) {
+            if (opcode < table.jumps.size() && operation.info->isJump) { table.jumps[opcode] = true; }
+        }
+        m_decodeTable.entries[extensionOpcode].extendedTable = static_cast<unsigned int>(m_extendedDecodeTables.size());
+        m_extendedDecodeTables.push_back(std::move(table));
     }
+    return true;
+}
 
-    std::vector<ArgumentPtr> operationArguments;
-    for (const auto& arg : xmlOperation.arguments) {
-        const Argument argument = { arg.type, arg.indirectArg, arg.operation, arg.value.offset, arg.value.name, arg.value.reg };
+void DebuggerOperations::FillDecodeTables() {
+    static constexpr auto byteSize = 8U;
+    const auto argumentsLength = [](const Operation& operation) {
+        unsigned int length = 0;
+        for (const auto& arg : operation.arguments) {
+            length += GetArgTypeLength(arg->type);
+        }
+        return length;
+    };
+
+    for (const auto& [opcode, operation] : m_operations.operations) {
+        if (opcode >= m_decodeTable.entries.size()) { continue; }
+        m_decodeTable.entries[opcode] = { &operation, (m_operations.opcodeLength / byteSize) + argumentsLength(operation) };
+    }
+    for (const auto& [extensionOpcode, extOperations] : m_operations.extendedOperations) {
+        if (extensionOpcode >= m_decodeTable.entries.size() || m_decodeTable.entries[extensionOpcode].extendedTable == DecodedOperation::NoExtendedTable) { continue; }
 
-        ArgumentPtr argumentPtr;
-        const auto argumentFind = std::find_if(m_argumentList.begin(), m_argumentList.end(), [argument](const ArgumentPtr& argPtr) -> bool { return argument == *argPtr; });
-        if (argumentFind == m_argumentList.end()) {
-            auto argumentInfo = std::make_shared<Argument>(argument);
-            argumentPtr = m_argumentList.emplace_back(argumentInfo);
+        auto& table = m_extendedDecodeTables[m_decodeTable.entries[extensionOpcode].extendedTable];
+        const auto numOpcodes = (extOperations.opcodeLength * 2) / byteSize; // Extended Opcode and Opcode.
+        for (const auto& [opcode, operation] : extOperations.operations) {
+            if (opcode >= table.entries.size()) { continue; }
+            table.entries[opcode] = { &operation, numOpcodes + argumentsLength(operation) };
         }
-        else {
-            argumentPtr = *argumentFind;
+    }
+}
+
+// Entries point at the operations converted from 'operations', the first of an opcode set twice wins as it does in the maps.
+void DebuggerOperations::FillDecodeTables(StaticOperationsTables operations) {
+    static constexpr auto byteSize = 8U;
+    for (const auto& staticTable : operations) {
+        const auto isNormal = staticTable.key == NormalOperationsKey;
+        if (!isNormal && (staticTable.key >= m_decodeTable.entries.size() || m_decodeTable.entries[staticTable.key].extendedTable == DecodedOperation::NoExtendedTable)) {
+            continue;
         }
-        const RegisterInfo reg = { argumentPtr->reg };
-        operationArguments.emplace_back(argumentPtr);
-        if (!reg.name.empty() && std::find_if(m_registerList.begin(), m_registerList.end(), [&](const RegisterInfoPtr& regInfo) { return reg.name == regInfo->name; }) == m_registerList.end()) {
-            m_registerList.emplace_back(std::make_shared<RegisterInfo>(reg));
+
+        auto& table = isNormal ? m_decodeTable : m_extendedDecodeTables[m_decodeTable.entries[staticTable.key].extendedTable];
+        const auto& operationMap = isNormal ? m_operations.operations : m_operations.extendedOperations.at(staticTable.key).operations;
+        const auto numOpcodes = isNormal ? table.opcodeLength / byteSize : (table.opcodeLength * 2) / byteSize; // Extended Opcode and Opcode.
+        for (const auto& operation : staticTable.operations) {
+            if (operation.opcode >= table.entries.size() || table.entries[operation.opcode].operation != nullptr) { continue; }
+            table.entries[operation.opcode] = { &operationMap.at(operation.opcode), numOpcodes + operation.argumentsLength };
         }
     }
+}
 
-    auto opcode = xmlOperation.opcode;
-    const Operation operation = { operationInfoPtr, operationArguments };
-    operationMap.emplace(opcode, operation);
+void DebuggerOperations::FinishDecodeTables() {
+    const auto longest = [](const DecodeTable& table) { return std::ranges::max(table.entries, {}, &DecodedOperation::length).length; };
+    m_maxInstructionLength = longest(m_decodeTable);
+    for (const auto& table : m_extendedDecodeTables) {
+        m_maxInstructionLength = std::max(m_maxInstructionLength, longest(table));
+    }
+    // Wider opcodes read a whole opcode from one address, so consecutive addresses aren't consecutive bytes.
+    const auto byteWide = [](const DecodeTable& table) { return table.opcodeLength <= 8U; };
+    m_decodesBytes = byteWide(m_decodeTable) && std::ranges::all_of(m_extendedDecodeTables, byteWide);
+}
+
+void DebuggerOperations::ConvertOperation(OpcodeToOperation& operationMap, const XmlDebuggerOperation& xmlOperation) {
+    auto operation = MakeOperation(xmlOperation.opcode, xmlOperation.command, xmlOperation.isJump, xmlOperation.arguments.size());
+    for (const auto& arg : xmlOperation.arguments) {
+        AddArgument(operation, { arg.type, arg.indirectArg, arg.operation, arg.value.offset, arg.value.name, arg.value.reg });
+    }
+    operationMap.emplace(xmlOperation.opcode, std::move(operation));
+}
+
+void DebuggerOperations::ConvertOperation(OpcodeToOperation& operationMap, const StaticDebuggerOperation& staticOperation) {
+    auto operation = MakeOperation(staticOperation.opcode, staticOperation.command, staticOperation.isJump, staticOperation.arguments.size());
+    for (const auto& arg : staticOperation.arguments) {
+        AddArgument(operation, { arg.type, arg.indirectArg, arg.operation, arg.offset, std::string(arg.name), std::string(arg.reg) });
+    }
+    operationMap.emplace(staticOperation.opcode, std::move(operation));
 }
 
-}
\ No newline at end of file
+Operation DebuggerOperations::MakeOperation(unsigned int opcode, std::string_view command, bool isJump, size_t argumentCount) {
+    if (argumentCount > DecodedInstruction::MaxArguments) {
+        throw DebuggerError(fmt::format("Operation '{}' (opcode 0x{:X}) has {} arguments, at most {} are supported.", command, opcode, argumentCount, DecodedInstruction::MaxArguments));
+    }
+    Operation operation = { m_operationList[static_cast<size_t>(InternOperationInfo(command, isJump))], {} };
+    operation.arguments.reserve(argumentCount);
+    return operation;
+}
+
+void DebuggerOperations::AddArgument(Operation& operation, const Argument& argument) {
+    const auto& argumentPtr = m_argumentList[static_cast<size_t>(InternArgument(argument))];
+    if (!argumentPtr->reg.empty()) {
+        InternRegister(argumentPtr->reg);
+    }
+    operation.arguments.emplace_back(argumentPtr);
+}
+
+// Operations are shared by name, the first operation with a name decides whether it is a jump.
+OperationInfoId DebuggerOperations::InternOperationInfo(std::string_view command, bool isJump) {
+    const auto [iter, isNew] = m_operationIds.try_emplace(std::string(command), OperationInfoId{ static_cast<unsigned int>(m_operationList.size()) });
+    if (isNew) {
+        m_operationList.emplace_back(std::make_shared<OperationInfo>(iter->first, isJump));
+    }
+    return iter->second;
+}
+
+ArgumentId DebuggerOperations::InternArgument(const Argument& argument) {
+    const auto [iter, isNew] = m_argumentIds.try_emplace(argument, ArgumentId{ static_cast<unsigned int>(m_argumentList.size()) });
+    if (isNew) {
+        m_argumentList.emplace_back(std::make_shared<Argument>(argument));
+    }
+    return iter->second;
+}
+
+RegisterInfoId DebuggerOperations::InternRegister(const std::string& name) {
+    const auto [iter, isNew] = m_registerIds.try_emplace(name, RegisterInfoId{ static_cast<unsigned int>(m_registerList.size()) });
+    if (isNew) {
+        m_registerList.emplace_back(std::make_shared<RegisterInfo>(RegisterInfo{ name }));
+    }
+    return iter->second;
+}
+
+// Hashes the fields Argument::operator== compares.
+size_t DebuggerOperations::ArgumentHash::operator()(const Argument& argument) const {
+    const auto combine = [](size_t seed, size_t value) { return seed ^ (value + 0x9E3779B97F4A7C15ULL + (seed << 6U) + (seed >> 2U)); };
+    auto hash = std::hash<std::string>{}(argument.name);
+    hash = combine(hash, std::hash<int>{}(static_cast<int>(argument.type)));
+    hash = combine(hash, std::hash<bool>{}(argument.indirectArg));
+    hash = combine(hash, std::hash<int>{}(static_cast<int>(argument.operation)));
+    hash = combine(hash, std::hash<unsigned int>{}(argument.operationValue));
+    return hash;
+}
+
+}
@@ -2,9 +2,32 @@
 
 #include "DebuggerCommon.h"
 #include "IDebuggerCallbacks.h"
+#include "StaticOperations.h"
+
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 
 namespace Rdb {
 
+// Handles to interned operation names, arguments and registers, an index into their list.
+enum class OperationInfoId : unsigned int;
+enum class ArgumentId : unsigned int;
+enum class RegisterInfoId : unsigned int;
+
+// Compact record for one opcode in a dense decode table.
+struct DecodedOperation {
+    static constexpr unsigned int NoExtendedTable = std::numeric_limits<unsigned int>::max();
+
+    const Operation* operation = nullptr; // Points into the operation maps, null for an undefined opcode.
+    unsigned int length = 1; // Instruction size in bytes, opcodes and arguments.
+    unsigned int extendedTable = NoExtendedTable; // Set when the opcode prefixes an extended table.
+};
+
 class DebuggerOperations {
 public:
     DebuggerOperations(std::shared_ptr<IDebuggerCallbacks> callbacks);
@@ -15,19 +38,73 @@ public:
     Operations GetJumpOperations() const;
     std::vector<RegisterInfoPtr> GetRegisters() const;
 
-    size_t GetOperation(size_t address, Operation& operation);
+    // Const and free of shared state, decodes may run concurrently when the ReadMemory callback allows it.
+    DecodedInstruction Decode(size_t address) const;
+    // Decodes from 'memory', the bytes from 'address' onwards, without calling ReadMemory.
+    // Falls back to Decode(address) when opcodes aren't byte wide or 'memory' is shorter than MaxInstructionLength().
+    DecodedInstruction Decode(size_t address, std::span<const std::byte> memory) const;
+    [[nodiscard]] bool CanDecodeBytes() const;
+    [[nodiscard]] unsigned int MaxInstructionLength() const;
+
+    // Jump queries for the per-instruction finish check, these don't copy any operations.
+    OpcodeLength GetOpcodeLength() const;
+    bool IsExtensionOpcode(unsigned int opcode) const;
+    bool IsJumpOperation(unsigned int opcode) const;
+    bool IsJumpOperation(unsigned int extensionOpcode, unsigned int opcode) const;
     void SetOperations(const XmlOperationsMap& operations);
+    void SetOperations(StaticOperationsTables operations);
 
 private:
+    // Opcode lengths above this fall back to decoding through the operation maps.
+    static constexpr OpcodeLength MaxDenseOpcodeLength = 16;
+
+    struct DecodeTable {
+        OpcodeLength opcodeLength = 0;
+        std::vector<DecodedOperation> entries;
+        std::vector<bool> jumps; // Bit per opcode, set for jump operations.
+    };
+
+    void BuildJumpOperations();
+    // Sizes the dense tables for the operation maps and links the extended tables, entries are left undefined.
+    // False when an opcode length is too large for a flat table.
+    bool LayOutDecodeTables();
+    void FillDecodeTables();
+    void FillDecodeTables(StaticOperationsTables operations);
+    void FinishDecodeTables();
+    // 'read' returns the memory at an address.
+    template<typename ReadFunc>
+    DecodedInstruction DecodeFromTables(size_t address, const ReadFunc& read) const;
+    DecodedInstruction DecodeFromMaps(size_t address) const;
+    template<typename ReadFunc>
+    size_t ReadArguments(size_t address, DecodedInstruction& instruction, const ReadFunc& read) const;
     void ConvertOperation(OpcodeToOperation& operationMap, const XmlDebuggerOperation& xmlOperation);
+    void ConvertOperation(OpcodeToOperation& operationMap, const StaticDebuggerOperation& staticOperation);
+    Operation MakeOperation(unsigned int opcode, std::string_view command, bool isJump, size_t argumentCount);
+    void AddArgument(Operation& operation, const Argument& argument);
+    OperationInfoId InternOperationInfo(std::string_view command, bool isJump);
+    ArgumentId InternArgument(const Argument& argument);
+    RegisterInfoId InternRegister(const std::string& name);
+
+    struct ArgumentHash {
+        size_t operator()(const Argument& argument) const;
+    };
 
     Operations m_operations = {};
     Operations m_jumpOperations = {};
+    // Dense tables indexed by opcode, empty when an opcode length is too large for a flat table.
+    DecodeTable m_decodeTable = {};
+    std::vector<DecodeTable> m_extendedDecodeTables = {};
+    unsigned int m_maxInstructionLength = 0;
+    bool m_decodesBytes = false; // Every opcode is byte wide, so an address holds one byte.
 
     std::shared_ptr<IDebuggerCallbacks> m_callbacks;
     std::vector<ArgumentPtr> m_argumentList;
     std::vector<RegisterInfoPtr> m_registerList;
     std::vector<OperationInfoPtr> m_operationList;
+    // Interning tables, each maps a key to its handle in the lists above.
+    std::unordered_map<std::string, OperationInfoId> m_operationIds;
+    std::unordered_map<Argument, ArgumentId, ArgumentHash> m_argumentIds;
+    std::unordered_map<std::string, RegisterInfoId> m_registerIds;
 };
 
 }
\ No newline at end of file
@@ -0,0 +1,96 @@
+#include "Disassembler.h"
+
+#include "DebuggerError.h"
+
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+namespace Rdb {
+
+Disassembler::Disassembler(const DebuggerOperations& operations, unsigned int numThreads) :
+    m_operations(operations),
+    m_numThreads(numThreads != 0 ? numThreads : std::max(1U, std::thread::hardware_concurrency())) {}
+
+Disassembly Disassembler::Disassemble(size_t address, std::span<const std::byte> memory, size_t size) const {
+    if (!m_operations.CanDecodeBytes()) {
+        throw DebuggerError("Bulk disassembly needs every opcode to be byte wide.");
+    }
+    size = std::min(size, memory.size());
+    if (size == 0) { return {}; }
+
+    // Several chunks per thread, so a thread that finishes early picks up another chunk.
+    static constexpr size_t chunksPerThread = 4;
+    const auto chunkSize = std::max(MinChunkSize, (size + (m_numThreads * chunksPerThread) - 1) / (m_numThreads * chunksPerThread));
+    std::vector<Chunk> chunks;
+    for (size_t begin = 0; begin < size; begin += chunkSize) {
+        chunks.push_back({ begin, std::min(begin + chunkSize, size), {}, 0 });
+    }
+
+    std::atomic<size_t> nextChunk = 0;
+    const auto decodeChunks = [&]() {
+        for (auto index = nextChunk++; index < chunks.size(); index = nextChunk++) {
+            DecodeChunk(address, memory, chunks[index]);
+        }
+    };
+    {
+        std::vector<std::jthread> workers;
+        for (auto i = 1U; i < std::min<size_t>(m_numThreads, chunks.size()); ++i) {
+            workers.emplace_back(decodeChunks);
+        }
+        decodeChunks();
+    }
+
+    Disassembly disassembly;
+    size_t instructionCount = 0;
+    for (const auto& chunk : chunks) {
+        instructionCount += chunk.instructions.size();
+    }
+    disassembly.reserve(instructionCount);
+
+    size_t offset = 0; // Where the previous chunk's instructions actually ended.
+    for (auto& chunk : chunks) {
+        // Decode from the real boundary until it lands on an instruction the chunk guessed, from there on the two agree.
+        auto guessed = chunk.instructions.begin();
+        bool isSynchronised = false;
+        while (!isSynchronised && offset < chunk.end) {
+            guessed = std::ranges::lower_bound(guessed, chunk.instructions.end(), address + offset, {}, &DisassembledInstruction::address);
+            isSynchronised = guessed != chunk.instructions.end() && guessed->address == address + offset;
+            if (!isSynchronised) {
+                const auto instruction = DecodeAt(address, memory, offset);
+                disassembly.push_back({ address + offset, instruction });
+                offset += std::max(instruction.length, 1U);
+            }
+        }
+        if (isSynchronised) {
+            std::move(guessed, chunk.instructions.end(), std::back_inserter(disassembly));
+            offset = chunk.exit;
+        }
+    }
+    return disassembly;
+}
+
+DecodedInstruction Disassembler::DecodeAt(size_t address, std::span<const std::byte> memory, size_t offset) const {
+    const auto bytes = memory.subspan(offset);
+    if (bytes.size() >= m_operations.MaxInstructionLength()) {
+        return m_operations.Decode(address + offset, bytes);
+    }
+
+    std::vector<std::byte> padded(m_operations.MaxInstructionLength());
+    std::ranges::copy(bytes, padded.begin());
+    return m_operations.Decode(address + offset, padded);
+}
+
+void Disassembler::DecodeChunk(size_t address, std::span<const std::byte> memory, Chunk& chunk) const {
+    auto offset = chunk.begin;
+    while (offset < chunk.end) {
+        const auto instruction = DecodeAt(address, memory, offset);
+        chunk.instructions.push_back({ address + offset, instruction });
+        offset += std::max(instruction.length, 1U); // Always move on, even for a table without lengths.
+    }
+    chunk.exit = offset;
+}
+
+}
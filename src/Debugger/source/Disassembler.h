@@ -0,0 +1,40 @@
+#pragma once
+
+#include "DebuggerCommon.h"
+#include "DebuggerOperations.h"
+
+#include <cstddef>
+#include <span>
+
+namespace Rdb {
+
+// Decodes whole address ranges from a copy of their bytes, split into chunks that are decoded on worker threads.
+// Every chunk but the first starts at a guessed instruction boundary, so each is re-synchronised afterwards with where
+// the instructions of the chunk before it actually ended. Needs byte wide opcodes, see DebuggerOperations::CanDecodeBytes.
+class Disassembler {
+public:
+    static constexpr size_t MinChunkSize = 0x1000;
+
+    // 0 threads uses one per hardware thread.
+    explicit Disassembler(const DebuggerOperations& operations, unsigned int numThreads = 0);
+
+    // Decodes the instructions starting in the first 'size' bytes of 'memory', which holds the bytes from 'address' onwards.
+    // The bytes after 'size' are read by the last instructions, any further bytes read as 0.
+    [[nodiscard]] Disassembly Disassemble(size_t address, std::span<const std::byte> memory, size_t size) const;
+
+private:
+    struct Chunk {
+        size_t begin; // Offsets into the memory.
+        size_t end;
+        Disassembly instructions;
+        size_t exit; // Offset after the last instruction, at or past 'end'.
+    };
+
+    [[nodiscard]] DecodedInstruction DecodeAt(size_t address, std::span<const std::byte> memory, size_t offset) const;
+    void DecodeChunk(size_t address, std::span<const std::byte> memory, Chunk& chunk) const;
+
+    const DebuggerOperations& m_operations;
+    unsigned int m_numThreads;
+};
+
+}
@@ -0,0 +1,72 @@
+#include "ExecutionProfile.h"
+
+#include <algorithm>
+#include <ranges>
+
+namespace {
+template<typename ValueType>
+std::vector<ValueType> MostExecuted(std::vector<ValueType> values, size_t count) {
+    count = std::min(count, values.size());
+    std::ranges::partial_sort(values, values.begin() + static_cast<std::ptrdiff_t>(count), std::ranges::greater{}, &ValueType::count);
+    values.resize(count);
+    return values;
+}
+}
+
+namespace Rdb {
+
+ExecutionProfile::ExecutionProfile(size_t addressSpaceSize) {
+    Reset(addressSpaceSize);
+}
+
+void ExecutionProfile::Reset(size_t addressSpaceSize) {
+    m_counters.Reset(addressSpaceSize);
+}
+
+void ExecutionProfile::MapBank(BankNum bank, unsigned int startAddress, unsigned int endAddress) {
+    m_counters.MapBank(bank, startAddress, endAddress);
+}
+
+std::uint64_t ExecutionProfile::Total() const {
+    std::uint64_t total = 0;
+    for (const auto& page : m_counters.Pages() | std::views::values) {
+        for (const auto count : *page) {
+            total += count;
+        }
+    }
+    return total;
+}
+
+std::vector<ProfileHotspot> ExecutionProfile::TopAddresses(size_t count) const {
+    std::vector<ProfileHotspot> hotspots;
+    for (const auto& [key, page] : m_counters.Pages()) {
+        const auto& [bank, pageNumber] = key;
+        for (auto offset = 0U; offset < PageSize; ++offset) {
+            if ((*page)[offset] != 0) {
+                hotspots.push_back({ bank, (pageNumber * PageSize) + offset, (*page)[offset] });
+            }
+        }
+    }
+    return MostExecuted(std::move(hotspots), count);
+}
+
+std::vector<ProfileRange> ExecutionProfile::TopRanges(size_t count, unsigned int maxGap) const {
+    std::vector<ProfileRange> ranges;
+    // Pages are ordered by bank then address, so a bank's addresses are visited in order.
+    for (const auto& [key, page] : m_counters.Pages()) {
+        const auto& [bank, pageNumber] = key;
+        for (auto offset = 0U; offset < PageSize; ++offset) {
+            if ((*page)[offset] == 0) { continue; }
+
+            const auto address = (pageNumber * PageSize) + offset;
+            if (ranges.empty() || ranges.back().bank != bank || address - ranges.back().endAddress > maxGap) {
+                ranges.push_back({ bank, address, address, 0 });
+            }
+            ranges.back().endAddress = address;
+            ranges.back().count += (*page)[offset];
+        }
+    }
+    return MostExecuted(std::move(ranges), count);
+}
+
+}
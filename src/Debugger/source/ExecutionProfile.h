@@ -0,0 +1,58 @@
+#pragma once
+
+#include "BankedPageTable.h"
+#include "RetroDebuggerCommon.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Rdb {
+
+struct ProfileHotspot {
+    BankNum bank = AnyBank;
+    unsigned int address = 0;
+    std::uint64_t count = 0;
+};
+
+// Executed addresses close enough together to be one stretch of code, such as a loop.
+struct ProfileRange {
+    BankNum bank = AnyBank;
+    unsigned int startAddress = 0;
+    unsigned int endAddress = 0; // Last executed address, inclusive.
+    std::uint64_t count = 0; // Instructions executed in the range.
+};
+
+// Dense per-address execution counts, kept apart for each bank mapped over an address.
+class ExecutionProfile {
+public:
+    static constexpr unsigned int SliceSize = 16;
+    static constexpr unsigned int PageSize = 0x100; // Counters are allocated a page of addresses at a time.
+    static constexpr unsigned int DefaultRangeGap = 4;
+
+    explicit ExecutionProfile(size_t addressSpaceSize = 0);
+
+    // Drops every count and profiles addresses below 'addressSpaceSize', every address starts out in AnyBank.
+    void Reset(size_t addressSpaceSize);
+    // 'bank' is now mapped over [startAddress, endAddress].
+    void MapBank(BankNum bank, unsigned int startAddress, unsigned int endAddress);
+
+    // Addresses outside the profiled address space aren't counted.
+    void Count(unsigned int address) {
+        if (auto* counters = m_counters.Mapped(address)) {
+            ++counters[address % SliceSize]; // NOLINT (cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+    }
+
+    [[nodiscard]] std::uint64_t Total() const;
+    // Up to 'count' of the most executed addresses, most executed first.
+    [[nodiscard]] std::vector<ProfileHotspot> TopAddresses(size_t count) const;
+    // Up to 'count' of the most executed ranges, most executed first.
+    // A range ends where more than 'maxGap' addresses follow an executed address without another being executed.
+    [[nodiscard]] std::vector<ProfileRange> TopRanges(size_t count, unsigned int maxGap = DefaultRangeGap) const;
+
+private:
+    BankedPageTable<std::uint64_t, PageSize, SliceSize> m_counters = {};
+};
+
+}
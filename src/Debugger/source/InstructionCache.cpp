@@ -0,0 +1,95 @@
+#include "InstructionCache.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace {
+unsigned int EndAddress(unsigned int address, size_t size) {
+    // Clamp so a range at the top of the address space doesn't wrap.
+    const auto end = static_cast<unsigned long long>(address) + size;
+    return static_cast<unsigned int>(std::min<unsigned long long>(end, std::numeric_limits<unsigned int>::max()));
+}
+}
+
+namespace Rdb {
+
+void InstructionCache::MapBank(BankNum bank, unsigned int startAddress, unsigned int endAddress) {
+    const auto end = EndAddress(endAddress, 1);
+    std::erase_if(m_bankRegions, [startAddress, end](const Region& region) { return region.start < end && startAddress < region.end; });
+    m_bankRegions.push_back({ startAddress, end, bank });
+}
+
+void InstructionCache::SetReadOnly(unsigned int startAddress, unsigned int endAddress) {
+    m_readOnlyRegions.push_back({ startAddress, EndAddress(endAddress, 1), AnyBank });
+}
+
+BankNum InstructionCache::BankAt(unsigned int address) const {
+    const auto iter = std::ranges::find_if(m_bankRegions, [address](const Region& region) { return region.start <= address && address < region.end; });
+    return iter != m_bankRegions.end() ? iter->bank : AnyBank;
+}
+
+const DecodedInstruction* InstructionCache::Find(BankNum bank, unsigned int address) const {
+    if (const auto bankIter = m_entries.find(bank);
+        bankIter != m_entries.end()) {
+        if (const auto iter = bankIter->second.find(address);
+            iter != bankIter->second.end()) {
+            return &iter->second;
+        }
+    }
+    return nullptr;
+}
+
+void InstructionCache::Insert(BankNum bank, unsigned int address, const DecodedInstruction& instruction) {
+    const auto length = instruction.length;
+    if (!m_writesReported && !IsReadOnly(address, EndAddress(address, length))) { return; }
+
+    m_entries[bank].insert_or_assign(address, instruction);
+    m_lowestAddress = std::min(m_lowestAddress, address);
+    m_highestEnd = std::max(m_highestEnd, EndAddress(address, length));
+    m_maxLength = std::max(m_maxLength, length);
+}
+
+void InstructionCache::Invalidate(BankNum bank, unsigned int address, size_t size) {
+    m_writesReported = true;
+    if (m_entries.empty() || size == 0) { return; }
+
+    const auto end = EndAddress(address, size);
+    if (end <= m_lowestAddress || m_highestEnd <= address || IsReadOnly(address, end)) { return; }
+
+    // Listings made without a reported bank may hold any bank's code, so those are dropped as well.
+    const auto writtenBank = bank == AnyBank ? BankAt(address) : bank;
+    for (const auto cachedBank : { writtenBank, AnyBank }) {
+        if (auto iter = m_entries.find(cachedBank);
+            iter != m_entries.end()) {
+            Invalidate(iter->second, address, end);
+            if (iter->second.empty()) { m_entries.erase(iter); }
+        }
+        if (writtenBank == AnyBank) { break; }
+    }
+}
+
+void InstructionCache::Clear() {
+    m_entries.clear();
+    m_lowestAddress = std::numeric_limits<unsigned int>::max();
+    m_highestEnd = 0;
+    m_maxLength = 0;
+}
+
+bool InstructionCache::IsReadOnly(unsigned int address, unsigned int end) const {
+    return std::ranges::any_of(m_readOnlyRegions, [address, end](const Region& region) { return region.start <= address && end <= region.end; });
+}
+
+void InstructionCache::Invalidate(std::map<unsigned int, DecodedInstruction>& entries, unsigned int address, unsigned int end) const {
+    // An instruction starting up to the longest cached length before the write can still cover it.
+    const auto firstStart = address >= m_maxLength ? address - m_maxLength + 1 : 0u;
+    for (auto iter = entries.lower_bound(firstStart); iter != entries.end() && iter->first < end;) {
+        if (address < EndAddress(iter->first, iter->second.length)) {
+            iter = entries.erase(iter);
+        }
+        else {
+            ++iter;
+        }
+    }
+}
+
+}
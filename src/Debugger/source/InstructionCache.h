@@ -0,0 +1,61 @@
+#pragma once
+
+#include "DebuggerCommon.h"
+
+#include <cstddef>
+#include <limits>
+#include <map>
+#include <vector>
+
+namespace Rdb {
+
+// Decoded instructions keyed by address for each bank, reused by listings until the memory under them is written.
+// Addresses are cached under the bank the emulator last reported as mapped there, AnyBank when none was reported.
+// Read only memory is always cached, other memory only once the emulator has reported a write so invalidation can be relied on.
+class InstructionCache {
+public:
+    // 'bank' is now mapped over [startAddress, endAddress], replacing any bank mapped over part of that range.
+    void MapBank(BankNum bank, unsigned int startAddress, unsigned int endAddress);
+    // Writes to read only memory (ROM) never invalidate it, on many systems these are mapper register writes.
+    void SetReadOnly(unsigned int startAddress, unsigned int endAddress);
+
+    [[nodiscard]] BankNum BankAt(unsigned int address) const;
+    // Calls 'func(bank, startAddress, endAddress)' for every bank mapping still in place, in the order they were mapped.
+    template<typename Func>
+    void ForEachMappedBank(Func&& func) const {
+        for (const auto& region : m_bankRegions) {
+            func(region.bank, region.start, region.end - 1);
+        }
+    }
+    [[nodiscard]] const DecodedInstruction* Find(BankNum bank, unsigned int address) const;
+    // Does nothing when the instruction isn't cacheable.
+    void Insert(BankNum bank, unsigned int address, const DecodedInstruction& instruction);
+
+    // Drops every instruction overlapping [address, address + size) in 'bank', AnyBank drops them in the currently mapped bank.
+    void Invalidate(BankNum bank, unsigned int address, size_t size);
+    void Clear();
+
+    [[nodiscard]] bool Empty() const { return m_entries.empty(); }
+
+private:
+    struct Region {
+        unsigned int start;
+        unsigned int end; // Note: This goes 1 past the end.
+        BankNum bank;
+    };
+
+    [[nodiscard]] bool IsReadOnly(unsigned int address, unsigned int end) const;
+    void Invalidate(std::map<unsigned int, DecodedInstruction>& entries, unsigned int address, unsigned int end) const;
+
+    std::vector<Region> m_bankRegions = {};
+    std::vector<Region> m_readOnlyRegions = {};
+    std::map<BankNum, std::map<unsigned int, DecodedInstruction>> m_entries = {};
+
+    // Bounds of everything cached so writes elsewhere return after one compare.
+    unsigned int m_lowestAddress = std::numeric_limits<unsigned int>::max();
+    unsigned int m_highestEnd = 0;
+    unsigned int m_maxLength = 0;
+    bool m_writesReported = false;
+};
+
+}
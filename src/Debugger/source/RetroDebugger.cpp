@@ -38,26 +38,72 @@ std::string RetroDebugger::GetCommandResponse() const {
 }
 
 int RetroDebugger::ProcessCommandString(const std::string& message) {
+    m_callbacks->InvalidateRegisterSnapshot(); // The emulator may have run since the last instruction boundary.
     return (m_console.AdvanceDebugger(message)) ? 1 : 0; // TODO: move to enum, (1: leave debugger, 0: continue looping on input)
 }
 
+bool RetroDebugger::PostCommand(std::string message) {
+    m_commandChannelUsed.store(true, std::memory_order_relaxed);
+    return m_commands.TryPush(std::move(message));
+}
+
+int RetroDebugger::ProcessPendingCommands() {
+    // Commands wait while the response queue is full so no response is lost.
+    while (!m_responses.Full()) {
+        auto message = m_commands.TryPop();
+        if (!message) { break; }
+
+        m_console.SetCommandResponse({}); // Commands without output don't set one, don't resend the last.
+        const auto result = ProcessCommandString(*message);
+        if (auto response = GetCommandResponse();
+            !response.empty()) {
+            m_responses.TryPush(std::move(response));
+        }
+        // Anything queued behind a command that resumes running waits for the next instruction boundary.
+        if (result != 0) { return result; }
+    }
+    return 0;
+}
+
+bool RetroDebugger::PollCommandResponse(std::string& response) {
+    if (auto message = m_responses.TryPop()) {
+        response = std::move(*message);
+        return true;
+    }
+    return false;
+}
+
 // Direct debugger calls
 bool RetroDebugger::CheckBreakpoints(BreakInfo* breakInfo) {
     BreakInfo info = {};
     BreakInfo& infoRef = (breakInfo == nullptr) ? info : *breakInfo;
+    m_callbacks->InvalidateRegisterSnapshot();
 
     const auto hitBreakpoint = m_debugger->CheckBreakpoints(infoRef);
     if (hitBreakpoint) {
+        std::string message;
         if (infoRef.type == BreakType::Breakpoint) {
-            m_console.SetCommandResponse(DebuggerPrintFormat::PrintBreakpointHit(infoRef));
+            message = DebuggerPrintFormat::PrintBreakpointHit(infoRef);
         }
         else if (infoRef.type == BreakType::Watchpoint) {
-            m_console.SetCommandResponse(DebuggerPrintFormat::PrintWatchpointHit(infoRef));
+            message = DebuggerPrintFormat::PrintWatchpointHit(infoRef);
         }
+        if (message.empty()) { return hitBreakpoint; } // A step or finish stopping has nothing to report.
+
+        // Dropped if the UI isn't keeping up.
+        if (m_commandChannelUsed.load(std::memory_order_relaxed)) {
+            m_responses.TryPush(message);
+        }
+        m_console.SetCommandResponse(std::move(message));
     }
     return hitBreakpoint;
 }
 
+bool RetroDebugger::CheckBreakpoints(BreakInfo* breakInfo, MemoryAccessBuffer& accesses) {
+    m_debugger->MemoryAccessHook(accesses);
+    return CheckBreakpoints(breakInfo);
+}
+
 bool RetroDebugger::Run(const unsigned int numBreakpointsToSkip) {
     return m_debugger->Run(numBreakpointsToSkip);
 }
@@ -124,7 +170,15 @@ BreakInfo RetroDebugger::GetBreakpointInfo(const unsigned int breakPointNum) {
     auto breakInfo = m_debugger->GetBreakpointInfoList({ breakPointNum });
 
     static constexpr auto maxUInt = std::numeric_limits<unsigned int>::max();
-    const BreakInfo invalidBreakpoint = { maxUInt, BreakNum{ maxUInt }, BankNum{ maxUInt }, maxUInt, 0, 0, BreakType::Invalid, BreakDisposition::Disable, false };
+    const BreakInfo invalidBreakpoint = {
+        .address = maxUInt,
+        .breakpointNumber = BreakNum{ maxUInt },
+        .bankNumber = BankNum{ maxUInt },
+        .timesHit = maxUInt,
+        .type = BreakType::Invalid,
+        .disp = BreakDisposition::Disable,
+        .isEnabled = false,
+    };
     return breakInfo.find(BreakNum{ breakPointNum }) != breakInfo.end() ? breakInfo.at(BreakNum{ breakPointNum }) : invalidBreakpoint;
 }
 
@@ -137,13 +191,18 @@ bool RetroDebugger::GetRegisterInfo(std::vector<RegisterInfoPtr>* registerInfo)
     return false;
 }
 
-void RetroDebugger::ParseXmlFile(const std::string& filename) {
+void RetroDebugger::ParseXmlFile(const std::string& filename, bool useBinaryCache) {
     m_debugger->ResetOperations();
     DebuggerXmlParser xmlParser;
-    xmlParser.ParseFile(filename);
+    xmlParser.ParseFile(filename, useBinaryCache);
     m_debugger->SetOperations(xmlParser.GetOperations());
 }
 
+void RetroDebugger::SetOperations(StaticOperationsTables operations) {
+    m_debugger->ResetOperations();
+    m_debugger->SetOperations(operations);
+}
+
 // Set Callbacks
 void RetroDebugger::SetGetPcRegCallback(GetProgramCounterFunc getPc_cb) {
     m_callbacks->SetGetPcRegCallback(std::move(getPc_cb));
@@ -162,17 +221,49 @@ void RetroDebugger::SetReadBankableMemoryCallback(ReadBankableMemoryFunc readBan
     m_callbacks->SetReadBankableMemoryCallback(std::move(readBankMemory_cb));
 }
 
+void RetroDebugger::SetReadMemoryBlockCallback(ReadMemoryBlockFunc readMemoryBlock_cb) {
+    m_callbacks->SetReadMemoryBlockCallback(std::move(readMemoryBlock_cb));
+}
+
 
 void RetroDebugger::SetGetRegSetCallback(GetRegSetFunc getRegSet_cb) {
     m_callbacks->SetGetRegSetCallback(std::move(getRegSet_cb));
 }
 
-void RetroDebugger::ReadMemoryHook(BankNum bankNum, unsigned int address, const std::vector<std::byte>& bytes) {
-    m_debugger->ReadMemoryHook(bankNum, address, bytes);
+void RetroDebugger::SetRegisterFile(const RegisterFile& registers, ReadRegisterFunc readRegister_cb) {
+    m_callbacks->SetRegisterFile(registers, std::move(readRegister_cb));
+}
+
+void RetroDebugger::SetRegisterFile(const RegisterFile& registers, const void* registerStruct) {
+    m_callbacks->SetRegisterFile(registers, registerStruct);
 }
 
-void RetroDebugger::WriteMemoryHook(BankNum bankNum, unsigned int address, const std::vector<std::byte>& bytes) {
+void RetroDebugger::SetReadOnlyMemory(unsigned int startAddress, unsigned int endAddress) {
+    m_debugger->SetReadOnlyMemory(startAddress, endAddress);
+}
+
+void RetroDebugger::ReadMemoryHook(BankNum bankNum, unsigned int address, std::span<const std::byte> bytes) {
     m_debugger->ReadMemoryHook(bankNum, address, bytes);
 }
 
+void RetroDebugger::WriteMemoryHook(BankNum bankNum, unsigned int address, std::span<const std::byte> bytes) {
+    m_debugger->WriteMemoryHook(bankNum, address, bytes);
+}
+
+void RetroDebugger::ReadMemoryHook(BankNum bankNum, unsigned int address, unsigned int value, unsigned int width) {
+    m_debugger->ReadMemoryHook(bankNum, address, value, width);
+}
+
+void RetroDebugger::WriteMemoryHook(BankNum bankNum, unsigned int address, unsigned int value, unsigned int width) {
+    m_debugger->WriteMemoryHook(bankNum, address, value, width);
+}
+
+void RetroDebugger::MemoryAccessHook(MemoryAccessBuffer& accesses) {
+    m_debugger->MemoryAccessHook(accesses);
+}
+
+void RetroDebugger::BankSwitchHook(BankNum bankNum, unsigned int startAddress, unsigned int endAddress) {
+    m_debugger->BankSwitchHook(bankNum, startAddress, endAddress);
+}
+
 }
\ No newline at end of file
@@ -1,6 +1,9 @@
 #include "ConsoleInterpreter.h"
 #include "Debugger.h"
 #include "DebuggerCallbacks.h"
+#include "SpscQueue.h"
+
+#include <atomic>
 
 namespace Rdb {
 
@@ -14,8 +17,18 @@ public:
 
     int ProcessCommandString(const std::string& message);
 
+    // Command channel, lets a UI thread drive the debugger while the emulator thread keeps running.
+    // PostCommand and PollCommandResponse are called from the UI thread, ProcessPendingCommands from the emulator thread.
+    bool PostCommand(std::string message);
+
+    int ProcessPendingCommands();
+
+    bool PollCommandResponse(std::string& response);
+
     bool CheckBreakpoints(BreakInfo* breakInfo);
 
+    bool CheckBreakpoints(BreakInfo* breakInfo, MemoryAccessBuffer& accesses);
+
     bool Run(unsigned int numBreakpointsToSkip);
 
     bool RunInstructions(unsigned int numBreakToPass);
@@ -48,7 +61,9 @@ public:
 
     bool GetRegisterInfo(std::vector<RegisterInfoPtr>* registerInfo);
 
-    void ParseXmlFile(const std::string& filename);
+    void ParseXmlFile(const std::string& filename, bool useBinaryCache = false);
+    // Installs tables generated at build time, replaces any operations set before.
+    void SetOperations(StaticOperationsTables operations);
 
     // Callbacks
     void SetGetPcRegCallback(GetProgramCounterFunc getPc_cb);
@@ -59,17 +74,38 @@ public:
 
     void SetReadBankableMemoryCallback(ReadBankableMemoryFunc readBankMemory_cb);
 
+    void SetReadMemoryBlockCallback(ReadMemoryBlockFunc readMemoryBlock_cb);
+
     void SetGetRegSetCallback(GetRegSetFunc getRegSet_cb);
 
+    void SetRegisterFile(const RegisterFile& registers, ReadRegisterFunc readRegister_cb);
+
+    void SetRegisterFile(const RegisterFile& registers, const void* registerStruct);
+
+    void SetReadOnlyMemory(unsigned int startAddress, unsigned int endAddress);
+
     // Hooks
-    void ReadMemoryHook(BankNum bankNum, unsigned int address, const std::vector<std::byte>& bytes);
+    void ReadMemoryHook(BankNum bankNum, unsigned int address, std::span<const std::byte> bytes);
+
+    void WriteMemoryHook(BankNum bankNum, unsigned int address, std::span<const std::byte> bytes);
+
+    void ReadMemoryHook(BankNum bankNum, unsigned int address, unsigned int value, unsigned int width);
 
-    void WriteMemoryHook(BankNum bankNum, unsigned int address, const std::vector<std::byte>& bytes);
+    void WriteMemoryHook(BankNum bankNum, unsigned int address, unsigned int value, unsigned int width);
+
+    void MemoryAccessHook(MemoryAccessBuffer& accesses);
+
+    void BankSwitchHook(BankNum bankNum, unsigned int startAddress, unsigned int endAddress);
 
 private:
     std::shared_ptr<DebuggerCallbacks> m_callbacks = std::make_shared<DebuggerCallbacks>();
     std::shared_ptr<Debugger> m_debugger = std::make_shared<Debugger>(m_callbacks);
     ConsoleInterpreter m_console{ m_debugger, m_callbacks };
+
+    static constexpr size_t CommandQueueSize = 64;
+    SpscQueue<std::string, CommandQueueSize> m_commands = {};
+    SpscQueue<std::string, CommandQueueSize> m_responses = {};
+    std::atomic<bool> m_commandChannelUsed = false; // Once set, break messages are also sent as responses.
 };
 
 }
\ No newline at end of file
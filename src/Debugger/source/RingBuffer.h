@@ -0,0 +1,57 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace Rdb {
+
+// The most recent values in memory allocated up front, appending overwrites the oldest value once full.
+template<typename ValueType>
+class RingBuffer {
+public:
+    RingBuffer() = default;
+    explicit RingBuffer(size_t capacity) :
+        m_values(capacity) {}
+
+    // Drops every value.
+    void Reset(size_t capacity) {
+        m_values.assign(capacity, {});
+        Clear();
+    }
+    void Clear() {
+        m_next = 0;
+        m_size = 0;
+    }
+
+    // The slot for the next value, to be filled in place. Needs a capacity above 0.
+    ValueType& Append() {
+        auto& value = m_values[m_next];
+        m_next = m_next + 1 == m_values.size() ? 0 : m_next + 1;
+        m_size += m_size < m_values.size() ? 1 : 0;
+        return value;
+    }
+
+    [[nodiscard]] size_t Size() const { return m_size; }
+    [[nodiscard]] size_t Capacity() const { return m_values.size(); }
+    // Up to 'count' of the newest values, oldest first.
+    [[nodiscard]] std::vector<ValueType> Last(size_t count) const {
+        count = std::min(count, m_size);
+        std::vector<ValueType> values;
+        values.reserve(count);
+        // m_next is one past the newest value, wrapping round to the oldest.
+        auto index = (m_next + m_values.size() - count) % std::max<size_t>(m_values.size(), 1);
+        for (size_t i = 0; i < count; ++i) {
+            values.push_back(m_values[index]);
+            index = index + 1 == m_values.size() ? 0 : index + 1;
+        }
+        return values;
+    }
+
+private:
+    std::vector<ValueType> m_values = {};
+    size_t m_next = 0; // Slot the next value is written to.
+    size_t m_size = 0;
+};
+
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <optional>
+#include <utility>
+
+namespace Rdb {
+
+// Bounded lock-free queue for exactly one producer thread and one consumer thread.
+// Slots are reused in place, pushing only moves into an existing element.
+template<typename ValueType, size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity != 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of 2.");
+
+public:
+    // Producer side, false when the queue is full.
+    bool TryPush(ValueType value) {
+        const auto tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_cachedHead == Capacity) {
+            m_cachedHead = m_head.load(std::memory_order_acquire);
+            if (tail - m_cachedHead == Capacity) { return false; }
+        }
+        m_slots[tail & Mask] = std::move(value);
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side, empty when there is nothing to pop.
+    std::optional<ValueType> TryPop() {
+        const auto head = m_head.load(std::memory_order_relaxed);
+        if (head == m_cachedTail) {
+            m_cachedTail = m_tail.load(std::memory_order_acquire);
+            if (head == m_cachedTail) { return std::nullopt; }
+        }
+        auto value = std::move(m_slots[head & Mask]);
+        m_head.store(head + 1, std::memory_order_release);
+        return value;
+    }
+
+    // Either side, a snapshot that may already be stale.
+    [[nodiscard]] bool Empty() const { return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire); }
+    [[nodiscard]] bool Full() const { return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire) == Capacity; }
+
+private:
+    static constexpr size_t Mask = Capacity - 1;
+    // Keeps the producer's and consumer's indices on separate cache lines.
+    static constexpr size_t CacheLineSize = 64;
+
+    std::array<ValueType, Capacity> m_slots = {};
+    // Free running counters, masked when indexing.
+    alignas(CacheLineSize) std::atomic<size_t> m_head = 0;
+    size_t m_cachedTail = 0; // Consumer's last view of m_tail.
+    alignas(CacheLineSize) std::atomic<size_t> m_tail = 0;
+    size_t m_cachedHead = 0; // Producer's last view of m_head.
+};
+
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "RetroDebuggerCommon.h"
+#include "RingBuffer.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace Rdb {
+
+// One executed instruction, padded to 32 bytes so a record never straddles a cache line.
+struct alignas(32) TraceRecord {
+    static constexpr size_t MaxBytes = 4;
+    static constexpr size_t MaxRegisters = 4;
+
+    unsigned int pc = 0;
+    BankNum bank = AnyBank;
+    std::array<std::uint8_t, MaxBytes> bytes = {}; // Opcodes and arguments, longer instructions keep their first bytes.
+    std::uint8_t length = 0; // Bytes used in 'bytes'.
+    std::array<unsigned int, MaxRegisters> registers = {}; // Traced registers, in the order they were selected.
+};
+
+// The most recent records, filled in place by the debugger while tracing.
+using TraceBuffer = RingBuffer<TraceRecord>;
+
+}
@@ -0,0 +1,241 @@
+#include "TraceFile.h"
+
+#include "BinaryIo.h"
+#include "DebuggerError.h"
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <limits>
+#include <streambuf>
+
+namespace {
+static constexpr std::uint8_t LengthMask = 0x07;
+static constexpr std::uint8_t BankChanged = 0x08;
+static constexpr std::uint8_t Jumped = 0x10;
+static constexpr std::uint8_t RegistersChanged = 0x20;
+static constexpr size_t MaxVarintSize = 10;
+static constexpr size_t MaxRecordSize = 1 + MaxVarintSize + MaxVarintSize + Rdb::TraceRecord::MaxBytes + (Rdb::TraceRecord::MaxRegisters * MaxVarintSize);
+
+void PutVarint(std::vector<std::byte>& out, std::uint64_t value) {
+    static constexpr std::uint64_t continuation = 0x80;
+    while (value >= continuation) {
+        out.push_back(static_cast<std::byte>(value | continuation));
+        value >>= 7U;
+    }
+    out.push_back(static_cast<std::byte>(value));
+}
+
+// Differences close to 0 either side encode in few bytes.
+std::uint64_t ZigZag(std::int64_t value) {
+    return (static_cast<std::uint64_t>(value) << 1U) ^ static_cast<std::uint64_t>(value >> 63);
+}
+
+std::int64_t UnZigZag(std::uint64_t value) {
+    return static_cast<std::int64_t>(value >> 1U) ^ -static_cast<std::int64_t>(value & 1U);
+}
+
+std::int64_t Difference(unsigned int value, unsigned int previous) {
+    return static_cast<std::int64_t>(value) - static_cast<std::int64_t>(previous);
+}
+
+unsigned int ApplyDifference(unsigned int previous, std::uint64_t encoded) {
+    return static_cast<unsigned int>(static_cast<std::int64_t>(previous) + UnZigZag(encoded));
+}
+
+bool GetByte(std::streambuf& buffer, std::uint8_t& value) {
+    const auto character = buffer.sbumpc();
+    if (character == std::streambuf::traits_type::eof()) { return false; }
+    value = static_cast<std::uint8_t>(character);
+    return true;
+}
+
+bool GetVarint(std::streambuf& buffer, std::uint64_t& value) {
+    value = 0;
+    for (unsigned int shift = 0; shift < MaxVarintSize * 7U; shift += 7U) {
+        std::uint8_t byte = 0;
+        if (!GetByte(buffer, byte)) { return false; }
+        value |= static_cast<std::uint64_t>(byte & 0x7FU) << shift;
+        if ((byte & 0x80U) == 0) { return true; }
+    }
+    return false;
+}
+}
+
+namespace Rdb {
+
+TraceFileWriter::TraceFileWriter(const std::filesystem::path& path, const std::vector<std::string>& registers) :
+    m_registerCount(registers.size()) {
+    // Checked before opening, an existing file is only truncated by a trace that can start.
+    if (registers.size() > TraceRecord::MaxRegisters) {
+        throw DebuggerError(fmt::format("At most {} registers can be traced.", TraceRecord::MaxRegisters));
+    }
+    m_file.open(path, std::ios::binary | std::ios::trunc);
+    if (!m_file) {
+        throw DebuggerError(fmt::format("Can't open trace file '{}'.", path.string()));
+    }
+
+    // Room for a record past BufferSize, so filling a buffer never reallocates it.
+    m_buffer.reserve(BufferSize + MaxRecordSize);
+    m_pending.reserve(BufferSize + MaxRecordSize);
+
+    PutRaw(m_buffer, TraceFile::Magic);
+    PutRaw(m_buffer, TraceFile::Version);
+    PutRaw(m_buffer, static_cast<std::uint8_t>(registers.size()));
+    for (const auto& name : registers) {
+        const auto length = std::min<size_t>(name.size(), std::numeric_limits<std::uint8_t>::max());
+        PutRaw(m_buffer, static_cast<std::uint8_t>(length));
+        const auto* characters = reinterpret_cast<const std::byte*>(name.data()); // NOLINT (cppcoreguidelines-pro-type-reinterpret-cast)
+        m_buffer.insert(m_buffer.end(), characters, characters + length);
+    }
+
+    m_thread = std::jthread([this]() { WriteBuffers(); });
+}
+
+TraceFileWriter::~TraceFileWriter() {
+    Finish();
+}
+
+void TraceFileWriter::Write(const TraceRecord& record) {
+    const auto flagsOffset = m_buffer.size();
+    auto flags = static_cast<std::uint8_t>(record.length & LengthMask);
+    m_buffer.emplace_back();
+
+    if (record.bank != m_delta.bank) {
+        flags |= BankChanged;
+        PutVarint(m_buffer, static_cast<unsigned int>(record.bank));
+        m_delta.bank = record.bank;
+    }
+    if (record.pc != m_delta.nextPc) {
+        flags |= Jumped;
+        PutVarint(m_buffer, ZigZag(Difference(record.pc, m_delta.nextPc)));
+    }
+    for (size_t i = 0; i < record.length; ++i) {
+        m_buffer.push_back(static_cast<std::byte>(record.bytes[i]));
+    }
+    if (!std::equal(record.registers.begin(), record.registers.begin() + static_cast<std::ptrdiff_t>(m_registerCount), m_delta.registers.begin())) {
+        flags |= RegistersChanged;
+        for (size_t i = 0; i < m_registerCount; ++i) {
+            PutVarint(m_buffer, ZigZag(Difference(record.registers[i], m_delta.registers[i])));
+            m_delta.registers[i] = record.registers[i];
+        }
+    }
+
+    m_buffer[flagsOffset] = static_cast<std::byte>(flags);
+    m_delta.nextPc = record.pc + record.length;
+    if (m_buffer.size() >= BufferSize) {
+        Submit();
+    }
+}
+
+void TraceFileWriter::Close() {
+    Finish();
+    if (m_hasFailed) {
+        throw DebuggerError("Failed writing the trace file, it may be incomplete.");
+    }
+}
+
+// Hands the filled buffer to the background thread and carries on in the buffer it last wrote.
+void TraceFileWriter::Submit() {
+    m_state.wait(BufferState::Pending, std::memory_order_acquire);
+    std::swap(m_buffer, m_pending);
+    m_state.store(BufferState::Pending, std::memory_order_release);
+    m_state.notify_all();
+}
+
+void TraceFileWriter::Finish() {
+    if (m_isClosed) { return; }
+    m_isClosed = true;
+
+    if (!m_buffer.empty()) {
+        Submit();
+    }
+    m_state.wait(BufferState::Pending, std::memory_order_acquire);
+    m_state.store(BufferState::Stopping, std::memory_order_release);
+    m_state.notify_all();
+    m_thread.join();
+
+    m_file.close();
+    if (m_file.fail()) { m_hasFailed = true; }
+}
+
+void TraceFileWriter::WriteBuffers() {
+    while (true) {
+        m_state.wait(BufferState::Idle, std::memory_order_acquire);
+        if (m_state.load(std::memory_order_acquire) == BufferState::Stopping) { return; }
+
+        if (!m_file.write(reinterpret_cast<const char*>(m_pending.data()), static_cast<std::streamsize>(m_pending.size()))) { // NOLINT (cppcoreguidelines-pro-type-reinterpret-cast)
+            m_hasFailed = true;
+        }
+        m_pending.clear();
+        m_state.store(BufferState::Idle, std::memory_order_release);
+        m_state.notify_all();
+    }
+}
+
+TraceFileReader::TraceFileReader(const std::filesystem::path& path) :
+    m_file(path, std::ios::binary) {
+    if (!m_file) {
+        throw DebuggerError(fmt::format("Can't open trace file '{}'.", path.string()));
+    }
+
+    auto& buffer = *m_file.rdbuf();
+    std::uint32_t magic = 0;
+    std::uint32_t version = 0;
+    std::uint8_t registerCount = 0;
+    if (!GetRaw(buffer, magic) || magic != TraceFile::Magic || !GetRaw(buffer, version) || version != TraceFile::Version ||
+        !GetByte(buffer, registerCount) || registerCount > TraceRecord::MaxRegisters) {
+        throw DebuggerError(fmt::format("'{}' isn't a version {} trace file.", path.string(), TraceFile::Version));
+    }
+
+    for (auto i = 0U; i < registerCount; ++i) {
+        std::uint8_t length = 0;
+        auto& name = m_registers.emplace_back();
+        if (!GetByte(buffer, length)) { throw DebuggerError(fmt::format("'{}' is truncated.", path.string())); }
+        name.resize(length);
+        if (buffer.sgetn(name.data(), length) != length) { throw DebuggerError(fmt::format("'{}' is truncated.", path.string())); }
+    }
+}
+
+std::optional<TraceRecord> TraceFileReader::Next() {
+    auto& buffer = *m_file.rdbuf();
+    std::uint8_t flags = 0;
+    if (!GetByte(buffer, flags)) { return std::nullopt; }
+
+    // Only kept once the whole record has been read.
+    auto state = m_state;
+    TraceRecord record;
+    record.length = flags & LengthMask;
+    if (record.length > TraceRecord::MaxBytes) { return std::nullopt; }
+
+    std::uint64_t value = 0;
+    if ((flags & BankChanged) != 0) {
+        if (!GetVarint(buffer, value)) { return std::nullopt; }
+        state.bank = BankNum{ static_cast<unsigned int>(value) };
+    }
+    record.bank = state.bank;
+
+    record.pc = state.nextPc;
+    if ((flags & Jumped) != 0) {
+        if (!GetVarint(buffer, value)) { return std::nullopt; }
+        record.pc = ApplyDifference(state.nextPc, value);
+    }
+
+    for (size_t i = 0; i < record.length; ++i) {
+        if (!GetByte(buffer, record.bytes[i])) { return std::nullopt; }
+    }
+
+    if ((flags & RegistersChanged) != 0) {
+        for (size_t i = 0; i < m_registers.size(); ++i) {
+            if (!GetVarint(buffer, value)) { return std::nullopt; }
+            state.registers[i] = ApplyDifference(state.registers[i], value);
+        }
+    }
+    record.registers = state.registers;
+
+    state.nextPc = record.pc + record.length;
+    m_state = state;
+    return record;
+}
+
+}
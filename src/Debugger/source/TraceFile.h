@@ -0,0 +1,95 @@
+#pragma once
+
+#include "TraceBuffer.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Rdb {
+
+// Binary trace files, a stream of TraceRecords that can run for hours.
+//
+// Header: "RDBT", a 32-bit version, a register count byte, then each register name as a length byte and its characters.
+// Each record starts with a byte of flags, followed only by the fields that changed since the record before it:
+//   bits 0-2  instruction length, the instruction bytes close the record
+//   bit 3     bank changed, the new bank follows as a varint
+//   bit 4     jumped, the PC follows as a zigzag varint relative to the end of the previous instruction
+//   bit 5     registers changed, a zigzag varint difference follows for every register
+// Sequential code with unchanged registers costs one byte per record plus its instruction bytes.
+namespace TraceFile {
+static constexpr std::uint32_t Magic = 0x54424452; // "RDBT"
+static constexpr std::uint32_t Version = 1;
+
+// Values the next record is encoded against, shared by the writer and the reader.
+struct DeltaState {
+    unsigned int nextPc = 0;
+    BankNum bank = AnyBank;
+    std::array<unsigned int, TraceRecord::MaxRegisters> registers = {};
+};
+}
+
+// Writes records into one buffer while a background thread writes the other buffer to disk in large sequential writes.
+// Write only waits when the disk falls a whole buffer behind, records are never dropped.
+class TraceFileWriter {
+public:
+    static constexpr size_t BufferSize = size_t{ 1 } << 20;
+
+    // 'registers' names the registers recorded in each TraceRecord, in order.
+    TraceFileWriter(const std::filesystem::path& path, const std::vector<std::string>& registers);
+    TraceFileWriter(const TraceFileWriter&) = delete;
+    TraceFileWriter& operator=(const TraceFileWriter&) = delete;
+    // Flushes like Close, but can't report a failed write.
+    ~TraceFileWriter();
+
+    void Write(const TraceRecord& record);
+    // Writes out the remaining records, throws DebuggerError if any write to the file failed.
+    void Close();
+
+private:
+    // Who owns m_pending, the background thread only writes while it's Pending.
+    enum class BufferState {
+        Idle,
+        Pending,
+        Stopping,
+    };
+
+    void Submit();
+    void Finish();
+    void WriteBuffers();
+
+    std::ofstream m_file;
+    size_t m_registerCount;
+    TraceFile::DeltaState m_delta = {};
+    std::vector<std::byte> m_buffer = {}; // Filled by Write.
+
+    std::vector<std::byte> m_pending = {};
+    std::atomic<BufferState> m_state = BufferState::Idle;
+    std::atomic<bool> m_hasFailed = false;
+    bool m_isClosed = false;
+    std::jthread m_thread; // Last, so it stops before the members it uses are destroyed.
+};
+
+class TraceFileReader {
+public:
+    // Throws DebuggerError when the file can't be opened or isn't a trace file.
+    explicit TraceFileReader(const std::filesystem::path& path);
+
+    [[nodiscard]] const std::vector<std::string>& Registers() const { return m_registers; }
+    // Empty at the end of the file, including a last record cut short while it was being written.
+    std::optional<TraceRecord> Next();
+
+private:
+    std::ifstream m_file;
+    std::vector<std::string> m_registers = {};
+    TraceFile::DeltaState m_state = {};
+};
+
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "RetroDebuggerCommon.h"
+#include "RingBuffer.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace Rdb {
+
+// One tracepoint hit, raw values only. They're formatted when the log is read, using the tracepoint's expressions.
+struct TracepointHit {
+    static constexpr size_t MaxValues = 4;
+
+    BreakNum breakpointNumber = BreakNum{ 0 };
+    unsigned int pc = 0;
+    std::array<int, MaxValues> values = {}; // In the order of the tracepoint's expressions.
+    std::uint8_t count = 0; // Values used in 'values'.
+    std::uint8_t errors = 0; // Bit i is set when value i failed to evaluate, such as dividing by 0.
+};
+
+// The most recent hits, older hits are overwritten once full.
+using TracepointLog = RingBuffer<TracepointHit>;
+
+}
@@ -0,0 +1,111 @@
+#include "WatchpointIndex.h"
+
+#include <algorithm>
+#include <limits>
+#include <ranges>
+
+namespace {
+unsigned int EndAddress(unsigned int address, size_t size) {
+    // Clamp so a range at the top of the address space doesn't wrap.
+    const auto end = static_cast<unsigned long long>(address) + size;
+    return static_cast<unsigned int>(std::min<unsigned long long>(end, std::numeric_limits<unsigned int>::max()));
+}
+}
+
+namespace Rdb {
+
+void WatchpointIndex::Insert(BreakInfo& breakInfo) {
+    const auto start = breakInfo.address;
+    const auto end = EndAddress(breakInfo.address, breakInfo.length);
+    auto& bank = m_intervals[breakInfo.bankNumber];
+
+    const auto iter = std::ranges::find(bank.intervals, &breakInfo, &Interval::breakInfo);
+    if (iter != bank.intervals.end()) { return; }
+
+    const auto position = std::ranges::upper_bound(bank.intervals, start, {}, &Interval::start);
+    bank.intervals.insert(position, Interval{ start, end, &breakInfo });
+    bank.maxLength = std::max(bank.maxLength, end - start);
+
+    UpdatePages(start, end, true);
+}
+
+void WatchpointIndex::Erase(const BreakInfo& breakInfo) {
+    auto bankIter = m_intervals.find(breakInfo.bankNumber);
+    if (bankIter == m_intervals.end()) { return; }
+
+    auto& bank = bankIter->second;
+    const auto iter = std::ranges::find(bank.intervals, &breakInfo, &Interval::breakInfo);
+    if (iter == bank.intervals.end()) { return; }
+
+    UpdatePages(iter->start, iter->end, false);
+    bank.intervals.erase(iter);
+
+    if (bank.intervals.empty()) {
+        m_intervals.erase(bankIter);
+    }
+    else {
+        bank.maxLength = std::ranges::max(bank.intervals | std::views::transform([](const Interval& interval) { return interval.end - interval.start; }));
+    }
+}
+
+void WatchpointIndex::Clear() {
+    m_pageRefs.fill(0);
+    m_highIntervals = 0;
+    m_intervals.clear();
+}
+
+void WatchpointIndex::MarkHits(BankNum bankNum, unsigned int address, size_t size) {
+    if (size == 0) { return; }
+
+    const auto end = EndAddress(address, size);
+    if (!MayContain(address, end)) { return; }
+
+    // Watchpoints without a bank are hit from any bank, banked watchpoints only from their own.
+    if (auto iter = m_intervals.find(AnyBank);
+        iter != m_intervals.end()) {
+        MarkHits(iter->second, address, end);
+    }
+    if (bankNum != AnyBank) {
+        if (auto iter = m_intervals.find(bankNum);
+            iter != m_intervals.end()) {
+            MarkHits(iter->second, address, end);
+        }
+    }
+}
+
+void WatchpointIndex::UpdatePages(unsigned int start, unsigned int end, bool isInsert) {
+    const auto update = [isInsert](unsigned int& count) { isInsert ? ++count : --count; };
+    if (end > (DensePageCount << PageShift)) {
+        update(m_highIntervals);
+    }
+
+    const auto lastPage = std::min((end - 1) >> PageShift, DensePageCount - 1);
+    for (auto page = start >> PageShift; page <= lastPage; ++page) {
+        update(m_pageRefs[page]);
+    }
+}
+
+bool WatchpointIndex::MayContain(unsigned int address, unsigned int end) const {
+    if (m_highIntervals != 0) { return true; }
+
+    const auto lastPage = std::min((end - 1) >> PageShift, DensePageCount - 1);
+    for (auto page = address >> PageShift; page <= lastPage; ++page) {
+        if (m_pageRefs[page] != 0) { return true; }
+    }
+    return false;
+}
+
+void WatchpointIndex::MarkHits(BankIntervals& bank, unsigned int address, unsigned int end) {
+    // Intervals are sorted by start, anything starting more than the longest interval before the access can't overlap it.
+    const auto firstStart = address > bank.maxLength ? address - bank.maxLength : 0u;
+    for (auto iter = std::ranges::lower_bound(bank.intervals, firstStart, {}, &Interval::start);
+         iter != bank.intervals.end() && iter->start < end;
+         ++iter) {
+        if (address < iter->end && !iter->breakInfo->externalHit) {
+            iter->breakInfo->externalHit = true;
+            iter->breakInfo->watchAddress = std::max(address, iter->start);
+        }
+    }
+}
+
+}
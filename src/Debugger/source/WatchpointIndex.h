@@ -0,0 +1,49 @@
+#pragma once
+
+#include "RetroDebuggerCommon.h"
+
+#include <array>
+#include <cstddef>
+#include <map>
+#include <vector>
+
+namespace Rdb {
+
+// Watched address ranges for the memory hooks, one interval per watchpoint sorted by start address for each bank.
+// Pages in the first 64K are reference counted so an access that touches no watched page returns after one lookup.
+class WatchpointIndex {
+public:
+    void Insert(BreakInfo& breakInfo);
+    void Erase(const BreakInfo& breakInfo);
+    void Clear();
+
+    // Sets 'externalHit' on every watchpoint overlapping [address, address + size). The first watched address accessed
+    // since the watchpoint was last checked is kept in its 'watchAddress'.
+    void MarkHits(BankNum bankNum, unsigned int address, size_t size);
+
+    [[nodiscard]] bool Empty() const { return m_intervals.empty(); }
+
+private:
+    struct Interval {
+        unsigned int start;
+        unsigned int end; // Note: This goes 1 past the end.
+        BreakInfo* breakInfo;
+    };
+    struct BankIntervals {
+        std::vector<Interval> intervals = {};
+        unsigned int maxLength = 0;
+    };
+
+    static constexpr unsigned int PageShift = 8u;
+    static constexpr unsigned int DensePageCount = 0x10000u >> PageShift;
+
+    void UpdatePages(unsigned int start, unsigned int end, bool isInsert);
+    [[nodiscard]] bool MayContain(unsigned int address, unsigned int end) const;
+    static void MarkHits(BankIntervals& bank, unsigned int address, unsigned int end);
+
+    std::array<unsigned int, DensePageCount> m_pageRefs = {};
+    unsigned int m_highIntervals = 0; // Intervals reaching past the paged range, these are always searched.
+    std::map<BankNum, BankIntervals> m_intervals = {};
+};
+
+}
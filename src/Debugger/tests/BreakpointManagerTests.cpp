@@ -1,11 +1,19 @@
 #include "BreakpointManager.h"
 #include "DebuggerCallbacks.h"
+#include "DebuggerError.h"
+#include "DebuggerOperations.h"
+#include "DebuggerXmlParser.h"
+#include "RetroDebuggerTests_assets.h"
 
 #include "MockDebuggerCallbacks.h"
 
 #include <gtest/gtest.h>
 
 #include <algorithm>
+#include <array>
+#include <iterator>
+#include <span>
+#include <vector>
 
 /******************************************************************************
  * TODOs
@@ -113,6 +121,98 @@ TEST_F(BreakpointManagerTests, CheckBreakpoints_HitBreakpoint) {
     EXPECT_TRUE(m_breakpointManager.CheckBreakpoints(breakInfo));
 }
 
+TEST_F(BreakpointManagerTests, CheckBreakpoints_SameAddress_LowestEnabledNumberHits) {
+    static constexpr auto address = 0x100;
+    m_pc = address;
+    const auto breakNum1 = m_breakpointManager.SetBreakpoint(address);
+    const auto breakNum2 = m_breakpointManager.SetBreakpoint(address);
+    const auto breakNum3 = m_breakpointManager.SetBreakpoint(0x10000 + address); // Outside the 16-bit range
+
+    BreakInfo breakInfo;
+    EXPECT_TRUE(m_breakpointManager.CheckBreakpoints(breakInfo));
+    EXPECT_EQ(breakInfo.breakpointNumber, breakNum1);
+
+    m_breakpointManager.DisableBreakpoints({ breakNum1 });
+    EXPECT_TRUE(m_breakpointManager.CheckBreakpoints(breakInfo));
+    EXPECT_EQ(breakInfo.breakpointNumber, breakNum2);
+
+    m_breakpointManager.DeleteBreakpoints({ breakNum2 });
+    EXPECT_FALSE(m_breakpointManager.CheckBreakpoints(breakInfo));
+
+    m_pc = 0x10000 + address;
+    EXPECT_TRUE(m_breakpointManager.CheckBreakpoints(breakInfo));
+    EXPECT_EQ(breakInfo.breakpointNumber, breakNum3);
+
+    m_breakpointManager.DeleteBreakpoints();
+    EXPECT_FALSE(m_breakpointManager.CheckBreakpoints(breakInfo));
+}
+
+TEST_F(BreakpointManagerTests, CheckBreakpoints_BankBreakpoint_OnlyHitsWhenBankIsMapped) {
+    static constexpr auto address = 0x4000;
+    static constexpr auto bank = BankNum{ 2 };
+    m_pc = address;
+    bool bankMapped = false;
+    ON_CALL(*m_callbacks, CheckBankableMemoryLocation).WillByDefault([&bankMapped](BankNum bankNum, unsigned int) { return bankMapped && bankNum == bank; });
+
+    const auto breakNum = m_breakpointManager.SetBreakpoint(bank, address);
+
+    BreakInfo breakInfo;
+    EXPECT_FALSE(m_breakpointManager.CheckBreakpoints(breakInfo));
+
+    bankMapped = true;
+    EXPECT_TRUE(m_breakpointManager.CheckBreakpoints(breakInfo));
+    EXPECT_EQ(breakInfo.breakpointNumber, breakNum);
+    EXPECT_EQ(breakInfo.bankNumber, bank);
+
+    m_pc = address + 1u;
+    EXPECT_FALSE(m_breakpointManager.CheckBreakpoints(breakInfo));
+}
+
+TEST_F(BreakpointManagerTests, CheckBreakpoints_BankBreakpoint_OnlyHitsAtItsAddress) {
+    static constexpr auto address = 0x4000;
+    static constexpr auto bank = BankNum{ 2 };
+    ON_CALL(*m_callbacks, CheckBankableMemoryLocation).WillByDefault(Return(true));
+    const auto breakNum = m_breakpointManager.SetBreakpoint(bank, address);
+
+    // The bank being mapped isn't enough, the PC has to be at the breakpoint.
+    BreakInfo breakInfo;
+    m_pc = address + 0x100u;
+    EXPECT_FALSE(m_breakpointManager.CheckBreakpoints(breakInfo));
+
+    m_pc = address;
+    EXPECT_TRUE(m_breakpointManager.CheckBreakpoints(breakInfo));
+    EXPECT_EQ(breakInfo.breakpointNumber, breakNum);
+}
+
+TEST_F(BreakpointManagerTests, CheckBreakpoints_BreakpointsAndWatchpoints_HitInNumberOrder) {
+    static constexpr auto address = 0x4000;
+    static constexpr auto bank = BankNum{ 2 };
+    ON_CALL(*m_callbacks, CheckBankableMemoryLocation).WillByDefault(Return(true));
+    m_pc = address;
+    g_memory = 0;
+    const auto watchNum = m_breakpointManager.SetWatchpoint(0x200);
+    const auto bankedNum = m_breakpointManager.SetBreakpoint(bank, address);
+    const auto unbankedNum = m_breakpointManager.SetBreakpoint(address);
+    const auto laterWatchNum = m_breakpointManager.SetWatchpoint(0x300);
+
+    // Everything hits, the lowest number is reported first.
+    g_memory = 1;
+    BreakInfo breakInfo;
+    EXPECT_TRUE(m_breakpointManager.CheckBreakpoints(breakInfo));
+    EXPECT_EQ(breakInfo.breakpointNumber, watchNum);
+    EXPECT_TRUE(m_breakpointManager.CheckBreakpoints(breakInfo));
+    EXPECT_EQ(breakInfo.breakpointNumber, bankedNum);
+
+    m_breakpointManager.DisableBreakpoints({ bankedNum });
+    EXPECT_TRUE(m_breakpointManager.CheckBreakpoints(breakInfo));
+    EXPECT_EQ(breakInfo.breakpointNumber, unbankedNum);
+
+    m_breakpointManager.DisableBreakpoints({ unbankedNum });
+    EXPECT_TRUE(m_breakpointManager.CheckBreakpoints(breakInfo));
+    EXPECT_EQ(breakInfo.breakpointNumber, laterWatchNum);
+    EXPECT_FALSE(m_breakpointManager.CheckBreakpoints(breakInfo));
+}
+
 TEST_F(BreakpointManagerTests, CheckBreakpoints_Condition) {
     BreakInfo breakInfo;
     static constexpr auto address = 0x100;
@@ -132,6 +232,85 @@ TEST_F(BreakpointManagerTests, CheckBreakpoints_Condition) {
     EXPECT_TRUE(m_breakpointManager.CheckBreakpoints(breakInfo));
 }
 
+TEST_F(BreakpointManagerTests, SetTracepoint_LogsValuesWithoutStopping) {
+    BreakInfo breakInfo;
+    static constexpr auto address = 0x100;
+    EXPECT_CALL(*m_callbacks, FindRegister(std::string("A"))).WillRepeatedly(Return(RegisterId{ 1 }));
+    EXPECT_CALL(*m_callbacks, ReadRegister(RegisterId{ 1 })).WillRepeatedly([this](RegisterId) { return m_pc + 1; });
+    const auto tracepoint = m_breakpointManager.SetTracepoint(address, { "A", "*(0x200) + 1" });
+
+    for (m_pc = address - 1; m_pc <= address + 1; ++m_pc) {
+        g_memory = m_pc;
+        EXPECT_FALSE(m_breakpointManager.CheckBreakpoints(breakInfo));
+    }
+    g_memory = 7;
+    m_pc = address;
+    EXPECT_FALSE(m_breakpointManager.CheckBreakpoints(breakInfo));
+
+    const auto hits = m_breakpointManager.GetTracepointLog().Last(10);
+    ASSERT_EQ(hits.size(), 2U);
+    EXPECT_EQ(hits[0].breakpointNumber, tracepoint);
+    EXPECT_EQ(hits[0].pc, static_cast<unsigned int>(address));
+    ASSERT_EQ(hits[0].count, 2U);
+    EXPECT_EQ(hits[0].values[0], address + 1);
+    EXPECT_EQ(hits[0].values[1], address + 1);
+    EXPECT_EQ(hits[1].values[1], 8);
+    EXPECT_EQ(m_breakpointManager.GetBreakpointInfoList({ tracepoint }).at(tracepoint).timesHit, 2U);
+
+    m_breakpointManager.ClearTracepointLog();
+    EXPECT_EQ(m_breakpointManager.GetTracepointLog().Size(), 0U);
+}
+
+TEST_F(BreakpointManagerTests, SetTracepoint_ConditionAndBreakpointAtSameAddress) {
+    BreakInfo breakInfo;
+    static constexpr auto address = 0x100;
+    m_pc = address;
+    const auto tracepoint = m_breakpointManager.SetTracepoint(address, { "*(0x200)" });
+    m_breakpointManager.SetCondition(tracepoint, "*(0x200) != 0");
+    const auto breakpoint = m_breakpointManager.SetBreakpoint(address);
+
+    // The tracepoint is logged and the breakpoint after it still stops.
+    g_memory = 3;
+    EXPECT_TRUE(m_breakpointManager.CheckBreakpoints(breakInfo));
+    EXPECT_EQ(breakInfo.breakpointNumber, breakpoint);
+    g_memory = 0;
+    EXPECT_TRUE(m_breakpointManager.CheckBreakpoints(breakInfo));
+
+    const auto hits = m_breakpointManager.GetTracepointLog().Last(10);
+    ASSERT_EQ(hits.size(), 1U);
+    EXPECT_EQ(hits[0].values[0], 3);
+
+    m_breakpointManager.DisableBreakpoints({ tracepoint });
+    g_memory = 4;
+    EXPECT_TRUE(m_breakpointManager.CheckBreakpoints(breakInfo));
+    EXPECT_EQ(m_breakpointManager.GetTracepointLog().Size(), 1U);
+}
+
+TEST_F(BreakpointManagerTests, SetTracepoint_DivideByZero_MarksTheValue) {
+    BreakInfo breakInfo;
+    static constexpr auto address = 0x100;
+    m_pc = address;
+    m_breakpointManager.SetTracepoint(address, { "8 / *(0x200)", "*(0x200)" });
+
+    g_memory = 0;
+    EXPECT_FALSE(m_breakpointManager.CheckBreakpoints(breakInfo));
+    g_memory = 2;
+    EXPECT_FALSE(m_breakpointManager.CheckBreakpoints(breakInfo));
+
+    const auto hits = m_breakpointManager.GetTracepointLog().Last(10);
+    ASSERT_EQ(hits.size(), 2U);
+    EXPECT_EQ(hits[0].errors, 0b01U);
+    EXPECT_EQ(hits[0].values[1], 0);
+    EXPECT_EQ(hits[1].errors, 0U);
+    EXPECT_EQ(hits[1].values[0], 4);
+}
+
+TEST_F(BreakpointManagerTests, SetTracepoint_TooManyValues_Throws) {
+    EXPECT_THROW(m_breakpointManager.SetTracepoint(0x100, { "1", "2", "3", "4", "5" }), Rdb::DebuggerError);
+    EXPECT_THROW(m_breakpointManager.SetTracepoint(0x100, { "" }), Rdb::DebuggerError);
+    EXPECT_TRUE(m_breakpointManager.GetBreakpointInfoList().empty());
+}
+
 TEST_F(BreakpointManagerTests, CheckBreakpoints_DisableReEnableBreakpoint) {
     static constexpr auto address1 = 0x100;
 
@@ -280,7 +459,30 @@ TEST_F(BreakpointManagerTests, Debugger_ContinueBreaksOnBreakpoint) {
     EXPECT_EQ(breakInfo.breakpointNumber, breakNum2);
 }
 
-// TEST_F(BreakpointManagerTests, Debugger_FinishStopsOnJumps) {}
+TEST_F(BreakpointManagerTests, Debugger_FinishStopsOnJumps) {
+    static constexpr auto nopOpcode = 0x00;
+    static constexpr auto extendedOpcode = 0xCB;
+    static constexpr auto rlcBOpcode = 0x00;
+    static constexpr auto jumpNzOpcode = 0xC2;
+
+    DebuggerXmlParser parser;
+    parser.ParseFile(std::string(RetroDebuggerTests::Assets::GameboyOperationsDebuggerXml));
+    auto operations = std::make_shared<Rdb::DebuggerOperations>(m_callbacks);
+    operations->SetOperations(parser.GetOperations());
+    Rdb::BreakpointManager breakpointManager{ operations, m_callbacks };
+
+    std::array<unsigned int, 4> memory = { nopOpcode, extendedOpcode, rlcBOpcode, jumpNzOpcode };
+    ON_CALL(*m_callbacks, ReadMemory).WillByDefault([&memory](unsigned int address) { return memory[address % memory.size()]; });
+
+    BreakInfo breakInfo{};
+    breakpointManager.RunTillJump();
+    m_pc = 0;
+    EXPECT_FALSE(breakpointManager.CheckBreakpoints(breakInfo));
+    m_pc = 1; // Extended operations without jumps must not stop the finish.
+    EXPECT_FALSE(breakpointManager.CheckBreakpoints(breakInfo));
+    m_pc = 3;
+    EXPECT_TRUE(breakpointManager.CheckBreakpoints(breakInfo));
+}
 
 TEST_F(BreakpointManagerTests, Debugger_InfoCheckSize) {
     const auto breakNum1 = m_breakpointManager.SetBreakpoint(0x101);
@@ -563,20 +765,328 @@ TEST_F(BreakpointManagerTests, AnyWatchpoint_bugFix_WatchpointAddressIsWithInHit
     ASSERT_FALSE(m_breakpointManager.CheckBreakpoints(breakInfo));
 }
 
+TEST_F(BreakpointManagerTests, AnyWatchpoint_SpanAndScalarHooks_HitWithinAccess) {
+    static constexpr auto expectedAddress = 100u;
+    const auto breakNum = m_breakpointManager.SetAnyWatchpoint(expectedAddress);
+
+    BreakInfo breakInfo{};
+    const std::array<std::byte, 2> memory = { std::byte{ 0x12 }, std::byte{ 0x34 } };
+    m_breakpointManager.WriteMemoryHook(AnyBank, 98u, std::span{ memory });
+    ASSERT_FALSE(m_breakpointManager.CheckBreakpoints(breakInfo));
+    m_breakpointManager.ReadMemoryHook(AnyBank, 99u, std::span{ memory });
+    ASSERT_TRUE(m_breakpointManager.CheckBreakpoints(breakInfo));
+    EXPECT_EQ(breakInfo.breakpointNumber, breakNum);
+
+    // Scalar hooks match on the access width, a 2 byte access at 99 covers 100.
+    m_breakpointManager.ReadMemoryHook(AnyBank, 99u, 0x3412u, 1u);
+    ASSERT_FALSE(m_breakpointManager.CheckBreakpoints(breakInfo));
+    m_breakpointManager.WriteMemoryHook(AnyBank, 99u, 0x3412u, 2u);
+    ASSERT_TRUE(m_breakpointManager.CheckBreakpoints(breakInfo));
+    EXPECT_EQ(breakInfo.breakpointNumber, breakNum);
+}
+
+TEST_F(BreakpointManagerTests, MemoryAccessHook_BatchMatchesByType) {
+    static constexpr auto readAddress = 0x100u;
+    static constexpr auto writeAddress = 0xC000u;
+    const auto readBreakNum = m_breakpointManager.SetReadWatchpoint(readAddress);
+    const auto writeBreakNum = m_breakpointManager.SetWatchpoint(writeAddress, BankNum{ 1 });
+
+    BreakInfo breakInfo{};
+    const std::array<Rdb::MemoryAccess, 3> misses = { {
+        { .address = readAddress, .type = Rdb::MemoryAccessType::Write },
+        { .bank = BankNum{ 2 }, .address = writeAddress, .type = Rdb::MemoryAccessType::Write },
+        { .address = writeAddress, .type = Rdb::MemoryAccessType::Read },
+    } };
+    m_breakpointManager.MemoryAccessHook(misses);
+    ASSERT_FALSE(m_breakpointManager.CheckBreakpoints(breakInfo));
+
+    const std::array<Rdb::MemoryAccess, 2> hits = { {
+        { .address = readAddress - 1u, .width = 2, .type = Rdb::MemoryAccessType::Read },
+        { .bank = BankNum{ 1 }, .address = writeAddress, .type = Rdb::MemoryAccessType::Write },
+    } };
+    m_breakpointManager.MemoryAccessHook(hits);
+    ASSERT_TRUE(m_breakpointManager.CheckBreakpoints(breakInfo));
+    EXPECT_EQ(breakInfo.breakpointNumber, readBreakNum);
+    ASSERT_TRUE(m_breakpointManager.CheckBreakpoints(breakInfo));
+    EXPECT_EQ(breakInfo.breakpointNumber, writeBreakNum);
+    ASSERT_FALSE(m_breakpointManager.CheckBreakpoints(breakInfo));
+}
+
+TEST(MemoryAccessBufferTests, DrainsOldestFirstAcrossWrap) {
+    Rdb::MemoryAccessBuffer buffer{ 3 };
+    ASSERT_EQ(buffer.Capacity(), 4u);
+
+    std::vector<unsigned int> drained;
+    const auto drain = [&drained](std::span<const Rdb::MemoryAccess> accesses) {
+        std::ranges::transform(accesses, std::back_inserter(drained), &Rdb::MemoryAccess::address);
+    };
+
+    EXPECT_TRUE(buffer.PushRead(AnyBank, 1u, 0u));
+    EXPECT_TRUE(buffer.PushWrite(AnyBank, 2u, 0u));
+    EXPECT_TRUE(buffer.PushRead(AnyBank, 3u, 0u));
+    buffer.Drain(drain);
+    EXPECT_TRUE(buffer.Empty());
+
+    // Wraps past the end, a full buffer refuses more.
+    for (auto address = 4u; address < 8u; ++address) {
+        EXPECT_TRUE(buffer.PushWrite(AnyBank, address, 0u));
+    }
+    EXPECT_FALSE(buffer.PushWrite(AnyBank, 8u, 0u));
+    buffer.Drain(drain);
+    EXPECT_EQ(drained, (std::vector<unsigned int>{ 1u, 2u, 3u, 4u, 5u, 6u, 7u }));
+}
+
+TEST_F(BreakpointManagerTests, WatchpointRange_HitsAnywhereInRange) {
+    static constexpr auto startAddress = 0xC0F0u;
+    static constexpr auto endAddress = 0xC20Fu; // Spans several pages
+
+    const auto breakNum = m_breakpointManager.SetWatchpointRange(startAddress, endAddress);
+    auto info = m_breakpointManager.GetBreakpointInfoList({ breakNum });
+    ASSERT_EQ(info.size(), 1U);
+    EXPECT_EQ(info.at(breakNum).address, startAddress);
+    EXPECT_EQ(info.at(breakNum).length, endAddress - startAddress + 1u);
+
+    BreakInfo breakInfo{};
+    const auto value = std::byte{ static_cast<unsigned char>(g_memory) };
+    m_breakpointManager.WriteMemoryHook(AnyBank, startAddress - 1u, { value });
+    ASSERT_FALSE(m_breakpointManager.CheckBreakpoints(breakInfo));
+    m_breakpointManager.WriteMemoryHook(AnyBank, endAddress + 1u, { value });
+    ASSERT_FALSE(m_breakpointManager.CheckBreakpoints(breakInfo));
+
+    for (const auto address : { startAddress, 0xC100u, endAddress }) {
+        m_breakpointManager.WriteMemoryHook(AnyBank, address, { value });
+        ASSERT_TRUE(m_breakpointManager.CheckBreakpoints(breakInfo));
+        EXPECT_EQ(breakInfo.breakpointNumber, breakNum);
+    }
+
+    // Reads don't trigger a write range, an access straddling the start does.
+    m_breakpointManager.ReadMemoryHook(AnyBank, startAddress, { value });
+    ASSERT_FALSE(m_breakpointManager.CheckBreakpoints(breakInfo));
+    m_breakpointManager.WriteMemoryHook(AnyBank, startAddress - 1u, { value, value });
+    ASSERT_TRUE(m_breakpointManager.CheckBreakpoints(breakInfo));
+
+    EXPECT_THROW(m_breakpointManager.SetWatchpointRange(endAddress, startAddress), Rdb::DebuggerError);
+    EXPECT_THROW(m_breakpointManager.SetReadWatchpointRange(endAddress, startAddress), Rdb::DebuggerError);
+    EXPECT_THROW(m_breakpointManager.SetAnyWatchpointRange(endAddress, startAddress), Rdb::DebuggerError);
+
+    // A rejected range doesn't use up a breakpoint number.
+    EXPECT_EQ(m_breakpointManager.SetWatchpointRange(startAddress, endAddress), BreakNum{ static_cast<unsigned int>(breakNum) + 1u });
+}
+
+TEST_F(BreakpointManagerTests, WatchpointRange_ValueChangeAfterFirstAddress_ReportsChangedAddress) {
+    static constexpr auto startAddress = 0x200u;
+    std::array<unsigned int, 4> memory{};
+    ON_CALL(*m_callbacks, ReadMemory).WillByDefault([&memory](unsigned int address) { return memory.at(address - startAddress); });
+
+    const auto breakNum = m_breakpointManager.SetWatchpointRange(startAddress, startAddress + 3u);
+    BreakInfo breakInfo{};
+    ASSERT_FALSE(m_breakpointManager.CheckBreakpoints(breakInfo));
+
+    // Changed without going through the hooks, found by comparing values.
+    memory[2] = 7u;
+    ASSERT_TRUE(m_breakpointManager.CheckBreakpoints(breakInfo));
+    EXPECT_EQ(breakInfo.breakpointNumber, breakNum);
+    EXPECT_EQ(breakInfo.watchAddress, startAddress + 2u);
+    EXPECT_EQ(breakInfo.oldWatchValue, 0u);
+    EXPECT_EQ(breakInfo.currentWatchValue, 7u);
+    ASSERT_FALSE(m_breakpointManager.CheckBreakpoints(breakInfo));
+
+    // The first changed address is reported, one hit takes in the whole change.
+    memory[1] = 3u;
+    memory[3] = 4u;
+    ASSERT_TRUE(m_breakpointManager.CheckBreakpoints(breakInfo));
+    EXPECT_EQ(breakInfo.watchAddress, startAddress + 1u);
+    EXPECT_EQ(breakInfo.currentWatchValue, 3u);
+    ASSERT_FALSE(m_breakpointManager.CheckBreakpoints(breakInfo));
+}
+
+TEST_F(BreakpointManagerTests, WatchpointRange_HookAccess_ComparesOnlyTheAccessedAddress) {
+    static constexpr auto startAddress = 0xC000u;
+    static constexpr auto endAddress = 0xDFFFu;
+    std::vector<unsigned int> memory(endAddress - startAddress + 1u);
+    unsigned int memoryReads = 0;
+    ON_CALL(*m_callbacks, ReadMemory).WillByDefault([&](unsigned int address) { ++memoryReads; return memory.at(address - startAddress); });
+
+    const auto breakNum = m_breakpointManager.SetWatchpointRange(startAddress, endAddress);
+    const auto readBreakNum = m_breakpointManager.SetReadWatchpointRange(startAddress, endAddress);
+    BreakInfo breakInfo{};
+    memory[0x123] = 5u;
+    m_breakpointManager.WriteMemoryHook(AnyBank, startAddress + 0x123u, 5u, 1u);
+    memoryReads = 0;
+    ASSERT_TRUE(m_breakpointManager.CheckBreakpoints(breakInfo));
+    EXPECT_EQ(breakInfo.breakpointNumber, breakNum);
+    EXPECT_EQ(breakInfo.watchAddress, startAddress + 0x123u);
+    EXPECT_EQ(breakInfo.oldWatchValue, 0u);
+    EXPECT_EQ(breakInfo.currentWatchValue, 5u);
+    EXPECT_LT(memoryReads, 4u);
+
+    // Once the hooks report accesses the range isn't polled, a change they didn't report isn't seen.
+    memory[0x200] = 7u;
+    memoryReads = 0;
+    ASSERT_FALSE(m_breakpointManager.CheckBreakpoints(breakInfo));
+    EXPECT_LT(memoryReads, 4u);
+
+    // A read inside the range reports the address read, not the start of the range.
+    m_breakpointManager.ReadMemoryHook(AnyBank, startAddress + 0x1FFu, 0u, 2u);
+    ASSERT_TRUE(m_breakpointManager.CheckBreakpoints(breakInfo));
+    EXPECT_EQ(breakInfo.breakpointNumber, readBreakNum);
+    EXPECT_EQ(breakInfo.watchAddress, startAddress + 0x1FFu);
+}
+
+TEST_F(BreakpointManagerTests, WatchpointRange_DisableAndDeleteStopHooks) {
+    static constexpr auto startAddress = 0x100u;
+    static constexpr auto endAddress = 0x1FFu;
+    const auto breakNum1 = m_breakpointManager.SetReadWatchpointRange(startAddress, endAddress);
+    const auto breakNum2 = m_breakpointManager.SetAnyWatchpointRange(startAddress + 0x10u, startAddress + 0x20u, BankNum{ 1 });
+
+    BreakInfo breakInfo{};
+    const auto value = std::byte{ static_cast<unsigned char>(g_memory) };
+    m_breakpointManager.DisableBreakpoints({ breakNum1 });
+    m_breakpointManager.ReadMemoryHook(AnyBank, startAddress + 0x10u, { value });
+    ASSERT_FALSE(m_breakpointManager.CheckBreakpoints(breakInfo));
+
+    m_breakpointManager.ReadMemoryHook(BankNum{ 1 }, startAddress + 0x10u, { value });
+    ASSERT_TRUE(m_breakpointManager.CheckBreakpoints(breakInfo));
+    EXPECT_EQ(breakInfo.breakpointNumber, breakNum2);
+
+    m_breakpointManager.EnableBreakpoints({ breakNum1 });
+    m_breakpointManager.DeleteBreakpoints({ breakNum2 });
+    m_breakpointManager.ReadMemoryHook(BankNum{ 1 }, startAddress + 0x10u, { value });
+    ASSERT_TRUE(m_breakpointManager.CheckBreakpoints(breakInfo));
+    EXPECT_EQ(breakInfo.breakpointNumber, breakNum1);
+
+    m_breakpointManager.DeleteBreakpoints();
+    m_breakpointManager.ReadMemoryHook(AnyBank, startAddress, { value });
+    ASSERT_FALSE(m_breakpointManager.CheckBreakpoints(breakInfo));
+}
+
 TEST_F(BreakpointManagerTests, Watchpoints_register_HappyPath) {
     static constexpr std::string_view registerA = "RegisterA";
-    RegSet regSet = { { std::string(registerA), 5 } };
-    EXPECT_CALL(*m_callbacks, GetRegSet).Times(2).WillRepeatedly(Return(regSet));
+    static constexpr auto registerAId = RegisterId{ 3 };
+    EXPECT_CALL(*m_callbacks, FindRegister(std::string(registerA))).Times(1).WillRepeatedly(Return(registerAId));
+    EXPECT_CALL(*m_callbacks, GetRegSet).Times(0);
+    EXPECT_CALL(*m_callbacks, ReadRegister(registerAId)).Times(2).WillRepeatedly(Return(5));
 
     m_breakpointManager.SetWatchpoint(std::string(registerA));
     BreakInfo breakInfo{};
     ASSERT_FALSE(m_breakpointManager.CheckBreakpoints(breakInfo));
 
-    regSet[std::string(registerA)] = 6;
-    EXPECT_CALL(*m_callbacks, GetRegSet).Times(1).WillRepeatedly(Return(regSet));
+    EXPECT_CALL(*m_callbacks, ReadRegister(registerAId)).Times(1).WillRepeatedly(Return(6));
     ASSERT_TRUE(m_breakpointManager.CheckBreakpoints(breakInfo));
 }
 
+TEST_F(BreakpointManagerTests, Watchpoints_register_UnknownRegister_Throws) {
+    EXPECT_CALL(*m_callbacks, FindRegister).WillRepeatedly(Return(InvalidRegisterId));
+    EXPECT_THROW(m_breakpointManager.SetWatchpoint(std::string("NotARegister")), Rdb::DebuggerError);
+}
+
+TEST(DebuggerCallbacksTests, SetRegisterFile_Redeclared_KeepsResolvedIds) {
+    Rdb::DebuggerCallbacks callbacks;
+    const auto readId = [](RegisterId id) { return static_cast<unsigned int>(id); };
+    callbacks.SetRegisterFile({ { .name = "A", .id = RegisterId{ 0 } }, { .name = "B", .id = RegisterId{ 1 } } }, readId);
+    EXPECT_THROW(callbacks.SetRegisterFile({ { .name = "A", .id = RegisterId{ Rdb::DebuggerCallbacks::MaxRegisterIds } } }, readId), Rdb::DebuggerError);
+
+    // Nothing resolved yet, so the ids can still change.
+    callbacks.SetRegisterFile({ { .name = "A", .id = RegisterId{ 1 } }, { .name = "B", .id = RegisterId{ 0 } } }, readId);
+    ASSERT_EQ(callbacks.FindRegister("A"), RegisterId{ 1 });
+
+    EXPECT_THROW(callbacks.SetRegisterFile({ { .name = "A", .id = RegisterId{ 0 } }, { .name = "B", .id = RegisterId{ 1 } } }, readId), Rdb::DebuggerError);
+    EXPECT_THROW(callbacks.SetRegisterFile({ { .name = "A", .id = RegisterId{ 1 } } }, readId), Rdb::DebuggerError);
+    EXPECT_EQ(callbacks.ReadRegister(callbacks.FindRegister("B")), 0U); // The rejected files changed nothing.
+
+    callbacks.SetRegisterFile({ { .name = "A", .id = RegisterId{ 1 } }, { .name = "B", .id = RegisterId{ 0 } }, { .name = "C", .id = RegisterId{ 2 } } }, readId);
+    EXPECT_EQ(callbacks.FindRegister("C"), RegisterId{ 2 });
+}
+
+TEST(DebuggerCallbacksTests, GetRegisterFile_WithoutRegisterFile_IdsAreNotHeld) {
+    Rdb::DebuggerCallbacks callbacks;
+    callbacks.SetGetRegSetCallback([]() { return RegSet{ { "A", 1u }, { "B", 2u } }; });
+
+    // Listing the registers, as 'print reg' does, hands out ids to read them by that a later register file needn't keep.
+    const auto registers = callbacks.GetRegisterFile();
+    ASSERT_EQ(registers.size(), 2u);
+    EXPECT_EQ(callbacks.ReadRegister(registers[0].id), 1u);
+    EXPECT_EQ(callbacks.ReadRegister(registers[1].id), 2u);
+
+    const auto readId = [](RegisterId id) { return static_cast<unsigned int>(id); };
+    EXPECT_NO_THROW(callbacks.SetRegisterFile({ { .name = "B", .id = RegisterId{ 0 } }, { .name = "A", .id = RegisterId{ 1 } } }, readId));
+    EXPECT_EQ(callbacks.ReadRegister(callbacks.FindRegister("A")), 1u);
+}
+
+TEST(DebuggerCallbacksTests, ReadRegister_WithoutRegisterFile_ReadsRegSetOncePerInstruction) {
+    Rdb::DebuggerCallbacks callbacks;
+    auto regSetCalls = 0u;
+    auto a = 1u;
+    callbacks.SetGetRegSetCallback([&regSetCalls, &a]() {
+        ++regSetCalls;
+        return RegSet{ { "A", a }, { "B", 2u } };
+    });
+    const auto registerA = callbacks.FindRegister("A");
+    const auto registerB = callbacks.FindRegister("B");
+    regSetCalls = 0;
+
+    EXPECT_EQ(callbacks.ReadRegister(registerA), 1u);
+    EXPECT_EQ(callbacks.ReadRegister(registerB), 2u);
+    a = 3u;
+    EXPECT_EQ(callbacks.ReadRegister(registerA), 1u); // Still the same instruction.
+    EXPECT_EQ(regSetCalls, 1u);
+
+    callbacks.InvalidateRegisterSnapshot();
+    EXPECT_EQ(callbacks.ReadRegister(registerA), 3u);
+    EXPECT_EQ(regSetCalls, 2u);
+}
+
+
+// Emulator style callbacks, concrete and final so the manager can call them directly.
+class StaticCallbacks final : public Rdb::IDebuggerCallbacks {
+public:
+    unsigned int GetPcReg() override { return pc; }
+    unsigned int ReadMemory(unsigned int address) override { return memory[address % memory.size()]; }
+    bool CheckBankableMemoryLocation(BankNum bank, unsigned int /*address*/) override { return bank == BankNum{ 0 }; }
+    unsigned int ReadBankableMemory(BankNum /*bank*/, unsigned int address) override { return ReadMemory(address); }
+    bool ReadMemoryBlock(BankNum /*bank*/, unsigned int /*address*/, std::span<std::byte> /*buffer*/) override { return false; }
+    RegSet GetRegSet() override { return {}; }
+    RegisterId FindRegister(const std::string& name) override { return name == "A" ? RegisterId{ 0 } : InvalidRegisterId; }
+    unsigned int ReadRegister(RegisterId /*id*/) override { return a; }
+    RegisterFile GetRegisterFile() override { return { { .name = "A", .id = RegisterId{ 0 } } }; }
+
+    unsigned int pc = 0;
+    unsigned int a = 0;
+    std::array<unsigned int, 0x100> memory = {};
+};
+
+TEST(BasicBreakpointManagerTests, StaticCallbacks_BreakpointsAndWatchpoints_HappyPath) {
+    auto callbacks = std::make_shared<StaticCallbacks>();
+    Rdb::BasicBreakpointManager<StaticCallbacks> breakpointManager{ std::shared_ptr<Rdb::DebuggerOperations>{}, callbacks };
+
+    const auto breakNum = breakpointManager.SetBreakpoint(0x10);
+    const auto bankBreakNum = breakpointManager.SetBreakpoint(BankNum{ 0 }, 0x20);
+    const auto watchNum = breakpointManager.SetWatchpoint(0x80);
+    const auto registerWatchNum = breakpointManager.SetWatchpoint(std::string("A"));
+    breakpointManager.SetCondition(breakNum, "A == 1");
+
+    BreakInfo breakInfo{};
+    callbacks->pc = 0x10;
+    ASSERT_FALSE(breakpointManager.CheckBreakpoints(breakInfo));
+
+    callbacks->a = 1;
+    ASSERT_TRUE(breakpointManager.CheckBreakpoints(breakInfo));
+    EXPECT_EQ(breakInfo.breakpointNumber, breakNum);
+
+    callbacks->pc = 0x20;
+    ASSERT_TRUE(breakpointManager.CheckBreakpoints(breakInfo));
+    EXPECT_EQ(breakInfo.breakpointNumber, bankBreakNum);
+
+    callbacks->pc = 0x30;
+    callbacks->memory[0x80] = 0xFF;
+    ASSERT_TRUE(breakpointManager.CheckBreakpoints(breakInfo));
+    EXPECT_EQ(breakInfo.breakpointNumber, watchNum);
+
+    // Register A changed to 1 before the first hit, it is reported once the memory watch is done.
+    ASSERT_TRUE(breakpointManager.CheckBreakpoints(breakInfo));
+    EXPECT_EQ(breakInfo.breakpointNumber, registerWatchNum);
+    ASSERT_FALSE(breakpointManager.CheckBreakpoints(breakInfo));
+}
 
 // TEST_F(BreakpointManagerTests, Debugger_ListDiffrentListSizesOfBootRom) {
 //     const auto expectedSize = 5;
@@ -0,0 +1,140 @@
+#include "CodeCoverage.h"
+
+#include "Debugger.h"
+#include "DebuggerCallbacks.h"
+#include "DebuggerError.h"
+
+#include <fmt/core.h>
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+/******************************************************************************
+ * TODOs
+ *
+ ******************************************************************************/
+
+namespace DebuggerTests {
+
+class CodeCoverageTests : public ::testing::Test {
+public:
+    void SetUp() override {}
+
+    void TearDown() override {}
+
+    Rdb::CodeCoverage m_coverage{ 0x10000 };
+};
+
+TEST_F(CodeCoverageTests, Mark_KeepsKindsApart) {
+    m_coverage.MarkExecuted(0x100);
+    m_coverage.MarkExecuted(0x100);
+    m_coverage.MarkExecuted(0x13F);
+    m_coverage.MarkRead(AnyBank, 0xC000, 2);
+    m_coverage.MarkWritten(AnyBank, 0xFFFF, 4); // Runs past the address space.
+    m_coverage.MarkExecuted(0x10000);
+
+    EXPECT_TRUE(m_coverage.IsCovered(Rdb::CoverageKind::Executed, AnyBank, 0x100));
+    EXPECT_TRUE(m_coverage.IsCovered(Rdb::CoverageKind::Executed, AnyBank, 0x13F));
+    EXPECT_FALSE(m_coverage.IsCovered(Rdb::CoverageKind::Executed, AnyBank, 0x101));
+    EXPECT_FALSE(m_coverage.IsCovered(Rdb::CoverageKind::Read, AnyBank, 0x100));
+    EXPECT_TRUE(m_coverage.IsCovered(Rdb::CoverageKind::Read, AnyBank, 0xC001));
+    EXPECT_FALSE(m_coverage.IsCovered(Rdb::CoverageKind::Executed, AnyBank, 0x10000));
+    EXPECT_EQ(m_coverage.Count(Rdb::CoverageKind::Executed), 2U);
+    EXPECT_EQ(m_coverage.Count(Rdb::CoverageKind::Read), 2U);
+    EXPECT_EQ(m_coverage.Count(Rdb::CoverageKind::Written), 1U);
+}
+
+TEST_F(CodeCoverageTests, MapBank_CoversEachBankApart) {
+    m_coverage.MapBank(BankNum{ 1 }, 0x4000, 0x7FFF);
+    m_coverage.MarkExecuted(0x4010);
+    m_coverage.MarkRead(BankNum{ 2 }, 0x4020, 1); // Not mapped, still marked in its own bank.
+    m_coverage.MapBank(BankNum{ 2 }, 0x4000, 0x7FFF);
+    m_coverage.MarkExecuted(0x4011);
+
+    EXPECT_TRUE(m_coverage.IsCovered(Rdb::CoverageKind::Executed, BankNum{ 1 }, 0x4010));
+    EXPECT_FALSE(m_coverage.IsCovered(Rdb::CoverageKind::Executed, BankNum{ 1 }, 0x4011));
+    EXPECT_TRUE(m_coverage.IsCovered(Rdb::CoverageKind::Executed, AnyBank, 0x4011));
+    EXPECT_FALSE(m_coverage.IsCovered(Rdb::CoverageKind::Executed, AnyBank, 0x4010));
+    EXPECT_TRUE(m_coverage.IsCovered(Rdb::CoverageKind::Read, AnyBank, 0x4020));
+    EXPECT_EQ(m_coverage.Count(Rdb::CoverageKind::Executed), 2U);
+}
+
+TEST_F(CodeCoverageTests, Serialize_RoundTrips) {
+    m_coverage.MapBank(BankNum{ 5 }, 0x4000, 0x7FFF);
+    m_coverage.MarkExecuted(0x4000);
+    m_coverage.MarkExecuted(0x0150);
+    m_coverage.MarkWritten(AnyBank, 0xC123, 1);
+
+    const auto data = m_coverage.Serialize();
+    // Only the three marked pages are stored, not the whole address space.
+    EXPECT_LT(data.size(), 4 * sizeof(std::uint64_t) * (Rdb::CodeCoverage::PageSize / Rdb::CodeCoverage::SliceSize));
+
+    const auto coverage = Rdb::CodeCoverage::Deserialize(data);
+    ASSERT_TRUE(coverage.has_value());
+    EXPECT_EQ(coverage->AddressSpaceSize(), 0x10000U);
+    EXPECT_TRUE(coverage->IsCovered(Rdb::CoverageKind::Executed, BankNum{ 5 }, 0x4000));
+    EXPECT_FALSE(coverage->IsCovered(Rdb::CoverageKind::Executed, AnyBank, 0x4000));
+    EXPECT_TRUE(coverage->IsCovered(Rdb::CoverageKind::Executed, AnyBank, 0x0150));
+    EXPECT_TRUE(coverage->IsCovered(Rdb::CoverageKind::Written, AnyBank, 0xC123));
+    EXPECT_EQ(coverage->Count(Rdb::CoverageKind::Executed), 2U);
+
+    EXPECT_FALSE(Rdb::CodeCoverage::Deserialize(std::span{ data }.first(data.size() - 1)).has_value());
+}
+
+TEST_F(CodeCoverageTests, Deserialize_HugeAddressSpace_Rejected) {
+    auto data = m_coverage.Serialize();
+    const auto addressSpaceSize = std::uint64_t{ 1 } << 32U;
+    std::memcpy(data.data() + 2 * sizeof(std::uint32_t), &addressSpaceSize, sizeof(addressSpaceSize)); // After the magic and version.
+
+    EXPECT_FALSE(Rdb::CodeCoverage::Deserialize(data).has_value());
+}
+
+TEST_F(CodeCoverageTests, SaveLoad_RoundTrips) {
+    const auto path = std::filesystem::temp_directory_path() / "RetroDebugger_SaveLoad_RoundTrips.rdbc";
+    m_coverage.MarkRead(AnyBank, 0xFF40, 1);
+    m_coverage.Save(path);
+
+    const auto coverage = Rdb::CodeCoverage::Load(path);
+    EXPECT_TRUE(coverage.IsCovered(Rdb::CoverageKind::Read, AnyBank, 0xFF40));
+    EXPECT_EQ(coverage.Count(Rdb::CoverageKind::Read), 1U);
+
+    std::ofstream(path, std::ios::binary | std::ios::trunc) << "not coverage";
+    EXPECT_THROW(static_cast<void>(Rdb::CodeCoverage::Load(path)), Rdb::DebuggerError);
+    std::filesystem::remove(path);
+}
+
+TEST_F(CodeCoverageTests, Debugger_Coverage_MarksHooks) {
+    unsigned int pc = 0;
+    auto callbacks = std::make_shared<Rdb::DebuggerCallbacks>();
+    callbacks->SetGetPcRegCallback([&pc]() { return pc; });
+    callbacks->SetReadMemoryCallback([](unsigned int) { return 0U; });
+    Rdb::Debugger debugger(callbacks);
+    debugger.BankSwitchHook(BankNum{ 3 }, 0x4000, 0x7FFF); // Mapped before coverage starts.
+    debugger.EnableCoverage();
+    debugger.Run();
+
+    BreakInfo breakInfo;
+    for (pc = 0x3FFE; pc < 0x4002; ++pc) {
+        debugger.CheckBreakpoints(breakInfo);
+    }
+    debugger.ReadMemoryHook(AnyBank, 0xC000, 0, 2);
+    debugger.WriteMemoryHook(AnyBank, 0xC010, 0, 1);
+    Rdb::MemoryAccessBuffer accesses;
+    accesses.PushRead(AnyBank, 0xFF00, 0);
+    accesses.PushWrite(AnyBank, 0xFF01, 0);
+    debugger.MemoryAccessHook(accesses);
+    debugger.DisableCoverage();
+    debugger.CheckBreakpoints(breakInfo);
+
+    const auto& coverage = debugger.GetCoverage();
+    EXPECT_EQ(coverage.Count(Rdb::CoverageKind::Executed), 4U);
+    EXPECT_TRUE(coverage.IsCovered(Rdb::CoverageKind::Executed, BankNum{ 3 }, 0x4001));
+    EXPECT_FALSE(coverage.IsCovered(Rdb::CoverageKind::Executed, AnyBank, 0x4002));
+    EXPECT_EQ(coverage.Count(Rdb::CoverageKind::Read), 3U);
+    EXPECT_EQ(coverage.Count(Rdb::CoverageKind::Written), 2U);
+    EXPECT_TRUE(coverage.IsCovered(Rdb::CoverageKind::Written, AnyBank, 0xFF01));
+}
+
+}
@@ -1,12 +1,18 @@
 #include <gtest/gtest.h>
 
+#include "Debugger.h"
 #include "DebuggerOperations.h"
 #include "DebuggerXmlParser.h"
 #include "RetroDebuggerTests_assets.h"
+#ifdef RDB_GENERATED_OPERATIONS
+#include "GameboyOperations.h"
+#endif
 
 #include "DebuggerCallbacks.h"
 
 #include <array>
+#include <cstddef>
+#include <vector>
 
 /******************************************************************************
  * TODOs
@@ -86,16 +92,17 @@ TEST_F(DebuggerOperationsTests, GameboyOperations_GetOperation) {
     m_mockMemory.push_back(RetNoCarryOpcode);
     m_callbacks->SetReadMemoryCallback(MockReadMemory);
 
-    Operation actualOperation;
-    const auto sizeOfOperation = m_operations->GetOperation(0, actualOperation);
-    EXPECT_EQ(sizeOfOperation, 1U);
-    EXPECT_EQ(actualOperation.info->name, "RET");
-    EXPECT_EQ(actualOperation.arguments[0]->indirectArg, false);
-    EXPECT_EQ(actualOperation.arguments[0]->name, "NC");
-    EXPECT_TRUE(actualOperation.arguments[0]->reg.empty());
-    EXPECT_EQ(actualOperation.arguments[0]->operation, RegOperationType::NONE);
-    EXPECT_EQ(actualOperation.arguments[0]->type, ArgumentType::CONDITIONAL);
-    EXPECT_EQ(actualOperation.arguments[0]->operationValue, 0U);
+    const auto instruction = m_operations->Decode(0);
+    EXPECT_EQ(instruction.length, 1U);
+    EXPECT_EQ(instruction.Name(), "RET");
+    ASSERT_NE(instruction.operation, nullptr);
+    const auto& arguments = instruction.operation->arguments;
+    EXPECT_EQ(arguments[0]->indirectArg, false);
+    EXPECT_EQ(arguments[0]->name, "NC");
+    EXPECT_TRUE(arguments[0]->reg.empty());
+    EXPECT_EQ(arguments[0]->operation, RegOperationType::NONE);
+    EXPECT_EQ(arguments[0]->type, ArgumentType::CONDITIONAL);
+    EXPECT_EQ(instruction.argumentValues[0], 0U);
 }
 
 TEST_F(DebuggerOperationsTests, GameboyOperations_GetExtendedOperation) {
@@ -105,16 +112,216 @@ TEST_F(DebuggerOperationsTests, GameboyOperations_GetExtendedOperation) {
     m_mockMemory.push_back(SraIndirectHlOpcode);
     m_callbacks->SetReadMemoryCallback(MockReadMemory);
 
-    Operation actualOperation;
-    const auto sizeOfOperation = m_operations->GetOperation(0, actualOperation);
-    EXPECT_EQ(sizeOfOperation, 2U);
-    EXPECT_EQ(actualOperation.info->name, "SRA");
-    EXPECT_EQ(actualOperation.arguments[0]->indirectArg, true);
-    EXPECT_EQ(actualOperation.arguments[0]->name, "(HL)");
-    EXPECT_EQ(actualOperation.arguments[0]->reg, "HL");
-    EXPECT_EQ(actualOperation.arguments[0]->operation, RegOperationType::NONE);
-    EXPECT_EQ(actualOperation.arguments[0]->type, ArgumentType::REG);
-    EXPECT_EQ(actualOperation.arguments[0]->operationValue, 0U);
+    const auto instruction = m_operations->Decode(0);
+    EXPECT_EQ(instruction.length, 2U);
+    EXPECT_EQ(instruction.Name(), "SRA");
+    ASSERT_NE(instruction.operation, nullptr);
+    const auto& arguments = instruction.operation->arguments;
+    EXPECT_EQ(arguments[0]->indirectArg, true);
+    EXPECT_EQ(arguments[0]->name, "(HL)");
+    EXPECT_EQ(arguments[0]->reg, "HL");
+    EXPECT_EQ(arguments[0]->operation, RegOperationType::NONE);
+    EXPECT_EQ(arguments[0]->type, ArgumentType::REG);
+    EXPECT_EQ(instruction.argumentValues[0], 0U);
 }
 
-}
\ No newline at end of file
+TEST_F(DebuggerOperationsTests, GameboyOperations_GetOperation_SizeIncludesArguments) {
+    static constexpr auto CallNzOpcode = 0xC4;
+    m_mockMemory = { CallNzOpcode, 0x34, 0x12, CallNzOpcode };
+    m_callbacks->SetReadMemoryCallback(MockReadMemory);
+
+    EXPECT_EQ(m_operations->Decode(0).length, 3U);
+    EXPECT_EQ(m_operations->Decode(0).Name(), "CALL");
+    EXPECT_EQ(m_operations->Decode(3).length, 3U);
+    EXPECT_EQ(m_operations->Decode(3).Name(), "CALL");
+}
+
+TEST_F(DebuggerOperationsTests, GameboyOperations_Decode_OperandValuesAreNotShared) {
+    static constexpr auto CallNzOpcode = 0xC4;
+    m_mockMemory = { CallNzOpcode, 0x34, 0x12, CallNzOpcode, 0x01, 0x80 };
+    m_callbacks->SetReadMemoryCallback(MockReadMemory);
+
+    const auto first = m_operations->Decode(0);
+    const auto second = m_operations->Decode(3);
+    EXPECT_EQ(first.operation, second.operation);
+    EXPECT_EQ(first.argumentValues[1], 0x1234U);
+    EXPECT_EQ(second.argumentValues[1], 0x8001U);
+    EXPECT_EQ(m_operations->Decode(0).argumentValues[1], 0x1234U);
+    EXPECT_EQ(first.operation->arguments[1]->operationValue, 0U); // The operation table is never written by a decode.
+}
+
+TEST_F(DebuggerOperationsTests, GameboyOperations_DecodeBytes_MatchesReadMemory) {
+    static constexpr auto CallNzOpcode = 0xC4;
+    static constexpr auto ExtendedOpcode = 0xCB;
+    static constexpr auto UndefinedOpcode = 0xD3;
+    m_mockMemory = { CallNzOpcode, 0x34, 0x12, ExtendedOpcode, 0x11, UndefinedOpcode, 0x00, 0x00, 0x00 };
+    m_callbacks->SetReadMemoryCallback(MockReadMemory);
+    std::vector<std::byte> bytes;
+    for (const auto value : m_mockMemory) {
+        bytes.push_back(static_cast<std::byte>(value));
+    }
+
+    ASSERT_TRUE(m_operations->CanDecodeBytes());
+    ASSERT_EQ(m_operations->MaxInstructionLength(), 3U);
+    for (const size_t address : { 0U, 3U, 5U }) {
+        const auto expected = m_operations->Decode(address);
+        const auto decoded = m_operations->Decode(address, std::span{ bytes }.subspan(address));
+        EXPECT_EQ(decoded.operation, expected.operation);
+        EXPECT_EQ(decoded.opcode, expected.opcode);
+        EXPECT_EQ(decoded.length, expected.length);
+        EXPECT_EQ(decoded.argumentValues, expected.argumentValues);
+    }
+}
+
+TEST_F(DebuggerOperationsTests, GameboyOperations_ListingReadsMemoryBlocks) {
+    static constexpr auto NopOpcode = 0x00;
+    static constexpr auto CallNzOpcode = 0xC4;
+    m_mockMemory.assign(0x400, NopOpcode);
+    m_mockMemory[0x10] = CallNzOpcode;
+    unsigned int memoryReads = 0;
+    unsigned int blockReads = 0;
+    m_callbacks->SetReadMemoryCallback([&](unsigned int address) { ++memoryReads; return MockReadMemory(address); });
+    m_callbacks->SetReadMemoryBlockCallback([&](BankNum, unsigned int address, std::span<std::byte> buffer) {
+        ++blockReads;
+        for (size_t i = 0; i < buffer.size() && address + i < m_mockMemory.size(); ++i) {
+            buffer[i] = static_cast<std::byte>(m_mockMemory[address + i]);
+        }
+    });
+    Rdb::Debugger debugger(m_callbacks);
+    debugger.SetOperations(m_parser->GetOperations());
+
+    const auto commands = debugger.GetCommandInfoList(size_t{ 0 }, size_t{ 0x3FF });
+    EXPECT_EQ(commands.size(), 0x3FEU);
+    EXPECT_EQ(commands.at(0x10).Name(), "CALL");
+    EXPECT_EQ(commands.at(0x10).length, 3U);
+    EXPECT_EQ(memoryReads, 0U);
+    EXPECT_LE(blockReads, 5U);
+}
+
+TEST_F(DebuggerOperationsTests, GameboyOperations_ListingShortBlockRead_DecodesZerosPastIt) {
+    static constexpr auto LdBcOpcode = 0x01; // LD BC, d16, the last one starts at 0x102
+    m_mockMemory.assign(0x104, LdBcOpcode);
+    m_callbacks->SetReadMemoryCallback(MockReadMemory);
+    Rdb::Debugger debugger(m_callbacks);
+    debugger.SetOperations(m_parser->GetOperations());
+    const auto expected = debugger.GetCommandInfoList(size_t{ 0 }, size_t{ 0x103 });
+
+    m_callbacks->SetReadMemoryBlockCallback([&](BankNum, unsigned int address, std::span<std::byte> buffer) {
+        for (size_t i = 0; i < buffer.size() && address + i < m_mockMemory.size(); ++i) {
+            buffer[i] = static_cast<std::byte>(m_mockMemory[address + i]);
+        }
+    });
+    Rdb::Debugger blockDebugger(m_callbacks);
+    blockDebugger.SetOperations(m_parser->GetOperations());
+
+    // The second block read runs past the memory, the operand past it decodes as 0 like ReadMemory's, not as a byte of the first block.
+    const auto commands = blockDebugger.GetCommandInfoList(size_t{ 0 }, size_t{ 0x103 });
+    ASSERT_TRUE(commands.contains(0x102));
+    EXPECT_EQ(commands.at(0x102).argumentValues, expected.at(0x102).argumentValues);
+}
+
+TEST_F(DebuggerOperationsTests, GameboyOperations_GetOperation_UndefinedOpcode) {
+    static constexpr auto UndefinedOpcode = 0xD3;
+    m_mockMemory.push_back(UndefinedOpcode);
+    m_callbacks->SetReadMemoryCallback(MockReadMemory);
+
+    const auto instruction = m_operations->Decode(0);
+    EXPECT_EQ(instruction.length, 1U);
+    EXPECT_EQ(instruction.Name(), std::to_string(UndefinedOpcode));
+    EXPECT_FALSE(instruction.IsJump());
+}
+
+TEST_F(DebuggerOperationsTests, GameboyOperations_JumpQueries) {
+    static constexpr auto extendedOpcode = 0xCBU;
+    static constexpr auto nopOpcode = 0x00U;
+    static constexpr auto jumpNzOpcode = 0xC2U;
+    static constexpr auto callNzOpcode = 0xC4U;
+
+    EXPECT_EQ(m_operations->GetOpcodeLength(), 8U);
+    EXPECT_TRUE(m_operations->IsExtensionOpcode(extendedOpcode));
+    EXPECT_FALSE(m_operations->IsExtensionOpcode(nopOpcode));
+
+    EXPECT_TRUE(m_operations->IsJumpOperation(jumpNzOpcode));
+    EXPECT_TRUE(m_operations->IsJumpOperation(callNzOpcode));
+    EXPECT_FALSE(m_operations->IsJumpOperation(nopOpcode));
+    EXPECT_FALSE(m_operations->IsJumpOperation(extendedOpcode));
+    EXPECT_FALSE(m_operations->IsJumpOperation(0x1000U));
+
+    // The Gameboy extended table has no jumps.
+    for (auto opcode = 0U; opcode <= 0xFFU; ++opcode) {
+        EXPECT_FALSE(m_operations->IsJumpOperation(extendedOpcode, opcode));
+    }
+    EXPECT_FALSE(m_operations->GetJumpOperations().extendedOperations.contains(extendedOpcode));
+}
+
+#ifdef RDB_GENERATED_OPERATIONS // Not generated when cross compiling without a host codegen, see cmake/GenerateOperations.cmake
+// Argument lengths of the generated tables are known at compile time, "LD BC,d16" reads 2 bytes.
+static_assert(RdbOperations::GameboyOperations::Tables.back().operations[1].command == "LD");
+static_assert(RdbOperations::GameboyOperations::Tables.back().operations[1].argumentsLength == 2);
+
+TEST_F(DebuggerOperationsTests, GeneratedOperations_MatchParsedXml) {
+    Rdb::DebuggerOperations generated(m_callbacks);
+    generated.SetOperations(RdbOperations::GameboyOperations::Tables);
+
+    const auto expectEqual = [](const Operations& expected, const Operations& actual) {
+        EXPECT_EQ(actual.opcodeLength, expected.opcodeLength);
+        ASSERT_EQ(actual.operations.size(), expected.operations.size());
+        for (const auto& [opcode, operation] : expected.operations) {
+            const auto& actualOperation = actual.operations.at(opcode);
+            EXPECT_EQ(actualOperation.info->name, operation.info->name) << opcode;
+            EXPECT_EQ(actualOperation.info->isJump, operation.info->isJump) << opcode;
+            ASSERT_EQ(actualOperation.arguments.size(), operation.arguments.size()) << opcode;
+            for (auto i = 0U; i < operation.arguments.size(); ++i) {
+                EXPECT_EQ(*actualOperation.arguments[i], *operation.arguments[i]) << opcode;
+                EXPECT_EQ(actualOperation.arguments[i]->reg, operation.arguments[i]->reg) << opcode;
+            }
+        }
+    };
+
+    const auto expected = m_operations->GetOperations();
+    const auto actual = generated.GetOperations();
+    expectEqual(expected, actual);
+    ASSERT_EQ(actual.extendedOperations.size(), expected.extendedOperations.size());
+    for (const auto& [extensionOpcode, operations] : expected.extendedOperations) {
+        expectEqual(operations, actual.extendedOperations.at(extensionOpcode));
+    }
+    EXPECT_EQ(generated.GetRegisters().size(), m_operations->GetRegisters().size());
+
+    // The generated decode tables take their lengths from the precomputed argument lengths.
+    ASSERT_EQ(generated.MaxInstructionLength(), m_operations->MaxInstructionLength());
+    for (auto opcode = 0U; opcode <= 0xFFU; ++opcode) {
+        const std::array memory = { std::byte(opcode), std::byte(opcode), std::byte{ 0x34 }, std::byte{ 0x12 } };
+        const auto expectedInstruction = m_operations->Decode(0, memory);
+        const auto instruction = generated.Decode(0, memory);
+        EXPECT_EQ(instruction.Name(), expectedInstruction.Name()) << opcode;
+        EXPECT_EQ(instruction.length, expectedInstruction.length) << opcode;
+        EXPECT_EQ(instruction.argumentValues, expectedInstruction.argumentValues) << opcode;
+    }
+}
+#endif
+
+TEST_F(DebuggerOperationsTests, SetOperations_InternsNamesArgumentsAndRegisters) {
+    const XmlDebuggerArgument regA = { .type = ArgumentType::REG, .indirectArg = false, .operation = RegOperationType::NONE, .value = { .nameFirst = true, .name = "A", .reg = "A", .offset = 0 } };
+    const XmlDebuggerArgument indirectA = { .type = ArgumentType::REG, .indirectArg = true, .operation = RegOperationType::NONE, .value = { .nameFirst = true, .name = "A", .reg = "A", .offset = 0 } };
+    XmlDebuggerOperations table = { .opcodeLength = 8, .extendedOpcode = NormalOperationsKey, .operations = {} };
+    table.operations.emplace(0x01, XmlDebuggerOperation{ .opcode = 0x01, .command = "LD", .arguments = { regA }, .isJump = false });
+    table.operations.emplace(0x02, XmlDebuggerOperation{ .opcode = 0x02, .command = "LD", .arguments = { regA, indirectA }, .isJump = false });
+    table.operations.emplace(0x03, XmlDebuggerOperation{ .opcode = 0x03, .command = "INC", .arguments = { indirectA }, .isJump = false });
+
+    Rdb::DebuggerOperations operations(m_callbacks);
+    operations.SetOperations({ { NormalOperationsKey, table } });
+
+    const auto operationData = operations.GetOperations();
+    const auto& ld1 = operationData.operations.at(0x01);
+    const auto& ld2 = operationData.operations.at(0x02);
+    const auto& inc = operationData.operations.at(0x03);
+    EXPECT_EQ(ld1.info, ld2.info);
+    EXPECT_NE(ld1.info, inc.info);
+    EXPECT_EQ(ld1.arguments[0], ld2.arguments[0]);
+    EXPECT_EQ(ld2.arguments[1], inc.arguments[0]);
+    EXPECT_NE(ld2.arguments[0], ld2.arguments[1]);
+    ASSERT_EQ(operations.GetRegisters().size(), 1U);
+    EXPECT_EQ(operations.GetRegisters()[0]->name, "A");
+}
+
+}
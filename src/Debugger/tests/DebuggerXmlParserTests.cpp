@@ -2,11 +2,17 @@
 #include <gtest/gtest.h>
 
 #include "DebuggerXmlParser.h"
+#include "OperationsCache.h"
 #include "RetroDebuggerTests_assets.h"
 #include "XmlParserException.h"
 
+#include <fmt/core.h>
 #include <tinyxml2.h>
 
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <span>
 #include <string>
 
 /******************************************************************************
@@ -85,4 +91,66 @@ TEST_F(DebuggerXmlParserTests, Invalid_MustStartWith_RetroDebuggerElement) {
     ASSERT_THROW_STRING(m_xmlParser.ParseXmlDocument(doc), "Root XML element must be 'RetroDebugger'");
 }
 
-}
\ No newline at end of file
+class OperationsCacheTests : public ::testing::Test {
+public:
+    void SetUp() override {
+        const auto* testInfo = ::testing::UnitTest::GetInstance()->current_test_info();
+        m_directory = std::filesystem::temp_directory_path() / fmt::format("RetroDebugger_{}", testInfo->name());
+        std::filesystem::remove_all(m_directory);
+        std::filesystem::create_directories(m_directory);
+
+        // Copied so the cache isn't written into the source tree.
+        m_xmlPath = m_directory / "GameboyOperationsDebugger.xml";
+        std::filesystem::copy_file(std::string(RetroDebuggerTests::Assets::GameboyOperationsDebuggerXml), m_xmlPath);
+    }
+
+    void TearDown() override { std::filesystem::remove_all(m_directory); }
+
+    static std::uint64_t HashFile(const std::filesystem::path& path) {
+        std::ifstream file(path, std::ios::binary);
+        const std::string contents{ std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+        return OperationsCache::Hash(std::as_bytes(std::span{ contents }));
+    }
+
+    std::filesystem::path m_directory;
+    std::filesystem::path m_xmlPath;
+    DebuggerXmlParser m_xmlParser;
+};
+
+TEST_F(OperationsCacheTests, SerializeDeserialize_RoundTrips) {
+    m_xmlParser.ParseFile(m_xmlPath.string());
+    const auto operations = m_xmlParser.GetOperations();
+
+    const auto data = OperationsCache::Serialize(operations, 1u);
+    const auto restored = OperationsCache::Deserialize(data, 1u);
+    ASSERT_TRUE(restored.has_value());
+    EXPECT_EQ(OperationsCache::Serialize(*restored, 1u), data);
+    EXPECT_EQ(restored->at(0xCB).operations.size(), operations.at(0xCB).operations.size());
+    EXPECT_EQ(restored->at(NormalOperationsKey).operations.at(0xC3).command, operations.at(NormalOperationsKey).operations.at(0xC3).command);
+
+    // Another source or a truncated file is a miss, not an error.
+    EXPECT_FALSE(OperationsCache::Deserialize(data, 2u).has_value());
+    EXPECT_FALSE(OperationsCache::Deserialize(std::span{ data }.first(data.size() - 1), 1u).has_value());
+}
+
+TEST_F(OperationsCacheTests, ParseFile_WritesCacheAndReusesIt) {
+    const auto cachePath = OperationsCache::CachePath(m_xmlPath);
+    m_xmlParser.ParseFile(m_xmlPath.string(), true);
+    const auto parsed = m_xmlParser.GetOperations();
+    ASSERT_TRUE(std::filesystem::exists(cachePath));
+
+    // A cache with the XML's hash is trusted, swapping in different tables shows they came from the cache.
+    auto cached = parsed;
+    cached.erase(0xCB);
+    OperationsCache::Save(cachePath, cached, HashFile(m_xmlPath));
+    m_xmlParser.ParseFile(m_xmlPath.string(), true);
+    EXPECT_EQ(m_xmlParser.GetOperations().size(), 1u);
+
+    // Editing the XML invalidates the cache, it is parsed and rewritten.
+    std::ofstream(m_xmlPath, std::ios::app) << "<!-- edited -->\n";
+    m_xmlParser.ParseFile(m_xmlPath.string(), true);
+    EXPECT_EQ(m_xmlParser.GetOperations().size(), parsed.size());
+    EXPECT_TRUE(OperationsCache::Load(cachePath, HashFile(m_xmlPath)).has_value());
+}
+
+}
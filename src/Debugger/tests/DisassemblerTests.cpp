@@ -0,0 +1,157 @@
+#include "Disassembler.h"
+
+#include "Debugger.h"
+#include "DebuggerCallbacks.h"
+#include "DebuggerOperations.h"
+#include "DebuggerXmlParser.h"
+#include "RetroDebuggerTests_assets.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <span>
+#include <vector>
+
+/******************************************************************************
+ * TODOs
+ *
+ ******************************************************************************/
+
+namespace DebuggerTests {
+
+class DisassemblerTests : public ::testing::Test {
+public:
+    DisassemblerTests() {
+        DebuggerXmlParser parser;
+        parser.ParseFile(std::string(RetroDebuggerTests::Assets::GameboyOperationsDebuggerXml));
+        m_operations->SetOperations(parser.GetOperations());
+        m_debugger.SetOperations(parser.GetOperations());
+        m_callbacks->SetReadMemoryCallback([this](unsigned int address) { return address < m_memory.size() ? std::to_integer<unsigned int>(m_memory[address]) : 0U; });
+    }
+
+    void SetUp() override {}
+
+    void TearDown() override {}
+
+    void FillRandomMemory(size_t size) {
+        std::mt19937 generator(0x5EED); // NOLINT (cert-msc32-c, cert-msc51-cpp) Fixed seed, the same memory every run.
+        std::uniform_int_distribution<unsigned int> distribution(0, 0xFF);
+        m_memory.resize(size);
+        for (auto& value : m_memory) {
+            value = static_cast<std::byte>(distribution(generator));
+        }
+    }
+
+    static void ExpectEqual(const Disassembly& disassembly, const CommandList& expected) {
+        ASSERT_EQ(disassembly.size(), expected.size());
+        auto expectedIter = expected.begin();
+        for (const auto& [address, instruction] : disassembly) {
+            const auto& [expectedAddress, expectedInstruction] = *expectedIter++;
+            ASSERT_EQ(address, expectedAddress);
+            EXPECT_EQ(instruction.Name(), expectedInstruction.Name());
+            EXPECT_EQ(instruction.length, expectedInstruction.length);
+            EXPECT_EQ(instruction.argumentValues, expectedInstruction.argumentValues);
+        }
+    }
+
+    std::vector<std::byte> m_memory;
+    std::shared_ptr<Rdb::DebuggerCallbacks> m_callbacks = std::make_shared<Rdb::DebuggerCallbacks>();
+    std::unique_ptr<Rdb::DebuggerOperations> m_operations = std::make_unique<Rdb::DebuggerOperations>(m_callbacks);
+    Rdb::Debugger m_debugger{ m_callbacks };
+};
+
+TEST_F(DisassemblerTests, Disassemble_RandomMemory_MatchesSerialListing) {
+    FillRandomMemory(0x10000);
+    const Rdb::Disassembler disassembler(*m_operations, 4);
+
+    const auto disassembly = disassembler.Disassemble(0, m_memory, m_memory.size());
+    ExpectEqual(disassembly, m_debugger.GetCommandInfoList(size_t{ 0 }, size_t{ 0xFFFF }));
+}
+
+TEST_F(DisassemblerTests, Disassemble_ChunkBoundaryInsideInstruction_Resynchronises) {
+    static constexpr auto NopOpcode = std::byte{ 0x00 };
+    static constexpr auto CallOpcode = std::byte{ 0xCD };
+    static constexpr auto LdSpOpcode = std::byte{ 0x31 }; // LD SP, d16
+    m_memory.assign(Rdb::Disassembler::MinChunkSize * 3, NopOpcode);
+    // The second chunk guesses an instruction starts at its first byte, the CALL's operand, and decodes an LD SP
+    // overlapping the real instructions. Its guesses only agree again after the NOP following the CALL.
+    m_memory[Rdb::Disassembler::MinChunkSize - 1] = CallOpcode;
+    m_memory[Rdb::Disassembler::MinChunkSize] = LdSpOpcode;
+    m_memory[Rdb::Disassembler::MinChunkSize + 1] = LdSpOpcode;
+    const Rdb::Disassembler disassembler(*m_operations, 2);
+
+    const auto disassembly = disassembler.Disassemble(0x4000, m_memory, m_memory.size());
+    ASSERT_EQ(disassembly.size(), m_memory.size() - 2);
+    const auto& call = disassembly[Rdb::Disassembler::MinChunkSize - 1];
+    EXPECT_EQ(call.address, 0x4000 + Rdb::Disassembler::MinChunkSize - 1);
+    EXPECT_EQ(call.instruction.Name(), "CALL");
+    EXPECT_EQ(call.instruction.argumentValues[0], 0x3131U);
+    EXPECT_EQ(disassembly[Rdb::Disassembler::MinChunkSize].address, 0x4000 + Rdb::Disassembler::MinChunkSize + 2);
+    EXPECT_EQ(disassembly[Rdb::Disassembler::MinChunkSize].instruction.Name(), "NOP");
+}
+
+TEST_F(DisassemblerTests, Disassemble_InstructionPastTheEnd_ReadsLookaheadBytes) {
+    static constexpr auto CallOpcode = std::byte{ 0xCD };
+    m_memory = { std::byte{ 0x00 }, CallOpcode, std::byte{ 0x34 }, std::byte{ 0x12 } };
+    const Rdb::Disassembler disassembler(*m_operations);
+
+    const auto disassembly = disassembler.Disassemble(0, m_memory, 2);
+    ASSERT_EQ(disassembly.size(), 2U);
+    EXPECT_EQ(disassembly[1].instruction.Name(), "CALL");
+    EXPECT_EQ(disassembly[1].instruction.argumentValues[0], 0x1234U);
+
+    const auto truncated = disassembler.Disassemble(0, std::span{ m_memory }.first(3), 2);
+    ASSERT_EQ(truncated.size(), 2U);
+    EXPECT_EQ(truncated[1].instruction.argumentValues[0], 0x34U); // Bytes past the memory read as 0.
+}
+
+TEST_F(DisassemblerTests, Debugger_Disassemble_MatchesGetCommandInfoList) {
+    static constexpr auto NopOpcode = std::byte{ 0x00 };
+    static constexpr auto CallOpcode = std::byte{ 0xCD };
+    FillRandomMemory(0x8000);
+    // NOPs line the listing up on a CALL at the last address, its operands are past the end.
+    std::fill(m_memory.begin() + 0x7FF0, m_memory.end(), NopOpcode);
+    m_memory.back() = CallOpcode;
+    m_memory.insert(m_memory.end(), { std::byte{ 0x34 }, std::byte{ 0x12 } });
+
+    const auto disassembly = m_debugger.Disassemble(0x100, 0x7FFF);
+    ExpectEqual(disassembly, m_debugger.GetCommandInfoList(size_t{ 0x100 }, size_t{ 0x7FFF }));
+    ASSERT_EQ(disassembly.back().address, 0x7FFFU);
+    EXPECT_EQ(disassembly.back().instruction.argumentValues[0], 0x1234U);
+    EXPECT_TRUE(m_debugger.Disassemble(0x10, 0x0F).empty());
+}
+
+TEST_F(DisassemblerTests, Debugger_Disassemble_TopOfMemory_ReadsOnlyTheLastOperandsFurther) {
+    static constexpr auto LdBcOpcode = std::byte{ 0x01 }; // LD BC, d16, the last one starts at 0xFFFF
+    m_memory.assign(0x10000, LdBcOpcode);
+    size_t lastRead = 0;
+    m_callbacks->SetReadMemoryCallback([&](unsigned int address) {
+        lastRead = std::max<size_t>(lastRead, address);
+        return address < m_memory.size() ? std::to_integer<unsigned int>(m_memory[address]) : 0U;
+    });
+
+    const auto disassembly = m_debugger.Disassemble(0, 0xFFFF);
+    ASSERT_EQ(disassembly.size(), 0x5556U);
+    EXPECT_EQ(disassembly.back().address, 0xFFFFU);
+    EXPECT_EQ(disassembly.back().instruction.argumentValues[0], 0U); // Bytes past the top of memory read as 0.
+    EXPECT_EQ(lastRead, 0x10001U);
+
+    size_t lastBlockRead = 0;
+    m_callbacks->SetReadMemoryBlockCallback([&](BankNum, unsigned int address, std::span<std::byte> buffer) {
+        lastBlockRead = std::max(lastBlockRead, address + buffer.size() - 1);
+        for (size_t i = 0; i < buffer.size() && address + i < m_memory.size(); ++i) {
+            buffer[i] = m_memory[address + i];
+        }
+    });
+    EXPECT_EQ(m_debugger.Disassemble(0, 0xFFFF).size(), 0x5556U);
+    EXPECT_EQ(lastBlockRead, 0x10001U);
+
+    // A cached listing block reads no further either, only the operands an instruction at its end could have.
+    lastBlockRead = 0;
+    m_debugger.GetCommandInfoList(size_t{ 0xFF80 }, size_t{ 0xFFFF });
+    EXPECT_EQ(lastBlockRead, 0x10001U);
+}
+
+}
@@ -0,0 +1,110 @@
+#include "ExecutionProfile.h"
+
+#include "Debugger.h"
+#include "DebuggerCallbacks.h"
+
+#include <gtest/gtest.h>
+
+/******************************************************************************
+ * TODOs
+ *
+ ******************************************************************************/
+
+namespace DebuggerTests {
+
+class ExecutionProfileTests : public ::testing::Test {
+public:
+    void SetUp() override {}
+
+    void TearDown() override {}
+
+    void CountTimes(unsigned int address, unsigned int times) {
+        for (auto i = 0U; i < times; ++i) {
+            m_profile.Count(address);
+        }
+    }
+
+    Rdb::ExecutionProfile m_profile{ 0x10000 };
+};
+
+TEST_F(ExecutionProfileTests, TopAddresses_MostExecutedFirst) {
+    CountTimes(0x100, 3);
+    CountTimes(0x200, 7);
+    CountTimes(0x300, 5);
+    CountTimes(0x10000, 100); // Outside the address space.
+
+    const auto hotspots = m_profile.TopAddresses(2);
+    ASSERT_EQ(hotspots.size(), 2U);
+    EXPECT_EQ(hotspots[0].address, 0x200U);
+    EXPECT_EQ(hotspots[0].count, 7U);
+    EXPECT_EQ(hotspots[1].address, 0x300U);
+    EXPECT_EQ(hotspots[0].bank, AnyBank);
+    EXPECT_EQ(m_profile.Total(), 15U);
+    EXPECT_EQ(m_profile.TopAddresses(10).size(), 3U);
+}
+
+TEST_F(ExecutionProfileTests, MapBank_CountsEachBankApart) {
+    m_profile.MapBank(BankNum{ 1 }, 0x4000, 0x7FFF);
+    CountTimes(0x4010, 2);
+    m_profile.MapBank(BankNum{ 2 }, 0x4000, 0x7FFF);
+    CountTimes(0x4010, 5);
+    CountTimes(0x0010, 1);
+
+    const auto hotspots = m_profile.TopAddresses(3);
+    ASSERT_EQ(hotspots.size(), 3U);
+    EXPECT_EQ(hotspots[0].bank, BankNum{ 2 });
+    EXPECT_EQ(hotspots[0].address, 0x4010U);
+    EXPECT_EQ(hotspots[0].count, 5U);
+    EXPECT_EQ(hotspots[1].bank, BankNum{ 1 });
+    EXPECT_EQ(hotspots[1].count, 2U);
+    EXPECT_EQ(hotspots[2].bank, AnyBank);
+}
+
+TEST_F(ExecutionProfileTests, TopRanges_SplitAtGaps) {
+    // A loop of 1 to 3 byte instructions, and a single instruction further on.
+    for (auto i = 0U; i < 10; ++i) {
+        m_profile.Count(0x150);
+        m_profile.Count(0x151);
+        m_profile.Count(0x154);
+        m_profile.Count(0x156);
+    }
+    CountTimes(0x180, 15);
+
+    const auto ranges = m_profile.TopRanges(5, 3);
+    ASSERT_EQ(ranges.size(), 2U);
+    EXPECT_EQ(ranges[0].startAddress, 0x150U);
+    EXPECT_EQ(ranges[0].endAddress, 0x156U);
+    EXPECT_EQ(ranges[0].count, 40U);
+    EXPECT_EQ(ranges[1].startAddress, 0x180U);
+    EXPECT_EQ(ranges[1].endAddress, 0x180U);
+}
+
+TEST_F(ExecutionProfileTests, Debugger_Profile_CountsByMappedBank) {
+    unsigned int pc = 0;
+    auto callbacks = std::make_shared<Rdb::DebuggerCallbacks>();
+    callbacks->SetGetPcRegCallback([&pc]() { return pc; });
+    callbacks->SetReadMemoryCallback([](unsigned int) { return 0U; });
+    Rdb::Debugger debugger(callbacks);
+    debugger.BankSwitchHook(BankNum{ 3 }, 0x4000, 0x7FFF); // Mapped before profiling starts.
+    debugger.EnableProfile();
+    debugger.Run();
+
+    BreakInfo breakInfo;
+    for (pc = 0x3FFE; pc < 0x4002; ++pc) {
+        debugger.CheckBreakpoints(breakInfo);
+    }
+    debugger.DisableProfile();
+    debugger.CheckBreakpoints(breakInfo);
+
+    const auto& profile = debugger.GetProfile();
+    EXPECT_EQ(profile.Total(), 4U);
+    const auto ranges = profile.TopRanges(5);
+    ASSERT_EQ(ranges.size(), 2U);
+    EXPECT_EQ(ranges[0].count, 2U);
+    EXPECT_EQ(ranges[1].count, 2U);
+    const auto bankRange = ranges[0].bank == BankNum{ 3 } ? ranges[0] : ranges[1];
+    EXPECT_EQ(bankRange.bank, BankNum{ 3 });
+    EXPECT_EQ(bankRange.startAddress, 0x4000U);
+}
+
+}
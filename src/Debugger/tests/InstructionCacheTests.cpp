@@ -0,0 +1,96 @@
+#include "InstructionCache.h"
+
+#include <gtest/gtest.h>
+
+/******************************************************************************
+ * TODOs
+ *
+ ******************************************************************************/
+
+namespace DebuggerTests {
+
+class InstructionCacheTests : public ::testing::Test {
+public:
+    void SetUp() override {}
+
+    void TearDown() override {}
+
+    DecodedInstruction MakeInstruction(const std::string& name, unsigned int length) {
+        const auto& operation = m_operations.try_emplace(name, Operation{ std::make_shared<OperationInfo>(name, false), {} }).first->second;
+        return DecodedInstruction{ .operation = &operation, .opcode = 0, .length = length, .argumentValues = {} };
+    }
+
+    std::map<std::string, Operation> m_operations; // Operations the instructions point at.
+    Rdb::InstructionCache m_cache;
+};
+
+TEST_F(InstructionCacheTests, Insert_WritableMemory_OnlyCachedOnceWritesAreReported) {
+    m_cache.Insert(AnyBank, 0x100, MakeInstruction("NOP", 1));
+    EXPECT_EQ(m_cache.Find(AnyBank, 0x100), nullptr);
+
+    m_cache.Invalidate(AnyBank, 0x8000, 1);
+    m_cache.Insert(AnyBank, 0x100, MakeInstruction("NOP", 1));
+    ASSERT_NE(m_cache.Find(AnyBank, 0x100), nullptr);
+    EXPECT_EQ(m_cache.Find(AnyBank, 0x100)->Name(), "NOP");
+    EXPECT_EQ(m_cache.Find(AnyBank, 0x100)->length, 1U);
+}
+
+TEST_F(InstructionCacheTests, Invalidate_DropsOverlappingInstructionsOnly) {
+    m_cache.Invalidate(AnyBank, 0, 1);
+    m_cache.Insert(AnyBank, 0x100, MakeInstruction("JP", 3));
+    m_cache.Insert(AnyBank, 0x103, MakeInstruction("NOP", 1));
+    m_cache.Insert(AnyBank, 0x104, MakeInstruction("LD", 2));
+
+    // Writing the last argument byte of JP.
+    m_cache.Invalidate(AnyBank, 0x102, 1);
+    EXPECT_EQ(m_cache.Find(AnyBank, 0x100), nullptr);
+    EXPECT_NE(m_cache.Find(AnyBank, 0x103), nullptr);
+    EXPECT_NE(m_cache.Find(AnyBank, 0x104), nullptr);
+
+    m_cache.Invalidate(AnyBank, 0x103, 2);
+    EXPECT_TRUE(m_cache.Empty());
+}
+
+TEST_F(InstructionCacheTests, ReadOnlyMemory_SurvivesWrites) {
+    m_cache.SetReadOnly(0x0000, 0x7FFF);
+    m_cache.Insert(AnyBank, 0x150, MakeInstruction("NOP", 1));
+    ASSERT_NE(m_cache.Find(AnyBank, 0x150), nullptr);
+
+    m_cache.Invalidate(AnyBank, 0x150, 1); // e.g. a mapper register write
+    EXPECT_NE(m_cache.Find(AnyBank, 0x150), nullptr);
+}
+
+TEST_F(InstructionCacheTests, BankSwitch_KeepsEachBanksInstructions) {
+    static constexpr auto bank1 = BankNum{ 1 };
+    static constexpr auto bank2 = BankNum{ 2 };
+    m_cache.SetReadOnly(0x4000, 0x7FFF);
+
+    m_cache.MapBank(bank1, 0x4000, 0x7FFF);
+    m_cache.Insert(m_cache.BankAt(0x4000), 0x4000, MakeInstruction("NOP", 1));
+    m_cache.MapBank(bank2, 0x4000, 0x7FFF);
+    EXPECT_EQ(m_cache.BankAt(0x4000), bank2);
+    EXPECT_EQ(m_cache.Find(m_cache.BankAt(0x4000), 0x4000), nullptr);
+    m_cache.Insert(m_cache.BankAt(0x4000), 0x4000, MakeInstruction("HALT", 1));
+
+    m_cache.MapBank(bank1, 0x4000, 0x7FFF);
+    ASSERT_NE(m_cache.Find(m_cache.BankAt(0x4000), 0x4000), nullptr);
+    EXPECT_EQ(m_cache.Find(m_cache.BankAt(0x4000), 0x4000)->Name(), "NOP");
+    EXPECT_EQ(m_cache.BankAt(0x100), AnyBank);
+}
+
+TEST_F(InstructionCacheTests, Invalidate_BankedWriteOnlyDropsThatBank) {
+    static constexpr auto bank1 = BankNum{ 1 };
+    static constexpr auto bank2 = BankNum{ 2 };
+    m_cache.Invalidate(AnyBank, 0, 1);
+    m_cache.Insert(bank1, 0xA000, MakeInstruction("NOP", 1));
+    m_cache.Insert(bank2, 0xA000, MakeInstruction("NOP", 1));
+
+    m_cache.Invalidate(bank2, 0xA000, 1);
+    EXPECT_NE(m_cache.Find(bank1, 0xA000), nullptr);
+    EXPECT_EQ(m_cache.Find(bank2, 0xA000), nullptr);
+
+    m_cache.Clear();
+    EXPECT_TRUE(m_cache.Empty());
+}
+
+}
@@ -0,0 +1,61 @@
+#include "SpscQueue.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+
+/******************************************************************************
+ * TODOs
+ *
+ ******************************************************************************/
+
+namespace DebuggerTests {
+
+TEST(SpscQueueTests, PushPop_FifoAndBounded) {
+    Rdb::SpscQueue<std::string, 2> queue;
+    EXPECT_TRUE(queue.Empty());
+    EXPECT_FALSE(queue.TryPop().has_value());
+
+    EXPECT_TRUE(queue.TryPush("b 0x100"));
+    EXPECT_TRUE(queue.TryPush("info break"));
+    EXPECT_TRUE(queue.Full());
+    EXPECT_FALSE(queue.TryPush("continue"));
+
+    EXPECT_EQ(queue.TryPop(), "b 0x100");
+    EXPECT_TRUE(queue.TryPush("continue")); // Wraps around
+    EXPECT_EQ(queue.TryPop(), "info break");
+    EXPECT_EQ(queue.TryPop(), "continue");
+    EXPECT_TRUE(queue.Empty());
+}
+
+TEST(SpscQueueTests, TwoThreads_EveryValueArrivesInOrder) {
+    static constexpr auto valueCount = 100'000u;
+    Rdb::SpscQueue<unsigned int, 64> queue;
+
+    std::thread producer([&queue]() {
+        for (auto value = 0u; value < valueCount;) {
+            if (queue.TryPush(value)) {
+                ++value;
+            }
+            else {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    auto expected = 0u;
+    while (expected < valueCount) {
+        if (const auto value = queue.TryPop()) {
+            ASSERT_EQ(*value, expected);
+            ++expected;
+        }
+        else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    EXPECT_TRUE(queue.Empty());
+}
+
+}
@@ -0,0 +1,297 @@
+#include "TraceBuffer.h"
+
+#include "Debugger.h"
+#include "DebuggerCallbacks.h"
+#include "DebuggerError.h"
+#include "DebuggerXmlParser.h"
+#include "RetroDebuggerTests_assets.h"
+#include "TraceFile.h"
+
+#include <fmt/core.h>
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <vector>
+
+/******************************************************************************
+ * TODOs
+ *
+ ******************************************************************************/
+
+namespace DebuggerTests {
+
+class TraceBufferTests : public ::testing::Test {
+public:
+    void SetUp() override {}
+
+    void TearDown() override {}
+
+    static void AppendPcs(Rdb::TraceBuffer& trace, unsigned int first, unsigned int count) {
+        for (auto pc = first; pc < first + count; ++pc) {
+            trace.Append().pc = pc;
+        }
+    }
+
+    static std::vector<unsigned int> Pcs(const std::vector<Rdb::TraceRecord>& records) {
+        std::vector<unsigned int> pcs;
+        for (const auto& record : records) {
+            pcs.push_back(record.pc);
+        }
+        return pcs;
+    }
+};
+
+static_assert(sizeof(Rdb::TraceRecord) == 32);
+
+TEST_F(TraceBufferTests, Last_BeforeWrapping_OldestFirst) {
+    Rdb::TraceBuffer trace(4);
+    AppendPcs(trace, 10, 3);
+
+    EXPECT_EQ(trace.Size(), 3U);
+    EXPECT_EQ(Pcs(trace.Last(10)), (std::vector<unsigned int>{ 10, 11, 12 }));
+    EXPECT_EQ(Pcs(trace.Last(2)), (std::vector<unsigned int>{ 11, 12 }));
+}
+
+TEST_F(TraceBufferTests, Append_Full_OverwritesOldest) {
+    Rdb::TraceBuffer trace(4);
+    AppendPcs(trace, 10, 7);
+
+    EXPECT_EQ(trace.Size(), 4U);
+    EXPECT_EQ(trace.Capacity(), 4U);
+    EXPECT_EQ(Pcs(trace.Last(4)), (std::vector<unsigned int>{ 13, 14, 15, 16 }));
+    EXPECT_EQ(Pcs(trace.Last(1)), (std::vector<unsigned int>{ 16 }));
+
+    trace.Clear();
+    EXPECT_EQ(trace.Size(), 0U);
+    EXPECT_TRUE(trace.Last(4).empty());
+}
+
+TEST_F(TraceBufferTests, Debugger_Trace_RecordsInstructionBytesAndRegisters) {
+    static constexpr auto CallOpcode = 0xCDU;
+    std::vector<unsigned int> memory = { 0x00, CallOpcode, 0x34, 0x12 };
+    unsigned int pc = 0;
+    unsigned int registerA = 0;
+    auto callbacks = std::make_shared<Rdb::DebuggerCallbacks>();
+    callbacks->SetGetPcRegCallback([&pc]() { return pc; });
+    callbacks->SetReadMemoryCallback([&memory](unsigned int address) { return address < memory.size() ? memory[address] : 0U; });
+    callbacks->SetRegisterFile({ { .name = "A", .id = RegisterId{ 0 } } }, [&registerA](RegisterId) { return registerA; });
+    Rdb::Debugger debugger(callbacks);
+    DebuggerXmlParser parser;
+    parser.ParseFile(std::string(RetroDebuggerTests::Assets::GameboyOperationsDebuggerXml));
+    debugger.SetOperations(parser.GetOperations());
+
+    EXPECT_THROW(debugger.EnableTrace(16, { "Q" }), Rdb::DebuggerError);
+    EXPECT_THROW(debugger.EnableTrace(Rdb::Debugger::MaxTraceSize + 1), Rdb::DebuggerError);
+    EXPECT_FALSE(debugger.IsTracing());
+    debugger.EnableTrace(16, { "A" });
+    debugger.Run();
+
+    BreakInfo breakInfo;
+    debugger.CheckBreakpoints(breakInfo);
+    pc = 1;
+    registerA = 0x42;
+    debugger.CheckBreakpoints(breakInfo);
+    debugger.DisableTrace();
+    pc = 4;
+    debugger.CheckBreakpoints(breakInfo);
+
+    const auto records = debugger.GetTrace().Last(16);
+    ASSERT_EQ(records.size(), 2U);
+    EXPECT_EQ(records[0].pc, 0U);
+    EXPECT_EQ(records[0].length, 1U);
+    EXPECT_EQ(records[1].pc, 1U);
+    EXPECT_EQ(records[1].bank, AnyBank);
+    ASSERT_EQ(records[1].length, 3U);
+    EXPECT_EQ(records[1].bytes[0], CallOpcode);
+    EXPECT_EQ(records[1].bytes[1], 0x34U);
+    EXPECT_EQ(records[1].bytes[2], 0x12U);
+    EXPECT_EQ(records[1].registers[0], 0x42U);
+    EXPECT_EQ(debugger.GetTraceRegisters(), (std::vector<std::string>{ "A" }));
+}
+
+TEST_F(TraceBufferTests, Debugger_Trace_BlockReader_OneBlockReadPerInstruction) {
+    static constexpr auto CallOpcode = std::byte{ 0xCD };
+    std::vector<std::byte> memory = { std::byte{ 0x00 }, CallOpcode, std::byte{ 0x34 }, std::byte{ 0x12 } };
+    unsigned int pc = 0;
+    unsigned int memoryReads = 0;
+    unsigned int blockReads = 0;
+    auto callbacks = std::make_shared<Rdb::DebuggerCallbacks>();
+    callbacks->SetGetPcRegCallback([&pc]() { return pc; });
+    callbacks->SetReadMemoryCallback([&memoryReads](unsigned int) { ++memoryReads; return 0U; });
+    callbacks->SetReadMemoryBlockCallback([&](BankNum, unsigned int address, std::span<std::byte> buffer) {
+        ++blockReads;
+        for (size_t i = 0; i < buffer.size() && address + i < memory.size(); ++i) {
+            buffer[i] = memory[address + i];
+        }
+    });
+    Rdb::Debugger debugger(callbacks);
+    DebuggerXmlParser parser;
+    parser.ParseFile(std::string(RetroDebuggerTests::Assets::GameboyOperationsDebuggerXml));
+    debugger.SetOperations(parser.GetOperations());
+    debugger.EnableTrace(16);
+    debugger.Run();
+
+    BreakInfo breakInfo;
+    debugger.CheckBreakpoints(breakInfo);
+    pc = 1;
+    debugger.CheckBreakpoints(breakInfo);
+    memory[3] = std::byte{ 0x56 }; // Read again on the next instruction, not kept from the last one.
+    debugger.CheckBreakpoints(breakInfo);
+
+    const auto records = debugger.GetTrace().Last(16);
+    ASSERT_EQ(records.size(), 3U);
+    ASSERT_EQ(records[1].length, 3U);
+    EXPECT_EQ(records[1].bytes[2], 0x12U);
+    ASSERT_EQ(records[2].length, 3U);
+    EXPECT_EQ(records[2].bytes[0], 0xCDU);
+    EXPECT_EQ(records[2].bytes[2], 0x56U);
+    EXPECT_EQ(blockReads, 3U);
+    EXPECT_EQ(memoryReads, 0U);
+}
+
+class TraceFileTests : public ::testing::Test {
+public:
+    void SetUp() override {
+        const auto* testInfo = ::testing::UnitTest::GetInstance()->current_test_info();
+        m_directory = std::filesystem::temp_directory_path() / fmt::format("RetroDebugger_{}", testInfo->name());
+        std::filesystem::remove_all(m_directory);
+        std::filesystem::create_directories(m_directory);
+        m_path = m_directory / "trace.rdbt";
+    }
+
+    void TearDown() override { std::filesystem::remove_all(m_directory); }
+
+    static Rdb::TraceRecord MakeRecord(unsigned int pc, BankNum bank, unsigned int registerA) {
+        Rdb::TraceRecord record;
+        record.pc = pc;
+        record.bank = bank;
+        record.length = 1 + (pc % 3);
+        for (size_t i = 0; i < record.length; ++i) {
+            record.bytes[i] = static_cast<std::uint8_t>(pc + i);
+        }
+        record.registers[0] = registerA;
+        return record;
+    }
+
+    static void ExpectEqual(const Rdb::TraceRecord& record, const Rdb::TraceRecord& expected) {
+        EXPECT_EQ(record.pc, expected.pc);
+        EXPECT_EQ(record.bank, expected.bank);
+        ASSERT_EQ(record.length, expected.length);
+        EXPECT_EQ(record.bytes, expected.bytes);
+        EXPECT_EQ(record.registers[0], expected.registers[0]);
+    }
+
+    std::filesystem::path m_directory;
+    std::filesystem::path m_path;
+};
+
+TEST_F(TraceFileTests, WriteRead_RoundTrips) {
+    // Enough records to fill several buffers, with jumps backwards and forwards, bank switches and register changes.
+    std::vector<Rdb::TraceRecord> records;
+    unsigned int pc = 0x100;
+    for (auto i = 0U; i < 1'000'000U; ++i) {
+        const auto bank = (i / 5000) % 2 == 0 ? AnyBank : BankNum{ i / 5000 };
+        records.push_back(MakeRecord(pc, bank, i / 3));
+        pc = i % 7 == 0 ? (pc * 31U) & 0xFFFFU : pc + records.back().length;
+    }
+    {
+        Rdb::TraceFileWriter writer(m_path, { "A" });
+        for (const auto& record : records) {
+            writer.Write(record);
+        }
+        writer.Close();
+    }
+    EXPECT_GT(std::filesystem::file_size(m_path), Rdb::TraceFileWriter::BufferSize * 2);
+
+    Rdb::TraceFileReader reader(m_path);
+    EXPECT_EQ(reader.Registers(), (std::vector<std::string>{ "A" }));
+    for (const auto& expected : records) {
+        const auto record = reader.Next();
+        ASSERT_TRUE(record.has_value());
+        ExpectEqual(*record, expected);
+    }
+    EXPECT_FALSE(reader.Next().has_value());
+}
+
+TEST_F(TraceFileTests, Read_TruncatedRecord_EndsTheTrace) {
+    {
+        Rdb::TraceFileWriter writer(m_path, { "A" });
+        writer.Write(MakeRecord(0x100, AnyBank, 0));
+        writer.Write(MakeRecord(0x200, BankNum{ 2 }, 0x1234));
+    }
+    std::filesystem::resize_file(m_path, std::filesystem::file_size(m_path) - 1);
+
+    Rdb::TraceFileReader reader(m_path);
+    ASSERT_TRUE(reader.Next().has_value());
+    EXPECT_FALSE(reader.Next().has_value());
+}
+
+TEST_F(TraceFileTests, Read_NotATraceFile_Throws) {
+    std::ofstream(m_path) << "not a trace";
+    EXPECT_THROW(Rdb::TraceFileReader{ m_path }, Rdb::DebuggerError);
+    EXPECT_THROW(Rdb::TraceFileReader{ m_directory / "missing.rdbt" }, Rdb::DebuggerError);
+}
+
+TEST_F(TraceFileTests, Write_TooManyRegisters_KeepsExistingFile) {
+    std::ofstream(m_path) << "an earlier trace";
+    const auto size = std::filesystem::file_size(m_path);
+
+    EXPECT_THROW((Rdb::TraceFileWriter{ m_path, { "A", "B", "C", "D", "E" } }), Rdb::DebuggerError);
+    EXPECT_EQ(std::filesystem::file_size(m_path), size);
+}
+
+TEST_F(TraceFileTests, Debugger_TraceFile_StreamsEveryInstruction) {
+    std::vector<unsigned int> memory(0x100, 0x00);
+    unsigned int pc = 0;
+    auto callbacks = std::make_shared<Rdb::DebuggerCallbacks>();
+    callbacks->SetGetPcRegCallback([&pc]() { return pc; });
+    callbacks->SetReadMemoryCallback([&memory](unsigned int address) { return address < memory.size() ? memory[address] : 0U; });
+    callbacks->SetRegisterFile({ { .name = "A", .id = RegisterId{ 0 } } }, [&pc](RegisterId) { return pc * 2; });
+    Rdb::Debugger debugger(callbacks);
+    DebuggerXmlParser parser;
+    parser.ParseFile(std::string(RetroDebuggerTests::Assets::GameboyOperationsDebuggerXml));
+    debugger.SetOperations(parser.GetOperations());
+
+    debugger.EnableTraceFile(m_path, { "A" });
+    debugger.Run();
+    BreakInfo breakInfo;
+    for (pc = 0; pc < 0x100; ++pc) {
+        debugger.CheckBreakpoints(breakInfo);
+    }
+    debugger.DisableTrace();
+
+    Rdb::TraceFileReader reader(m_path);
+    for (auto expectedPc = 0U; expectedPc < 0x100; ++expectedPc) {
+        const auto record = reader.Next();
+        ASSERT_TRUE(record.has_value());
+        EXPECT_EQ(record->pc, expectedPc);
+        EXPECT_EQ(record->length, 1U);
+        EXPECT_EQ(record->registers[0], expectedPc * 2);
+    }
+    EXPECT_FALSE(reader.Next().has_value());
+}
+
+TEST_F(TraceFileTests, Debugger_TraceFile_FailedReopen_StopsTracing) {
+    unsigned int pc = 0;
+    auto callbacks = std::make_shared<Rdb::DebuggerCallbacks>();
+    callbacks->SetGetPcRegCallback([&pc]() { return pc; });
+    callbacks->SetReadMemoryCallback([](unsigned int) { return 0U; });
+    Rdb::Debugger debugger(callbacks);
+    debugger.EnableTraceFile(m_path);
+    debugger.Run();
+
+    EXPECT_THROW(debugger.EnableTraceFile(m_directory / "missing" / "trace.rdbt"), Rdb::DebuggerError);
+    EXPECT_FALSE(debugger.IsTracing());
+    BreakInfo breakInfo;
+    debugger.CheckBreakpoints(breakInfo); // Nothing is recorded, there's no buffer or file to record into.
+    EXPECT_EQ(debugger.GetTrace().Size(), 0U);
+    EXPECT_FALSE(Rdb::TraceFileReader{ m_path }.Next().has_value()); // The earlier file was closed.
+
+    debugger.EnableTrace(4);
+    debugger.CheckBreakpoints(breakInfo);
+    EXPECT_EQ(debugger.GetTrace().Size(), 1U);
+}
+
+}
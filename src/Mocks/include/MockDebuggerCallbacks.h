@@ -13,7 +13,11 @@ public:
     MOCK_METHOD(unsigned int, ReadMemory, (unsigned int address), (override));
     MOCK_METHOD(bool, CheckBankableMemoryLocation, (BankNum bank, unsigned int address), (override));
     MOCK_METHOD(unsigned int, ReadBankableMemory, (BankNum bank, unsigned int address), (override));
+    MOCK_METHOD(bool, ReadMemoryBlock, (BankNum bank, unsigned int address, std::span<std::byte> buffer), (override));
     MOCK_METHOD(RegSet, GetRegSet, (), (override));
+    MOCK_METHOD(RegisterId, FindRegister, (const std::string& name), (override));
+    MOCK_METHOD(unsigned int, ReadRegister, (RegisterId id), (override));
+    MOCK_METHOD(RegisterFile, GetRegisterFile, (), (override));
 };
 
 }
\ No newline at end of file
@@ -2,139 +2,427 @@
 
 #include "RetroDebugger.h"
 
+#include <cstdint>
+#include <memory>
+
 namespace Rdb {
 
-RetroDebugger m_debugger; // NOLINT (cert-err58-cpp, cppcoreguidelines-avoid-non-const-global-variables) - TODO: Look into this more. Issue is that it can throw and can't be caught.
+namespace {
+// Created on first use, a throwing constructor then surfaces at the first call rather than before main.
+RetroDebugger& DefaultDebugger() {
+    static RetroDebugger debugger;
+    return debugger;
+}
+
+RetroDebugger& ToDebugger(DebuggerContext context) {
+    return *reinterpret_cast<RetroDebugger*>(static_cast<std::uintptr_t>(context)); // NOLINT (performance-no-int-to-ptr) - Handles are pointers.
+}
+}
+
+DebuggerContext CreateDebuggerContext() {
+    auto debugger = std::make_unique<RetroDebugger>();
+    return DebuggerContext{ reinterpret_cast<std::uintptr_t>(debugger.release()) };
+}
+
+void DestroyDebuggerContext(DebuggerContext context) {
+    if (context == InvalidDebuggerContext) { return; }
+    delete &ToDebugger(context); // NOLINT (cppcoreguidelines-owning-memory) - Owned by the handle.
+}
 
 std::string GetRdbVersion() {
-    return m_debugger.GetRdbVersion();
+    return RetroDebugger::GetRdbVersion();
 }
 
 // Command interpreter calls
 std::string GetCommandPrompt() noexcept {
-    return m_debugger.GetCommandPrompt();
+    return DefaultDebugger().GetCommandPrompt();
 }
 
 std::string GetCommandResponse() {
-    return m_debugger.GetCommandResponse();
+    return DefaultDebugger().GetCommandResponse();
 }
 
 int ProcessCommandString(const std::string& message) {
-    return m_debugger.ProcessCommandString(message);
+    return DefaultDebugger().ProcessCommandString(message);
+}
+
+bool PostCommand(const std::string& message) {
+    return DefaultDebugger().PostCommand(message);
+}
+
+int ProcessPendingCommands() {
+    return DefaultDebugger().ProcessPendingCommands();
+}
+
+bool PollCommandResponse(std::string& response) {
+    return DefaultDebugger().PollCommandResponse(response);
 }
 
 // Direct debugger calls
 bool CheckBreakpoints(BreakInfo* breakInfo) {
-    return m_debugger.CheckBreakpoints(breakInfo);
+    return DefaultDebugger().CheckBreakpoints(breakInfo);
+}
+
+bool CheckBreakpoints(BreakInfo* breakInfo, MemoryAccessBuffer& accesses) {
+    return DefaultDebugger().CheckBreakpoints(breakInfo, accesses);
 }
 
 bool Run(const unsigned int numBreakpointsToSkip) {
-    return m_debugger.Run(numBreakpointsToSkip);
+    return DefaultDebugger().Run(numBreakpointsToSkip);
 }
 
 bool RunInstructions(const unsigned int numBreakToPass) {
-    return m_debugger.RunInstructions(numBreakToPass);
+    return DefaultDebugger().RunInstructions(numBreakToPass);
 }
 
 bool RunTillJump() {
-    return m_debugger.RunTillJump();
+    return DefaultDebugger().RunTillJump();
 }
 
 bool SetBreakpoint(unsigned int address) {
-    return m_debugger.SetBreakpoint(address);
+    return DefaultDebugger().SetBreakpoint(address);
 }
 
 void SetCondition(unsigned int breakNum, const std::string& condition) {
-    m_debugger.SetCondition(BreakNum{ breakNum }, condition);
+    DefaultDebugger().SetCondition(BreakNum{ breakNum }, condition);
 }
 
 bool SetWatchpoint(unsigned int address) {
-    return m_debugger.SetWatchpoint(address);
+    return DefaultDebugger().SetWatchpoint(address);
 }
 
 bool SetReadWatchpoint(unsigned int address) {
-    return m_debugger.SetReadWatchpoint(address);
+    return DefaultDebugger().SetReadWatchpoint(address);
 }
 
 bool SetAnyWatchpoint(unsigned int address) {
-    return m_debugger.SetAnyWatchpoint(address);
+    return DefaultDebugger().SetAnyWatchpoint(address);
 }
 
 bool SetWatchpoint(const std::string& name) {
-    return m_debugger.SetWatchpoint(name);
+    return DefaultDebugger().SetWatchpoint(name);
 }
 
 bool EnableBreakpoints(const unsigned int breakRange0, const unsigned int breakRange1) {
-    return m_debugger.EnableBreakpoints(breakRange0, breakRange1);
+    return DefaultDebugger().EnableBreakpoints(breakRange0, breakRange1);
 }
 
 bool DisableBreakpoints(const unsigned int breakRange0, const unsigned int breakRange1) {
-    return m_debugger.DisableBreakpoints(breakRange0, breakRange1);
+    return DefaultDebugger().DisableBreakpoints(breakRange0, breakRange1);
 }
 
 bool DeleteBreakpoints() {
-    return m_debugger.DeleteBreakpoints();
+    return DefaultDebugger().DeleteBreakpoints();
 }
 
 bool DeleteBreakpoints(const unsigned int breakRange0, const unsigned int breakRange1) {
-    return m_debugger.DeleteBreakpoints(breakRange0, breakRange1);
+    return DefaultDebugger().DeleteBreakpoints(breakRange0, breakRange1);
 }
 
 BreakList GetBreakpointInfo [[nodiscard]] () {
-    return m_debugger.GetBreakpointInfo();
+    return DefaultDebugger().GetBreakpointInfo();
 }
 
 
 BreakInfo GetBreakpointInfo(const unsigned int breakPointNum) {
-    return m_debugger.GetBreakpointInfo(breakPointNum);
+    return DefaultDebugger().GetBreakpointInfo(breakPointNum);
 }
 
 bool GetRegisterInfo(std::vector<RegisterInfoPtr>* registerInfo) {
-    return m_debugger.GetRegisterInfo(registerInfo);
+    return DefaultDebugger().GetRegisterInfo(registerInfo);
 }
 
 void ParseXmlFile(const std::string& filename) {
-    m_debugger.ParseXmlFile(filename);
+    DefaultDebugger().ParseXmlFile(filename);
+}
+
+void ParseXmlFile(const std::string& filename, bool useBinaryCache) {
+    DefaultDebugger().ParseXmlFile(filename, useBinaryCache);
+}
+
+void SetOperations(StaticOperationsTables operations) {
+    DefaultDebugger().SetOperations(operations);
 }
 
 // Set Callbacks
 void SetGetPcRegCallback(GetProgramCounterFunc getPc_cb) {
-    m_debugger.SetGetPcRegCallback(std::move(getPc_cb));
+    DefaultDebugger().SetGetPcRegCallback(std::move(getPc_cb));
 }
 
 void SetReadMemoryCallback(ReadMemoryFunc readMemory_cb) {
-    m_debugger.SetReadMemoryCallback(std::move(readMemory_cb));
+    DefaultDebugger().SetReadMemoryCallback(std::move(readMemory_cb));
 }
 
 // TODO: I need to think about this callback more. The idea is to add the bank to a break/watch such as Bank 3 address 0x40C0 -> "3:0x40C0"
 void SetCheckBankableMemoryLocationCallback(CheckBankableMemoryLocationFunc CheckBankableMemoryLocation_cb) {
-    m_debugger.SetCheckBankableMemoryLocationCallback(std::move(CheckBankableMemoryLocation_cb));
+    DefaultDebugger().SetCheckBankableMemoryLocationCallback(std::move(CheckBankableMemoryLocation_cb));
 }
 
 void SetReadBankableMemoryCallback(ReadBankableMemoryFunc readBankMemory_cb) {
-    m_debugger.SetReadBankableMemoryCallback(std::move(readBankMemory_cb));
+    DefaultDebugger().SetReadBankableMemoryCallback(std::move(readBankMemory_cb));
+}
+
+void SetReadMemoryBlockCallback(ReadMemoryBlockFunc readMemoryBlock_cb) {
+    DefaultDebugger().SetReadMemoryBlockCallback(std::move(readMemoryBlock_cb));
 }
 
 
 void SetGetRegSetCallback(GetRegSetFunc getRegSet_cb) {
-    m_debugger.SetGetRegSetCallback(std::move(getRegSet_cb));
+    DefaultDebugger().SetGetRegSetCallback(std::move(getRegSet_cb));
+}
+
+void SetRegisterFile(const RegisterFile& registers, ReadRegisterFunc readRegister_cb) {
+    DefaultDebugger().SetRegisterFile(registers, std::move(readRegister_cb));
+}
+
+void SetRegisterFile(const RegisterFile& registers, const void* registerStruct) {
+    DefaultDebugger().SetRegisterFile(registers, registerStruct);
+}
+
+void SetReadOnlyMemory(unsigned int startAddress, unsigned int endAddress) {
+    DefaultDebugger().SetReadOnlyMemory(startAddress, endAddress);
 }
 
 // Hooks
 void ReadMemoryHook(unsigned int address, const std::vector<std::byte>& bytes) {
-    m_debugger.ReadMemoryHook(AnyBank, address, bytes);
+    DefaultDebugger().ReadMemoryHook(AnyBank, address, bytes);
 }
 
 void WriteMemoryHook(unsigned int address, const std::vector<std::byte>& bytes) {
-    m_debugger.WriteMemoryHook(AnyBank, address, bytes);
+    DefaultDebugger().WriteMemoryHook(AnyBank, address, bytes);
+}
+
+void ReadMemoryHook(unsigned int address, std::span<const std::byte> bytes) {
+    DefaultDebugger().ReadMemoryHook(AnyBank, address, bytes);
+}
+
+void WriteMemoryHook(unsigned int address, std::span<const std::byte> bytes) {
+    DefaultDebugger().WriteMemoryHook(AnyBank, address, bytes);
 }
 
 void ReadMemoryHook(unsigned int bankNum, unsigned int address, const std::vector<std::byte>& bytes) {
-    return m_debugger.ReadMemoryHook(BankNum{ bankNum }, address, bytes);
+    return DefaultDebugger().ReadMemoryHook(BankNum{ bankNum }, address, bytes);
 }
 
 void WriteMemoryHook(unsigned int bankNum, unsigned int address, const std::vector<std::byte>& bytes) {
-    return m_debugger.WriteMemoryHook(BankNum{ bankNum }, address, bytes);
+    return DefaultDebugger().WriteMemoryHook(BankNum{ bankNum }, address, bytes);
+}
+
+void ReadMemoryHook(unsigned int bankNum, unsigned int address, std::span<const std::byte> bytes) {
+    DefaultDebugger().ReadMemoryHook(BankNum{ bankNum }, address, bytes);
+}
+
+void WriteMemoryHook(unsigned int bankNum, unsigned int address, std::span<const std::byte> bytes) {
+    DefaultDebugger().WriteMemoryHook(BankNum{ bankNum }, address, bytes);
+}
+
+void ReadMemoryHook(unsigned int bankNum, unsigned int address, unsigned int value, unsigned int width) {
+    DefaultDebugger().ReadMemoryHook(BankNum{ bankNum }, address, value, width);
+}
+
+void WriteMemoryHook(unsigned int bankNum, unsigned int address, unsigned int value, unsigned int width) {
+    DefaultDebugger().WriteMemoryHook(BankNum{ bankNum }, address, value, width);
+}
+
+void MemoryAccessHook(MemoryAccessBuffer& accesses) {
+    DefaultDebugger().MemoryAccessHook(accesses);
+}
+
+void BankSwitchHook(unsigned int bankNum, unsigned int startAddress, unsigned int endAddress) {
+    DefaultDebugger().BankSwitchHook(BankNum{ bankNum }, startAddress, endAddress);
+}
+
+// Context overloads
+std::string GetCommandPrompt(DebuggerContext context) noexcept {
+    return ToDebugger(context).GetCommandPrompt();
+}
+
+std::string GetCommandResponse(DebuggerContext context) {
+    return ToDebugger(context).GetCommandResponse();
+}
+
+int ProcessCommandString(DebuggerContext context, const std::string& message) {
+    return ToDebugger(context).ProcessCommandString(message);
+}
+
+bool PostCommand(DebuggerContext context, const std::string& message) {
+    return ToDebugger(context).PostCommand(message);
+}
+
+int ProcessPendingCommands(DebuggerContext context) {
+    return ToDebugger(context).ProcessPendingCommands();
+}
+
+bool PollCommandResponse(DebuggerContext context, std::string& response) {
+    return ToDebugger(context).PollCommandResponse(response);
+}
+
+bool CheckBreakpoints(DebuggerContext context, BreakInfo* breakInfo) {
+    return ToDebugger(context).CheckBreakpoints(breakInfo);
+}
+
+bool CheckBreakpoints(DebuggerContext context, BreakInfo* breakInfo, MemoryAccessBuffer& accesses) {
+    return ToDebugger(context).CheckBreakpoints(breakInfo, accesses);
+}
+
+bool Run(DebuggerContext context, const unsigned int numBreakpointsToSkip) {
+    return ToDebugger(context).Run(numBreakpointsToSkip);
+}
+
+bool RunInstructions(DebuggerContext context, const unsigned int numBreakToPass) {
+    return ToDebugger(context).RunInstructions(numBreakToPass);
+}
+
+bool RunTillJump(DebuggerContext context) {
+    return ToDebugger(context).RunTillJump();
+}
+
+bool SetBreakpoint(DebuggerContext context, unsigned int address) {
+    return ToDebugger(context).SetBreakpoint(address);
+}
+
+void SetCondition(DebuggerContext context, unsigned int breakNum, const std::string& condition) {
+    ToDebugger(context).SetCondition(BreakNum{ breakNum }, condition);
 }
 
-}
\ No newline at end of file
+bool SetWatchpoint(DebuggerContext context, unsigned int address) {
+    return ToDebugger(context).SetWatchpoint(address);
+}
+
+bool SetReadWatchpoint(DebuggerContext context, unsigned int address) {
+    return ToDebugger(context).SetReadWatchpoint(address);
+}
+
+bool SetAnyWatchpoint(DebuggerContext context, unsigned int address) {
+    return ToDebugger(context).SetAnyWatchpoint(address);
+}
+
+bool SetWatchpoint(DebuggerContext context, const std::string& name) {
+    return ToDebugger(context).SetWatchpoint(name);
+}
+
+bool EnableBreakpoints(DebuggerContext context, const unsigned int breakRange0, const unsigned int breakRange1) {
+    return ToDebugger(context).EnableBreakpoints(breakRange0, breakRange1);
+}
+
+bool DisableBreakpoints(DebuggerContext context, const unsigned int breakRange0, const unsigned int breakRange1) {
+    return ToDebugger(context).DisableBreakpoints(breakRange0, breakRange1);
+}
+
+bool DeleteBreakpoints(DebuggerContext context) {
+    return ToDebugger(context).DeleteBreakpoints();
+}
+
+bool DeleteBreakpoints(DebuggerContext context, const unsigned int breakRange0, const unsigned int breakRange1) {
+    return ToDebugger(context).DeleteBreakpoints(breakRange0, breakRange1);
+}
+
+BreakList GetBreakpointInfo(DebuggerContext context) {
+    return ToDebugger(context).GetBreakpointInfo();
+}
+
+BreakInfo GetBreakpointInfo(DebuggerContext context, const unsigned int breakPointNum) {
+    return ToDebugger(context).GetBreakpointInfo(breakPointNum);
+}
+
+bool GetRegisterInfo(DebuggerContext context, std::vector<RegisterInfoPtr>* registerInfo) {
+    return ToDebugger(context).GetRegisterInfo(registerInfo);
+}
+
+void ParseXmlFile(DebuggerContext context, const std::string& filename) {
+    ToDebugger(context).ParseXmlFile(filename);
+}
+
+void ParseXmlFile(DebuggerContext context, const std::string& filename, bool useBinaryCache) {
+    ToDebugger(context).ParseXmlFile(filename, useBinaryCache);
+}
+
+void SetOperations(DebuggerContext context, StaticOperationsTables operations) {
+    ToDebugger(context).SetOperations(operations);
+}
+
+void SetGetPcRegCallback(DebuggerContext context, GetProgramCounterFunc getPc_cb) {
+    ToDebugger(context).SetGetPcRegCallback(std::move(getPc_cb));
+}
+
+void SetReadMemoryCallback(DebuggerContext context, ReadMemoryFunc readMemory_cb) {
+    ToDebugger(context).SetReadMemoryCallback(std::move(readMemory_cb));
+}
+
+void SetCheckBankableMemoryLocationCallback(DebuggerContext context, CheckBankableMemoryLocationFunc CheckBankableMemoryLocation_cb) {
+    ToDebugger(context).SetCheckBankableMemoryLocationCallback(std::move(CheckBankableMemoryLocation_cb));
+}
+
+void SetReadBankableMemoryCallback(DebuggerContext context, ReadBankableMemoryFunc readBankMemory_cb) {
+    ToDebugger(context).SetReadBankableMemoryCallback(std::move(readBankMemory_cb));
+}
+
+void SetReadMemoryBlockCallback(DebuggerContext context, ReadMemoryBlockFunc readMemoryBlock_cb) {
+    ToDebugger(context).SetReadMemoryBlockCallback(std::move(readMemoryBlock_cb));
+}
+
+void SetGetRegSetCallback(DebuggerContext context, GetRegSetFunc getRegSet_cb) {
+    ToDebugger(context).SetGetRegSetCallback(std::move(getRegSet_cb));
+}
+
+void SetRegisterFile(DebuggerContext context, const RegisterFile& registers, ReadRegisterFunc readRegister_cb) {
+    ToDebugger(context).SetRegisterFile(registers, std::move(readRegister_cb));
+}
+
+void SetRegisterFile(DebuggerContext context, const RegisterFile& registers, const void* registerStruct) {
+    ToDebugger(context).SetRegisterFile(registers, registerStruct);
+}
+
+void SetReadOnlyMemory(DebuggerContext context, unsigned int startAddress, unsigned int endAddress) {
+    ToDebugger(context).SetReadOnlyMemory(startAddress, endAddress);
+}
+
+void ReadMemoryHook(DebuggerContext context, unsigned int address, const std::vector<std::byte>& bytes) {
+    ToDebugger(context).ReadMemoryHook(AnyBank, address, bytes);
+}
+
+void WriteMemoryHook(DebuggerContext context, unsigned int address, const std::vector<std::byte>& bytes) {
+    ToDebugger(context).WriteMemoryHook(AnyBank, address, bytes);
+}
+
+void ReadMemoryHook(DebuggerContext context, unsigned int address, std::span<const std::byte> bytes) {
+    ToDebugger(context).ReadMemoryHook(AnyBank, address, bytes);
+}
+
+void WriteMemoryHook(DebuggerContext context, unsigned int address, std::span<const std::byte> bytes) {
+    ToDebugger(context).WriteMemoryHook(AnyBank, address, bytes);
+}
+
+void ReadMemoryHook(DebuggerContext context, unsigned int bankNum, unsigned int address, const std::vector<std::byte>& bytes) {
+    return ToDebugger(context).ReadMemoryHook(BankNum{ bankNum }, address, bytes);
+}
+
+void WriteMemoryHook(DebuggerContext context, unsigned int bankNum, unsigned int address, const std::vector<std::byte>& bytes) {
+    return ToDebugger(context).WriteMemoryHook(BankNum{ bankNum }, address, bytes);
+}
+
+void ReadMemoryHook(DebuggerContext context, unsigned int bankNum, unsigned int address, std::span<const std::byte> bytes) {
+    ToDebugger(context).ReadMemoryHook(BankNum{ bankNum }, address, bytes);
+}
+
+void WriteMemoryHook(DebuggerContext context, unsigned int bankNum, unsigned int address, std::span<const std::byte> bytes) {
+    ToDebugger(context).WriteMemoryHook(BankNum{ bankNum }, address, bytes);
+}
+
+void ReadMemoryHook(DebuggerContext context, unsigned int bankNum, unsigned int address, unsigned int value, unsigned int width) {
+    ToDebugger(context).ReadMemoryHook(BankNum{ bankNum }, address, value, width);
+}
+
+void WriteMemoryHook(DebuggerContext context, unsigned int bankNum, unsigned int address, unsigned int value, unsigned int width) {
+    ToDebugger(context).WriteMemoryHook(BankNum{ bankNum }, address, value, width);
+}
+
+void MemoryAccessHook(DebuggerContext context, MemoryAccessBuffer& accesses) {
+    ToDebugger(context).MemoryAccessHook(accesses);
+}
+
+void BankSwitchHook(DebuggerContext context, unsigned int bankNum, unsigned int startAddress, unsigned int endAddress) {
+    ToDebugger(context).BankSwitchHook(BankNum{ bankNum }, startAddress, endAddress);
+}
+
+}
@@ -4,10 +4,29 @@
 
 // TODO: Should these APIs support C language. Remove C++ types? Otherwise look at adding nodiscard and noexcept where makes sense.
 // TODO: Research dll best practice, not sure if this should be exposed.
+#include "MemoryAccessBuffer.h"
 #include "RetroDebuggerCallbackDefines.h"
+#include "StaticOperations.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
 
 namespace Rdb {
 
+/// @brief Handle to a debugger instance, each owns its own callbacks, breakpoints and console.
+/// Separate instances can be used concurrently from separate threads, a single instance from one thread at a time
+/// (except the command channel, see PostCommand). Calls without a context use a default instance created on first use.
+enum class DebuggerContext : std::uintptr_t;
+static constexpr DebuggerContext InvalidDebuggerContext = DebuggerContext{ 0 };
+
+/// @brief Creates a debugger instance.
+/// @return Handle passed to the context overloads, valid until DestroyDebuggerContext.
+RDB_EXPORT DebuggerContext CreateDebuggerContext [[nodiscard]] ();
+
+/// @brief Destroys a debugger instance created by CreateDebuggerContext, does nothing for InvalidDebuggerContext.
+RDB_EXPORT void DestroyDebuggerContext(DebuggerContext context);
+
 /// @brief Gets the RetroDebugger version
 /// Gets the RetroDebugger version.
 /// Version is formatted as following "<MAJOR>.<MINOR>.<PATCH>".
@@ -22,9 +41,28 @@ RDB_EXPORT std::string GetCommandResponse [[nodiscard]] ();
 
 RDB_EXPORT int ProcessCommandString(const std::string& message);
 
+// Command channel, for a UI thread that shouldn't block the emulator thread.
+/// @brief Queues a command for the emulator thread, call from the UI thread only.
+/// @return False when the queue is full, the command wasn't queued.
+RDB_EXPORT bool PostCommand(const std::string& message);
+
+/// @brief Runs the queued commands, call from the emulator thread at an instruction boundary.
+/// Stops after a command that resumes execution, later commands wait for the next call.
+/// @return 1 if a command resumed execution (continue, step, finish), otherwise 0. Same as ProcessCommandString.
+RDB_EXPORT int ProcessPendingCommands();
+
+/// @brief Takes the next command response or break message, call from the UI thread only.
+/// Commands that produce no output have no response.
+/// @return False when there is no response waiting.
+RDB_EXPORT bool PollCommandResponse(std::string& response);
+
 // Direct calls
 RDB_EXPORT bool CheckBreakpoints(BreakInfo* breakInfo);
 
+/// @brief Checks breakpoints after flushing the memory accesses the emulator buffered during the instruction.
+/// This replaces a ReadMemoryHook/WriteMemoryHook call per access, 'accesses' is left empty.
+RDB_EXPORT bool CheckBreakpoints(BreakInfo* breakInfo, MemoryAccessBuffer& accesses);
+
 RDB_EXPORT bool Run(unsigned int numBreakpointsToSkip);
 
 RDB_EXPORT bool RunInstructions(unsigned int numBreakToPass);
@@ -63,6 +101,14 @@ RDB_EXPORT bool GetRegisterInfo(std::vector<RegisterInfoPtr>* registerInfo);
 
 RDB_EXPORT void ParseXmlFile(const std::string& filename); // TODO: Should this API be restructured to use exceptions.
 
+/// @brief Parses the operations XML, optionally through a binary cache written next to it ("<filename>.rdbcache").
+/// The cache is reused while the XML is unchanged and rebuilt when it isn't, it skips XML parsing on later starts.
+RDB_EXPORT void ParseXmlFile(const std::string& filename, bool useBinaryCache);
+
+/// @brief Installs operation tables generated from an operations XML at build time, no XML is parsed at runtime.
+/// See generate_operations_header in cmake/GenerateOperations.cmake, pass the generated RdbOperations::<name>::Tables.
+RDB_EXPORT void SetOperations(StaticOperationsTables operations);
+
 // Callbacks
 RDB_EXPORT void SetGetPcRegCallback(GetProgramCounterFunc getPc_cb);
 
@@ -72,12 +118,150 @@ RDB_EXPORT void SetCheckBankableMemoryLocationCallback(CheckBankableMemoryLocati
 
 RDB_EXPORT void SetReadBankableMemoryCallback(ReadBankableMemoryFunc readBankMemory_cb);
 
+/// @brief Optional, lets listings read a window of memory per call instead of a ReadMemory call per byte.
+/// Only used when each address holds one byte, without it memory is read through the ReadMemory callback.
+RDB_EXPORT void SetReadMemoryBlockCallback(ReadMemoryBlockFunc readMemoryBlock_cb);
+
 RDB_EXPORT void SetGetRegSetCallback(GetRegSetFunc getRegSet_cb);
 
+/// @brief Declares the emulator's registers once so they are read by id rather than through a RegSet copy.
+/// Takes precedence over SetGetRegSetCallback for register watchpoints, conditions and printing.
+/// Can be called again, a register already used by a condition, watchpoint or trace must keep its id.
+/// @param registers Name, id and width of each register, ids are unique and below 1024.
+/// @param readRegister_cb Called with a register id to read its current value.
+RDB_EXPORT void SetRegisterFile(const RegisterFile& registers, ReadRegisterFunc readRegister_cb);
+
+/// @brief Declares the emulator's registers once and reads them straight out of the emulator's register struct.
+/// @param registers Name, id, width and byte offset of each register within the struct.
+/// @param registerStruct Pointer to the emulator's register struct, must outlive the debugger.
+RDB_EXPORT void SetRegisterFile(const RegisterFile& registers, const void* registerStruct);
+
+/// @brief Marks [startAddress, endAddress] as read only memory (ROM).
+/// Writes reported there, such as mapper register writes, don't invalidate decoded listings.
+RDB_EXPORT void SetReadOnlyMemory(unsigned int startAddress, unsigned int endAddress);
+
 // Hooks
 RDB_EXPORT void ReadMemoryHook(unsigned int address, const std::vector<std::byte>& bytes);
 RDB_EXPORT void WriteMemoryHook(unsigned int address, const std::vector<std::byte>& bytes);
 
 RDB_EXPORT void ReadMemoryHook(unsigned int bankNum, unsigned int address, const std::vector<std::byte>& bytes);
 RDB_EXPORT void WriteMemoryHook(unsigned int bankNum, unsigned int address, const std::vector<std::byte>& bytes);
-}
\ No newline at end of file
+
+/// @brief Reports an access without allocating, 'bytes' may point straight into emulator memory.
+RDB_EXPORT void ReadMemoryHook(unsigned int address, std::span<const std::byte> bytes);
+RDB_EXPORT void WriteMemoryHook(unsigned int address, std::span<const std::byte> bytes);
+
+RDB_EXPORT void ReadMemoryHook(unsigned int bankNum, unsigned int address, std::span<const std::byte> bytes);
+RDB_EXPORT void WriteMemoryHook(unsigned int bankNum, unsigned int address, std::span<const std::byte> bytes);
+
+/// @brief Reports a single bus access, the cheapest hook to call per access.
+/// @param bankNum Bank accessed, AnyBank (UINT_MAX) when the address isn't banked.
+/// @param value Value read or written.
+/// @param width Access width in bytes.
+RDB_EXPORT void ReadMemoryHook(unsigned int bankNum, unsigned int address, unsigned int value, unsigned int width);
+RDB_EXPORT void WriteMemoryHook(unsigned int bankNum, unsigned int address, unsigned int value, unsigned int width);
+
+/// @brief Flushes buffered memory accesses without checking breakpoints, for when the buffer fills mid instruction.
+RDB_EXPORT void MemoryAccessHook(MemoryAccessBuffer& accesses);
+
+/// @brief Reports that a bank was switched in over [startAddress, endAddress].
+/// Decoded listings are cached per bank, so switching back to a bank reuses them.
+RDB_EXPORT void BankSwitchHook(unsigned int bankNum, unsigned int startAddress, unsigned int endAddress);
+
+// Context overloads, same as the calls above on the given instance.
+RDB_EXPORT std::string GetCommandPrompt [[nodiscard]] (DebuggerContext context) noexcept;
+
+RDB_EXPORT std::string GetCommandResponse [[nodiscard]] (DebuggerContext context);
+
+RDB_EXPORT int ProcessCommandString(DebuggerContext context, const std::string& message);
+
+RDB_EXPORT bool PostCommand(DebuggerContext context, const std::string& message);
+
+RDB_EXPORT int ProcessPendingCommands(DebuggerContext context);
+
+RDB_EXPORT bool PollCommandResponse(DebuggerContext context, std::string& response);
+
+RDB_EXPORT bool CheckBreakpoints(DebuggerContext context, BreakInfo* breakInfo);
+
+RDB_EXPORT bool CheckBreakpoints(DebuggerContext context, BreakInfo* breakInfo, MemoryAccessBuffer& accesses);
+
+RDB_EXPORT bool Run(DebuggerContext context, unsigned int numBreakpointsToSkip);
+
+RDB_EXPORT bool RunInstructions(DebuggerContext context, unsigned int numBreakToPass);
+
+RDB_EXPORT bool RunTillJump(DebuggerContext context);
+
+RDB_EXPORT bool SetBreakpoint(DebuggerContext context, unsigned int address);
+
+RDB_EXPORT void SetCondition(DebuggerContext context, unsigned int breakNum, const std::string& condition);
+
+RDB_EXPORT bool SetWatchpoint(DebuggerContext context, unsigned int address);
+
+RDB_EXPORT bool SetReadWatchpoint(DebuggerContext context, unsigned int address);
+
+RDB_EXPORT bool SetAnyWatchpoint(DebuggerContext context, unsigned int address);
+
+RDB_EXPORT bool SetWatchpoint(DebuggerContext context, const std::string& name);
+
+RDB_EXPORT bool EnableBreakpoints(DebuggerContext context, unsigned int breakRange0, unsigned int breakRange1);
+
+RDB_EXPORT bool DisableBreakpoints(DebuggerContext context, unsigned int breakRange0, unsigned int breakRange1);
+
+RDB_EXPORT bool DeleteBreakpoints(DebuggerContext context);
+
+RDB_EXPORT bool DeleteBreakpoints(DebuggerContext context, unsigned int breakRange0, unsigned int breakRange1);
+
+RDB_EXPORT BreakList GetBreakpointInfo [[nodiscard]] (DebuggerContext context);
+
+RDB_EXPORT BreakInfo GetBreakpointInfo [[nodiscard]] (DebuggerContext context, unsigned int breakPointNum);
+
+RDB_EXPORT bool GetRegisterInfo(DebuggerContext context, std::vector<RegisterInfoPtr>* registerInfo);
+
+RDB_EXPORT void ParseXmlFile(DebuggerContext context, const std::string& filename); // TODO: Should this API be restructured to use exceptions.
+
+RDB_EXPORT void ParseXmlFile(DebuggerContext context, const std::string& filename, bool useBinaryCache);
+
+RDB_EXPORT void SetOperations(DebuggerContext context, StaticOperationsTables operations);
+
+RDB_EXPORT void SetGetPcRegCallback(DebuggerContext context, GetProgramCounterFunc getPc_cb);
+
+RDB_EXPORT void SetReadMemoryCallback(DebuggerContext context, ReadMemoryFunc readMemory_cb);
+
+RDB_EXPORT void SetCheckBankableMemoryLocationCallback(DebuggerContext context, CheckBankableMemoryLocationFunc CheckBankableMemoryLocation_cb);
+
+RDB_EXPORT void SetReadBankableMemoryCallback(DebuggerContext context, ReadBankableMemoryFunc readBankMemory_cb);
+
+RDB_EXPORT void SetReadMemoryBlockCallback(DebuggerContext context, ReadMemoryBlockFunc readMemoryBlock_cb);
+
+RDB_EXPORT void SetGetRegSetCallback(DebuggerContext context, GetRegSetFunc getRegSet_cb);
+
+RDB_EXPORT void SetRegisterFile(DebuggerContext context, const RegisterFile& registers, ReadRegisterFunc readRegister_cb);
+
+RDB_EXPORT void SetRegisterFile(DebuggerContext context, const RegisterFile& registers, const void* registerStruct);
+
+RDB_EXPORT void SetReadOnlyMemory(DebuggerContext context, unsigned int startAddress, unsigned int endAddress);
+
+RDB_EXPORT void ReadMemoryHook(DebuggerContext context, unsigned int address, const std::vector<std::byte>& bytes);
+
+RDB_EXPORT void WriteMemoryHook(DebuggerContext context, unsigned int address, const std::vector<std::byte>& bytes);
+
+RDB_EXPORT void ReadMemoryHook(DebuggerContext context, unsigned int bankNum, unsigned int address, const std::vector<std::byte>& bytes);
+
+RDB_EXPORT void WriteMemoryHook(DebuggerContext context, unsigned int bankNum, unsigned int address, const std::vector<std::byte>& bytes);
+
+RDB_EXPORT void ReadMemoryHook(DebuggerContext context, unsigned int address, std::span<const std::byte> bytes);
+
+RDB_EXPORT void WriteMemoryHook(DebuggerContext context, unsigned int address, std::span<const std::byte> bytes);
+
+RDB_EXPORT void ReadMemoryHook(DebuggerContext context, unsigned int bankNum, unsigned int address, std::span<const std::byte> bytes);
+
+RDB_EXPORT void WriteMemoryHook(DebuggerContext context, unsigned int bankNum, unsigned int address, std::span<const std::byte> bytes);
+
+RDB_EXPORT void ReadMemoryHook(DebuggerContext context, unsigned int bankNum, unsigned int address, unsigned int value, unsigned int width);
+
+RDB_EXPORT void WriteMemoryHook(DebuggerContext context, unsigned int bankNum, unsigned int address, unsigned int value, unsigned int width);
+
+RDB_EXPORT void MemoryAccessHook(DebuggerContext context, MemoryAccessBuffer& accesses);
+
+RDB_EXPORT void BankSwitchHook(DebuggerContext context, unsigned int bankNum, unsigned int startAddress, unsigned int endAddress);
+}
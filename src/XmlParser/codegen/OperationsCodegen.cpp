@@ -0,0 +1,125 @@
+// Generates a header of constexpr operation tables from an operations XML, see cmake/GenerateOperations.cmake.
+// Usage: RdbOperationsCodegen <operations.xml> <output.h> <namespace name>
+
+#include "DebuggerXmlParser.h"
+
+#include <fmt/core.h>
+#include <magic_enum/magic_enum.hpp>
+
+#include <algorithm>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace {
+std::string Quote(std::string_view value) {
+    std::string quoted = "\"";
+    for (const auto character : value) {
+        if (character == '"' || character == '\\') { quoted += '\\'; }
+        quoted += character;
+    }
+    quoted += '"';
+    return quoted;
+}
+
+std::string GenerateHeader(const XmlOperationsMap& operations, std::string_view xmlName, std::string_view name) {
+    std::string header;
+    auto out = std::back_inserter(header);
+    fmt::format_to(out, "#pragma once\n\n");
+    fmt::format_to(out, "// Generated from {} by RdbOperationsCodegen, do not edit.\n\n", xmlName);
+    fmt::format_to(out, "#include \"StaticOperations.h\"\n\n");
+    fmt::format_to(out, "// clang-format off\n");
+    fmt::format_to(out, "namespace RdbOperations::{} {{\n", name);
+
+    // Every argument in one array, operations refer to their slice of it.
+    const auto hasArguments = std::ranges::any_of(operations | std::views::values, [](const XmlDebuggerOperations& table) {
+        return std::ranges::any_of(table.operations | std::views::values, [](const XmlDebuggerOperation& operation) { return !operation.arguments.empty(); });
+    });
+    if (hasArguments) {
+        fmt::format_to(out, "inline constexpr StaticDebuggerArgument Arguments[] = {{\n");
+        for (const auto& table : operations | std::views::values) {
+            for (const auto& operation : table.operations | std::views::values) {
+                for (const auto& argument : operation.arguments) {
+                    fmt::format_to(out, "    {{ .type = ArgumentType::{}, .indirectArg = {}, .operation = RegOperationType::{}, .nameFirst = {}, .name = {}, .reg = {}, .offset = {} }},\n",
+                                   magic_enum::enum_name(argument.type), argument.indirectArg, magic_enum::enum_name(argument.operation), argument.value.nameFirst,
+                                   Quote(argument.value.name), Quote(argument.value.reg), argument.value.offset);
+                }
+            }
+        }
+        fmt::format_to(out, "}};\n\n");
+    }
+
+    size_t argumentIndex = 0;
+    size_t tableIndex = 0;
+    for (const auto& table : operations | std::views::values) {
+        if (!table.operations.empty()) {
+            fmt::format_to(out, "inline constexpr StaticDebuggerOperation Table{}Operations[] = {{\n", tableIndex);
+            for (const auto& operation : table.operations | std::views::values) {
+                const auto arguments = operation.arguments.empty() ? std::string("{}") : fmt::format("std::span{{ Arguments }}.subspan({}, {})", argumentIndex, operation.arguments.size());
+                fmt::format_to(out, "    {{ .opcode = {:#04x}, .command = {}, .isJump = {}, .arguments = {} }},\n", operation.opcode, Quote(operation.command), operation.isJump, arguments);
+                argumentIndex += operation.arguments.size();
+            }
+            fmt::format_to(out, "}};\n\n");
+        }
+        ++tableIndex;
+    }
+
+    if (operations.empty()) {
+        fmt::format_to(out, "inline constexpr StaticOperationsTables Tables = {{}};\n");
+    }
+    else {
+        fmt::format_to(out, "inline constexpr StaticDebuggerOperations TableArray[] = {{\n");
+        tableIndex = 0;
+        for (const auto& [key, table] : operations) {
+            const auto tableOperations = table.operations.empty() ? std::string("{}") : fmt::format("Table{}Operations", tableIndex);
+            fmt::format_to(out, "    {{ .key = {:#x}, .opcodeLength = {}, .extendedOpcode = {:#x}, .operations = {} }},\n", key, table.opcodeLength, table.extendedOpcode, tableOperations);
+            ++tableIndex;
+        }
+        fmt::format_to(out, "}};\n\n");
+        fmt::format_to(out, "inline constexpr StaticOperationsTables Tables = TableArray;\n");
+    }
+    fmt::format_to(out, "}}\n");
+    fmt::format_to(out, "// clang-format on\n");
+    return header;
+}
+
+// Leaves an unchanged header untouched, so regenerating doesn't rebuild everything that includes it.
+void WriteIfChanged(const std::filesystem::path& path, const std::string& contents) {
+    if (std::ifstream existing(path, std::ios::binary); existing) {
+        const std::string current{ std::istreambuf_iterator<char>(existing), std::istreambuf_iterator<char>() };
+        if (current == contents) { return; }
+    }
+    std::filesystem::create_directories(path.parent_path());
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file || !file.write(contents.data(), static_cast<std::streamsize>(contents.size()))) {
+        throw std::runtime_error(fmt::format("Failed to write '{}'", path.string()));
+    }
+}
+}
+
+int main(int argc, char** argv) {
+    if (argc != 4) {
+        fmt::print(stderr, "Usage: RdbOperationsCodegen <operations.xml> <output.h> <namespace name>\n");
+        return 1;
+    }
+
+    try {
+        const std::filesystem::path xmlPath = argv[1]; // NOLINT (cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        const std::filesystem::path outputPath = argv[2]; // NOLINT (cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        const std::string_view name = argv[3]; // NOLINT (cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+        DebuggerXmlParser parser;
+        parser.ParseFile(xmlPath.string());
+        WriteIfChanged(outputPath, GenerateHeader(parser.GetOperations(), xmlPath.filename().string(), name));
+    }
+    catch (const std::exception& e) {
+        fmt::print(stderr, "RdbOperationsCodegen: {}\n", e.what());
+        return 1;
+    }
+    return 0;
+}
@@ -1,10 +1,14 @@
 #include "DebuggerXmlParser.h"
 
+#include "OperationsCache.h"
 #include "XmlParserException.h"
 
 #include <fmt/core.h>
 #include <tinyxml2.h>
 
+#include <fstream>
+#include <iterator>
+
 static constexpr std::string_view ErrorNullptr = "Encountered unexpected nullptr";
 static constexpr std::string_view ErrorEmptyFile = "couldn't find the first XML element in the file";
 static constexpr std::string_view ErrorPreMsg = "Error XmlParser: ";
@@ -39,6 +43,30 @@ void DebuggerXmlParser::ParseFile(const std::string& filename) {
     return ParseXmlDocument(document);
 }
 
+void DebuggerXmlParser::ParseFile(const std::string& filename, bool useBinaryCache) {
+    if (!useBinaryCache) { return ParseFile(filename); }
+
+    std::ifstream file(filename, std::ios::binary);
+    if (!file) { return ParseFile(filename); } // Reports the error the same way as an uncached parse.
+    const std::string contents{ std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+
+    Reset();
+    const auto hash = OperationsCache::Hash(std::as_bytes(std::span{ contents }));
+    const auto cachePath = OperationsCache::CachePath(filename);
+    if (auto operations = OperationsCache::Load(cachePath, hash)) {
+        m_operationMap = std::move(*operations);
+        m_isValid = true;
+        return;
+    }
+
+    tinyxml2::XMLDocument document;
+    if (document.Parse(contents.data(), contents.size()) != tinyxml2::XML_SUCCESS) {
+        throw XmlParserException::CreateError(document.ErrorStr());
+    }
+    ParseXmlDocument(document);
+    OperationsCache::Save(cachePath, m_operationMap, hash);
+}
+
 XmlOperationsMap DebuggerXmlParser::GetOperations() const {
     if (!m_isValid) {
         using namespace std::string_literals;
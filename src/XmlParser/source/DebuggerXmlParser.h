@@ -19,6 +19,8 @@ public:
     bool IsValid();
 
     void ParseFile(const std::string& filename);
+    // Reuses the binary cache written next to 'filename' when it was built from the same XML, otherwise parses and writes it.
+    void ParseFile(const std::string& filename, bool useBinaryCache);
     void ParseXmlDocument(const tinyxml2::XMLDocument& xmlDocument);
 
     XmlOperationsMap GetOperations() const;
@@ -0,0 +1,258 @@
+#include "OperationsCache.h"
+
+#include "BinaryIo.h"
+
+#include <fmt/core.h>
+
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <ranges>
+#include <string>
+#include <thread>
+#include <type_traits>
+
+namespace {
+static constexpr std::uint32_t Magic = 0x4F424452; // "RDBO"
+static constexpr std::uint32_t FormatVersion = 1;
+static constexpr std::string_view CacheExtension = ".rdbcache";
+static constexpr std::uint32_t MaxArgumentCount = 16; // Bounds a corrupt count so it can't allocate unbounded memory.
+
+class Writer {
+public:
+    template<typename ValueType>
+        requires std::is_trivially_copyable_v<ValueType>
+    void Write(ValueType value) {
+        Rdb::PutRaw(m_data, value);
+    }
+
+    void Write(std::string_view value) {
+        Write(static_cast<std::uint32_t>(value.size()));
+        const auto bytes = std::as_bytes(std::span{ value });
+        m_data.insert(m_data.end(), bytes.begin(), bytes.end());
+    }
+
+    std::vector<std::byte> Take() { return std::move(m_data); }
+
+private:
+    std::vector<std::byte> m_data = {};
+};
+
+class Reader {
+public:
+    explicit Reader(std::span<const std::byte> data) :
+        m_data(data) {}
+
+    // False once the data runs out, every later read fails as well.
+    template<typename ValueType>
+        requires std::is_trivially_copyable_v<ValueType>
+    bool Read(ValueType& value) {
+        return Rdb::GetRaw(m_data, value);
+    }
+
+    bool Read(std::string& value) {
+        std::uint32_t size = 0;
+        if (!Read(size) || m_data.size() < size) { return false; }
+        value.assign(reinterpret_cast<const char*>(m_data.data()), size); // NOLINT (cppcoreguidelines-pro-type-reinterpret-cast)
+        m_data = m_data.subspan(size);
+        return true;
+    }
+
+    [[nodiscard]] bool AtEnd() const { return m_data.empty(); }
+
+private:
+    std::span<const std::byte> m_data; // What is left to read.
+};
+
+// Command, register and argument names repeat across hundreds of opcodes, each is stored once and referenced by index.
+class StringTable {
+public:
+    std::uint32_t Intern(const std::string& value) {
+        const auto [iter, isNew] = m_indices.try_emplace(value, static_cast<std::uint32_t>(m_strings.size()));
+        if (isNew) { m_strings.push_back(&iter->first); }
+        return iter->second;
+    }
+
+    void Write(Writer& writer) const {
+        writer.Write(static_cast<std::uint32_t>(m_strings.size()));
+        for (const auto* value : m_strings) {
+            writer.Write(std::string_view{ *value });
+        }
+    }
+
+private:
+    std::map<std::string, std::uint32_t> m_indices = {};
+    std::vector<const std::string*> m_strings = {};
+};
+
+template<typename EnumType>
+bool ReadEnum(Reader& reader, EnumType& value, EnumType lastValue) {
+    std::underlying_type_t<EnumType> raw{};
+    if (!reader.Read(raw) || raw < 0 || raw > static_cast<std::underlying_type_t<EnumType>>(lastValue)) { return false; }
+    value = static_cast<EnumType>(raw);
+    return true;
+}
+
+bool ReadString(Reader& reader, const std::vector<std::string>& strings, std::string& value) {
+    std::uint32_t index = 0;
+    if (!reader.Read(index) || index >= strings.size()) { return false; }
+    value = strings[index];
+    return true;
+}
+
+bool ReadArgument(Reader& reader, const std::vector<std::string>& strings, XmlDebuggerArgument& argument) {
+    std::uint8_t indirectArg = 0;
+    std::uint8_t nameFirst = 0;
+    const auto isValid = ReadEnum(reader, argument.type, ArgumentType::U32BIT) &&
+                         reader.Read(indirectArg) &&
+                         ReadEnum(reader, argument.operation, RegOperationType::REG_OFFSET_S16BIT) &&
+                         reader.Read(nameFirst) &&
+                         ReadString(reader, strings, argument.value.name) &&
+                         ReadString(reader, strings, argument.value.reg) &&
+                         reader.Read(argument.value.offset);
+    argument.indirectArg = indirectArg != 0;
+    argument.value.nameFirst = nameFirst != 0;
+    return isValid;
+}
+
+bool ReadOperation(Reader& reader, const std::vector<std::string>& strings, XmlDebuggerOperation& operation) {
+    std::uint8_t isJump = 0;
+    std::uint32_t argumentCount = 0;
+    if (!reader.Read(operation.opcode) || !ReadString(reader, strings, operation.command) || !reader.Read(isJump) || !reader.Read(argumentCount)) { return false; }
+    operation.isJump = isJump != 0;
+
+    if (argumentCount > MaxArgumentCount) { return false; }
+    operation.arguments.resize(argumentCount);
+    for (auto& argument : operation.arguments) {
+        if (!ReadArgument(reader, strings, argument)) { return false; }
+    }
+    return true;
+}
+}
+
+namespace OperationsCache {
+
+std::uint64_t Hash(std::span<const std::byte> data) {
+    static constexpr std::uint64_t offsetBasis = 0xCBF29CE484222325ULL;
+    static constexpr std::uint64_t prime = 0x100000001B3ULL;
+
+    auto hash = offsetBasis;
+    for (const auto value : data) {
+        hash = (hash ^ static_cast<std::uint64_t>(value)) * prime;
+    }
+    return hash;
+}
+
+std::vector<std::byte> Serialize(const XmlOperationsMap& operations, std::uint64_t sourceHash) {
+    StringTable strings;
+    Writer body;
+    body.Write(static_cast<std::uint32_t>(operations.size()));
+    for (const auto& [key, table] : operations) {
+        body.Write(key);
+        body.Write(table.opcodeLength);
+        body.Write(table.extendedOpcode);
+        body.Write(static_cast<std::uint32_t>(table.operations.size()));
+        for (const auto& operation : table.operations | std::views::values) {
+            body.Write(operation.opcode);
+            body.Write(strings.Intern(operation.command));
+            body.Write(static_cast<std::uint8_t>(operation.isJump));
+            body.Write(static_cast<std::uint32_t>(operation.arguments.size()));
+            for (const auto& argument : operation.arguments) {
+                body.Write(static_cast<std::underlying_type_t<ArgumentType>>(argument.type));
+                body.Write(static_cast<std::uint8_t>(argument.indirectArg));
+                body.Write(static_cast<std::underlying_type_t<RegOperationType>>(argument.operation));
+                body.Write(static_cast<std::uint8_t>(argument.value.nameFirst));
+                body.Write(strings.Intern(argument.value.name));
+                body.Write(strings.Intern(argument.value.reg));
+                body.Write(argument.value.offset);
+            }
+        }
+    }
+
+    Writer writer;
+    writer.Write(Magic);
+    writer.Write(FormatVersion);
+    writer.Write(sourceHash);
+    strings.Write(writer);
+    auto data = writer.Take();
+    const auto bodyData = body.Take();
+    data.insert(data.end(), bodyData.begin(), bodyData.end());
+    return data;
+}
+
+std::optional<XmlOperationsMap> Deserialize(std::span<const std::byte> data, std::uint64_t sourceHash) {
+    Reader reader(data);
+    std::uint32_t magic = 0;
+    std::uint32_t version = 0;
+    std::uint64_t hash = 0;
+    if (!reader.Read(magic) || magic != Magic || !reader.Read(version) || version != FormatVersion || !reader.Read(hash) || hash != sourceHash) { return std::nullopt; }
+
+    std::uint32_t stringCount = 0;
+    if (!reader.Read(stringCount)) { return std::nullopt; }
+    std::vector<std::string> strings;
+    for (auto i = 0U; i < stringCount; ++i) {
+        if (!reader.Read(strings.emplace_back())) { return std::nullopt; }
+    }
+
+    XmlOperationsMap operations;
+    std::uint32_t tableCount = 0;
+    if (!reader.Read(tableCount)) { return std::nullopt; }
+    for (auto i = 0U; i < tableCount; ++i) {
+        unsigned int key = 0;
+        XmlDebuggerOperations table;
+        std::uint32_t operationCount = 0;
+        if (!reader.Read(key) || !reader.Read(table.opcodeLength) || !reader.Read(table.extendedOpcode) || !reader.Read(operationCount)) { return std::nullopt; }
+
+        for (auto j = 0U; j < operationCount; ++j) {
+            XmlDebuggerOperation operation;
+            if (!ReadOperation(reader, strings, operation)) { return std::nullopt; }
+            const auto opcode = operation.opcode;
+            table.operations.emplace(opcode, std::move(operation));
+        }
+        operations.emplace(key, std::move(table));
+    }
+
+    if (!reader.AtEnd()) { return std::nullopt; }
+    return operations;
+}
+
+std::filesystem::path CachePath(const std::filesystem::path& xmlPath) {
+    auto cachePath = xmlPath;
+    cachePath += CacheExtension;
+    return cachePath;
+}
+
+std::optional<XmlOperationsMap> Load(const std::filesystem::path& cachePath, std::uint64_t sourceHash) {
+    std::ifstream file(cachePath, std::ios::binary | std::ios::ate);
+    if (!file) { return std::nullopt; }
+
+    std::vector<std::byte> data(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    if (!file.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size()))) { return std::nullopt; } // NOLINT (cppcoreguidelines-pro-type-reinterpret-cast)
+    return Deserialize(data, sourceHash);
+}
+
+void Save(const std::filesystem::path& cachePath, const XmlOperationsMap& operations, std::uint64_t sourceHash) {
+    const auto data = Serialize(operations, sourceHash);
+
+    // Written aside and renamed into place so a process starting concurrently never reads a partial cache.
+    auto tempPath = cachePath;
+    tempPath += fmt::format(".{:x}.tmp", std::hash<std::thread::id>{}(std::this_thread::get_id()) ^ static_cast<size_t>(std::chrono::steady_clock::now().time_since_epoch().count()));
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file || !file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()))) { // NOLINT (cppcoreguidelines-pro-type-reinterpret-cast)
+            std::error_code error;
+            std::filesystem::remove(tempPath, error);
+            return;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(tempPath, cachePath, error);
+    if (error) {
+        std::filesystem::remove(tempPath, error);
+    }
+}
+
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "DebuggerCommon.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+// Binary form of parsed operations, written next to the XML so later runs skip XML parsing.
+// The cache records a hash of the XML it was built from and is ignored once the XML changes.
+namespace OperationsCache {
+
+// FNV-1a, 64-bit.
+[[nodiscard]] std::uint64_t Hash(std::span<const std::byte> data);
+
+[[nodiscard]] std::vector<std::byte> Serialize(const XmlOperationsMap& operations, std::uint64_t sourceHash);
+// Empty when the data isn't a cache of this format built from 'sourceHash', or is truncated.
+[[nodiscard]] std::optional<XmlOperationsMap> Deserialize(std::span<const std::byte> data, std::uint64_t sourceHash);
+
+[[nodiscard]] std::filesystem::path CachePath(const std::filesystem::path& xmlPath);
+[[nodiscard]] std::optional<XmlOperationsMap> Load(const std::filesystem::path& cachePath, std::uint64_t sourceHash);
+// Best effort, a cache that can't be written only costs the next run a parse.
+void Save(const std::filesystem::path& cachePath, const XmlOperationsMap& operations, std::uint64_t sourceHash);
+
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <span>
+#include <streambuf>
+#include <type_traits>
+#include <vector>
+
+namespace Rdb {
+
+// Raw values of the binary cache, coverage and trace files. They are stored in host byte order, so a file written on a
+// machine of the other endianness fails its magic check.
+template<typename ValueType>
+    requires std::is_trivially_copyable_v<ValueType>
+void PutRaw(std::vector<std::byte>& out, const ValueType& value) {
+    const auto offset = out.size();
+    out.resize(offset + sizeof(value));
+    std::memcpy(out.data() + offset, &value, sizeof(value));
+}
+
+// False when 'data' is too short, otherwise 'data' is advanced past the value.
+template<typename ValueType>
+    requires std::is_trivially_copyable_v<ValueType>
+bool GetRaw(std::span<const std::byte>& data, ValueType& value) {
+    if (data.size() < sizeof(value)) { return false; }
+    std::memcpy(&value, data.data(), sizeof(value));
+    data = data.subspan(sizeof(value));
+    return true;
+}
+
+template<typename ValueType>
+    requires std::is_trivially_copyable_v<ValueType>
+bool GetRaw(std::streambuf& buffer, ValueType& value) {
+    return buffer.sgetn(reinterpret_cast<char*>(&value), sizeof(value)) == sizeof(value); // NOLINT (cppcoreguidelines-pro-type-reinterpret-cast)
+}
+
+}
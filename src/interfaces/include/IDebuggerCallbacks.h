@@ -10,7 +10,13 @@ public:
     virtual unsigned int ReadMemory(unsigned int address) = 0;
     virtual bool CheckBankableMemoryLocation(BankNum bank, unsigned int address) = 0;
     virtual unsigned int ReadBankableMemory(BankNum bank, unsigned int address) = 0;
+    // Reads a block of byte wide memory in one call, false when there is no block reader and nothing was read.
+    virtual bool ReadMemoryBlock(BankNum bank, unsigned int address, std::span<std::byte> buffer) = 0;
     virtual RegSet GetRegSet() = 0;
+    // Resolves a register name once so it can be read by id afterwards, InvalidRegisterId if the name isn't a register.
+    virtual RegisterId FindRegister(const std::string& name) = 0;
+    virtual unsigned int ReadRegister(RegisterId id) = 0;
+    virtual RegisterFile GetRegisterFile() = 0;
 };
 
 }
\ No newline at end of file
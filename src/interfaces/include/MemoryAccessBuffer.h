@@ -0,0 +1,76 @@
+#pragma once
+
+#include "RetroDebuggerCommon.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace Rdb {
+
+enum class MemoryAccessType : unsigned char {
+    Read = 0,
+    Write,
+};
+
+struct MemoryAccess {
+    BankNum bank = AnyBank;
+    unsigned int address = 0;
+    unsigned int value = 0;
+    unsigned int width = 1; // bytes
+    MemoryAccessType type = MemoryAccessType::Read;
+};
+
+// Emulator owned ring of the memory accesses made during an instruction, handed to the debugger in one call when
+// breakpoints are checked instead of calling a memory hook per access. Pushing never allocates.
+class MemoryAccessBuffer {
+public:
+    // Capacity is rounded up to a power of 2.
+    explicit MemoryAccessBuffer(size_t capacity = 64) :
+        m_accesses(std::bit_ceil(capacity == 0 ? size_t{ 1 } : capacity)),
+        m_mask(m_accesses.size() - 1) {}
+
+    // False when full, the buffer has to be flushed before more accesses fit.
+    bool PushRead(BankNum bank, unsigned int address, unsigned int value, unsigned int width = 1) {
+        return Push({ bank, address, value, width, MemoryAccessType::Read });
+    }
+    bool PushWrite(BankNum bank, unsigned int address, unsigned int value, unsigned int width = 1) {
+        return Push({ bank, address, value, width, MemoryAccessType::Write });
+    }
+    bool Push(const MemoryAccess& access) {
+        if (Size() == m_accesses.size()) { return false; }
+        m_accesses[m_tail++ & m_mask] = access;
+        return true;
+    }
+
+    // Passes the pending accesses oldest first as at most two contiguous spans, then empties the buffer.
+    template<typename Func>
+    void Drain(Func&& func) {
+        if (Empty()) { return; }
+
+        const auto first = m_head & m_mask;
+        const auto firstSize = std::min(Size(), m_accesses.size() - first);
+        func(std::span<const MemoryAccess>{ m_accesses.data() + first, firstSize });
+        if (firstSize != Size()) {
+            func(std::span<const MemoryAccess>{ m_accesses.data(), Size() - firstSize });
+        }
+        m_head = m_tail;
+    }
+
+    void Clear() { m_head = m_tail; }
+
+    [[nodiscard]] size_t Size() const { return m_tail - m_head; }
+    [[nodiscard]] size_t Capacity() const { return m_accesses.size(); }
+    [[nodiscard]] bool Empty() const { return m_head == m_tail; }
+
+private:
+    std::vector<MemoryAccess> m_accesses;
+    size_t m_mask;
+    // Free running, only masked when indexing so a full buffer is told apart from an empty one.
+    size_t m_head = 0;
+    size_t m_tail = 0;
+};
+
+}
@@ -2,7 +2,9 @@
 
 #include "RetroDebuggerCommon.h"
 
+#include <cstddef>
 #include <functional>
+#include <span>
 
 namespace Rdb {
 using GetProgramCounterFunc = std::function<unsigned int()>;
@@ -11,7 +13,13 @@ using ReadMemoryFunc = std::function<unsigned int(unsigned int)>;
 
 using ReadBankableMemoryFunc = std::function<unsigned int(BankNum, unsigned int)>;
 
+// Fills the buffer with the bytes from 'address' onwards, AnyBank reads the currently mapped memory.
+// Bytes past the end of memory are left as they are.
+using ReadMemoryBlockFunc = std::function<void(BankNum, unsigned int, std::span<std::byte>)>;
+
 using CheckBankableMemoryLocationFunc = std::function<bool(BankNum, unsigned int)>;
 
 using GetRegSetFunc = std::function<RegSet()>;
+
+using ReadRegisterFunc = std::function<unsigned int(RegisterId)>;
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <limits>
 #include <map>
 #include <memory>
 #include <set>
@@ -11,8 +12,10 @@
 // TODO: should this be unsigned? Linux GDB has uses for internal breakpoints(signed). I don't believe this will though.
 enum class BreakNum : unsigned int;
 enum class BankNum : unsigned int;
+enum class RegisterId : unsigned int;
 
 static constexpr BankNum AnyBank = BankNum{ std::numeric_limits<unsigned int>::max() };
+static constexpr RegisterId InvalidRegisterId = RegisterId{ std::numeric_limits<unsigned int>::max() };
 
 // forward decl
 namespace Rdb {
@@ -26,6 +29,7 @@ enum class BreakType : unsigned int {
     Catchpoint,
     ReadWatchpoint,
     AnyWatchpoint,
+    Tracepoint, // Records values into a log and continues, never stops execution.
 };
 
 enum class BreakDisposition {
@@ -36,6 +40,7 @@ enum class BreakDisposition {
 
 struct BreakInfo {
     unsigned int address = std::numeric_limits<unsigned int>::max();
+    unsigned int length = 1; // Number of addresses watched from 'address', only ranged watchpoints are larger than 1.
     BreakNum breakpointNumber = BreakNum{ std::numeric_limits<unsigned int>::max() };
     BankNum bankNumber = AnyBank;
     // unsigned int ignoreCount{}; //TODO: unimplemented
@@ -43,12 +48,16 @@ struct BreakInfo {
     unsigned int timesHit{};
     unsigned int oldWatchValue{};
     unsigned int currentWatchValue{};
+    unsigned int watchAddress = std::numeric_limits<unsigned int>::max(); // Address the memory hooks saw accessed, or polling saw change, for the last hit.
+    std::vector<unsigned int> rangeWatchValues = {}; // Last value of each address of a ranged watchpoint, so a change anywhere in it is seen.
     BreakType type = BreakType::Invalid;
     BreakDisposition disp = BreakDisposition::Keep; // TODO: no way to use, is implemented though
     bool isEnabled = true;
     bool externalHit = false;
     std::string regName = {};
+    RegisterId registerId = InvalidRegisterId; // Bound when a register watchpoint is created so it is read by id.
     std::shared_ptr<Rdb::ConditionInterpreter> condition;
+    std::vector<std::shared_ptr<Rdb::ConditionInterpreter>> traceValues = {}; // Expressions a tracepoint records on each hit.
 };
 using BreakList = std::map<BreakNum, BreakInfo>;
 
@@ -57,4 +66,60 @@ struct RegisterInfo {
 };
 using RegisterInfoPtr = std::shared_ptr<RegisterInfo>;
 
-using RegSet = std::map<std::string, unsigned int>;
\ No newline at end of file
+using RegSet = std::map<std::string, unsigned int>;
+
+// An emulator register declared up front, so the debugger can read it by id instead of by name.
+struct RegisterDescription {
+    std::string name;
+    RegisterId id = InvalidRegisterId;
+    unsigned int width = sizeof(unsigned int); // Register size in bytes, 1, 2 or 4.
+    size_t offset = 0; // Byte offset into the emulator's register struct, only used when registers are read through a pointer.
+};
+using RegisterFile = std::vector<RegisterDescription>;
+
+// TODO: clean this up
+// TODO: there is overlap with other structs here, need to clean up xml and then merge the ideas
+// TODO: remove AUTO, its not needed and should never be the end type
+enum class ArgumentType : int {
+    UNKOWN = 0,
+    AUTO,
+    CONSTANT,
+    REG,
+    CONDITIONAL,
+    S8BIT,
+    S16BIT,
+    S32BIT,
+    U8BIT,
+    U16BIT,
+    U32BIT
+};
+
+enum class RegOperationType : int {
+    NONE = 0,
+    POSTINC,
+    POSTDEC,
+    PREINC,
+    PREDEC,
+    REG_OFFSET_ADD,
+    REG_OFFSET_SUB,
+    REG_OFFSET_U8BIT,
+    REG_OFFSET_U16BIT,
+    REG_OFFSET_S8BIT,
+    REG_OFFSET_S16BIT
+};
+
+constexpr unsigned int GetArgTypeLength(ArgumentType argType) {
+    switch (argType) {
+        case ArgumentType::S8BIT:
+        case ArgumentType::U8BIT:
+            return 1;
+        case ArgumentType::S16BIT:
+        case ArgumentType::U16BIT:
+            return 2;
+        case ArgumentType::S32BIT:
+        case ArgumentType::U32BIT:
+            return 4;
+        default:
+            return 0; // TODO: Should this fail?
+    }
+}
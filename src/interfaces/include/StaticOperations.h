@@ -0,0 +1,44 @@
+#pragma once
+
+#include "RetroDebuggerCommon.h"
+
+#include <span>
+#include <string_view>
+
+// Operation tables compiled into the binary, mirrors the parsed operations XML.
+// Generated from an XML at build time by generate_operations_header (cmake/GenerateOperations.cmake).
+
+struct StaticDebuggerArgument {
+    ArgumentType type = ArgumentType::UNKOWN;
+    bool indirectArg = false;
+    RegOperationType operation = RegOperationType::NONE;
+    bool nameFirst = true;
+    std::string_view name = {};
+    std::string_view reg = {};
+    unsigned int offset = 0;
+};
+
+constexpr unsigned int GetArgumentsLength(std::span<const StaticDebuggerArgument> arguments) {
+    unsigned int length = 0;
+    for (const auto& argument : arguments) {
+        length += GetArgTypeLength(argument.type);
+    }
+    return length;
+}
+
+struct StaticDebuggerOperation {
+    unsigned int opcode = 0;
+    std::string_view command = {};
+    bool isJump = false;
+    std::span<const StaticDebuggerArgument> arguments = {};
+    unsigned int argumentsLength = GetArgumentsLength(arguments); // Bytes of immediate values following the opcode.
+};
+
+struct StaticDebuggerOperations {
+    unsigned int key = 0; // Extension opcode of the table, NormalOperationsKey for the normal operations.
+    unsigned int opcodeLength = 0;
+    unsigned int extendedOpcode = 0;
+    std::span<const StaticDebuggerOperation> operations = {};
+};
+
+using StaticOperationsTables = std::span<const StaticDebuggerOperations>;
@@ -6,6 +6,11 @@
 #include <gtest/gtest.h>
 
 #include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
 
 /******************************************************************************
  * TODOs
@@ -304,6 +309,21 @@ TEST_F(RetroDebuggerIntegrationTests, IntegrationTest_Commandline_SetAnyWatchpoi
     ASSERT_EQ(expectedOutput, output.str()); // Doing one full check.
 }
 
+TEST_F(RetroDebuggerIntegrationTests, IntegrationTest_Commandline_SetWatchpointRange_GetBreakpointInfo_HappyPath) {
+
+    //(rdb) w 0x100-0x1FF
+    //(rdb) info break
+    std::stringstream input;
+    input << "w 0x100-0x1FF\ninfo break"; // Not ending with '/n' so GetLine will return immediately on last command
+    Rdb::ParseXmlFile(std::string(RetroDebuggerTests::Assets::GameboyOperationsDebuggerXml));
+    auto output = TestCommandPrompt(input);
+
+    auto expectedOutput = std::string(MessageWhenEnteringDebugLoop) + ConsolePrompt + // No return, in command prompt it would come from the input.
+                          "Num     Type           Disp Enb Address            What\n"
+                          "1       Watchpoint     Keep y   0x0000000000000100 To: 0x00000000000001FF\n";
+    ASSERT_EQ(expectedOutput, output.str()); // Doing one full check.
+}
+
 TEST_F(RetroDebuggerIntegrationTests, IntegrationTest_Commandline_SetBreakpointWithCondition_GetBreakpointInfo_ReadModifyWrite) {
 
     // Has a condition in 'info'
@@ -337,4 +357,127 @@ TEST_F(RetroDebuggerIntegrationTests, IntegrationTest_Commandline_SetBreakpointW
     }
 }
 
-}
\ No newline at end of file
+TEST_F(RetroDebuggerIntegrationTests, IntegrationTest_Commandline_SetRegisterFile_PrintRegisters) {
+
+    struct Registers {
+        uint8_t a;
+        uint8_t f;
+        uint16_t hl;
+    };
+    Registers registers{ .a = 0x12, .f = 0x80, .hl = 0xC0DE }; // Read through this pointer until the context is destroyed.
+
+    // A context of its own, the register file doesn't outlive the test.
+    const auto context = Rdb::CreateDebuggerContext();
+    Rdb::SetRegisterFile(context,
+        { { .name = "A", .id = RegisterId{ 0 }, .width = 1, .offset = offsetof(Registers, a) },
+            { .name = "F", .id = RegisterId{ 1 }, .width = 1, .offset = offsetof(Registers, f) },
+            { .name = "HL", .id = RegisterId{ 2 }, .width = 2, .offset = offsetof(Registers, hl) } },
+        &registers);
+
+    //(rdb) print reg
+    //(rdb) print HL
+    Rdb::ProcessCommandString(context, "print reg");
+    EXPECT_EQ(Rdb::GetCommandResponse(context), "  A(0x12)\n  F(0x80)\n  HL(0xc0de)\n");
+    Rdb::ProcessCommandString(context, "print HL");
+    EXPECT_EQ(Rdb::GetCommandResponse(context), "HL(0xc0de)\n");
+    Rdb::DestroyDebuggerContext(context);
+}
+
+TEST_F(RetroDebuggerIntegrationTests, IntegrationTest_Commandline_PrintRegisters_ThenSetRegisterFileInAnotherOrder) {
+    const auto context = Rdb::CreateDebuggerContext();
+    Rdb::SetGetRegSetCallback(context, []() { return RegSet{ { "A", 0x12u }, { "F", 0x80u } }; });
+
+    //(rdb) print reg
+    //(rdb) print F
+    Rdb::ProcessCommandString(context, "print reg");
+    EXPECT_EQ(Rdb::GetCommandResponse(context), "  A(0x12)\n  F(0x80)\n");
+    Rdb::ProcessCommandString(context, "print F");
+    EXPECT_EQ(Rdb::GetCommandResponse(context), "F(0x80)\n");
+
+    // Printing holds on to no register ids, so the register file may number them differently.
+    const auto readRegister = [](RegisterId id) { return id == RegisterId{ 0 } ? 0x80u : 0x12u; };
+    EXPECT_NO_THROW(Rdb::SetRegisterFile(context, { { .name = "F", .id = RegisterId{ 0 } }, { .name = "A", .id = RegisterId{ 1 } } }, readRegister));
+    Rdb::ProcessCommandString(context, "print reg");
+    EXPECT_EQ(Rdb::GetCommandResponse(context), "  A(0x12)\n  F(0x80)\n");
+    Rdb::DestroyDebuggerContext(context);
+}
+
+TEST_F(RetroDebuggerIntegrationTests, IntegrationTest_CommandChannel_UiThreadDrivesEmulatorThread) {
+    // A context of its own, destroyed before 'pc' goes out of scope so its callback never outlives it.
+    unsigned int pc = 0x100;
+    const auto context = Rdb::CreateDebuggerContext();
+    Rdb::ParseXmlFile(context, std::string(RetroDebuggerTests::Assets::GameboyOperationsDebuggerXml));
+
+    // Emulator thread, stopped in the debugger until a command resumes it. A real emulator would run
+    // instructions here and only drain commands at instruction boundaries.
+    std::thread emulator([context]() {
+        while (Rdb::ProcessPendingCommands(context) == 0) {
+            std::this_thread::yield();
+        }
+    });
+
+    //(rdb) b 0x100
+    //(rdb) info break
+    //(rdb) continue
+    for (const auto* command : { "b 0x100", "info break", "continue" }) {
+        EXPECT_TRUE(Rdb::PostCommand(context, command));
+    }
+    emulator.join();
+
+    std::string response;
+    EXPECT_TRUE(Rdb::PollCommandResponse(context, response)); // 'b' and 'continue' have no output.
+    EXPECT_EQ(response,
+        "Num     Type           Disp Enb Address            What\n"
+        "1       Breakpoint     Keep y   0x0000000000000100 \n");
+    EXPECT_FALSE(Rdb::PollCommandResponse(context, response));
+
+    // The emulator thread hits the breakpoint, then steps on by itself. The step stops without a message, so nothing more is published.
+    Rdb::SetGetPcRegCallback(context, [&pc]() { return pc; });
+    BreakInfo breakInfo;
+    EXPECT_TRUE(Rdb::CheckBreakpoints(context, &breakInfo));
+    EXPECT_TRUE(Rdb::PollCommandResponse(context, response));
+    EXPECT_TRUE(response.starts_with("Breakpoint 1 ,")) << response;
+    Rdb::RunInstructions(context, 0);
+    pc = 0x101;
+    EXPECT_TRUE(Rdb::CheckBreakpoints(context, &breakInfo));
+    EXPECT_FALSE(Rdb::PollCommandResponse(context, response));
+    Rdb::DestroyDebuggerContext(context);
+}
+
+TEST_F(RetroDebuggerIntegrationTests, IntegrationTest_Contexts_InstancesAreIndependentAcrossThreads) {
+    static constexpr auto instanceCount = 4u;
+    static constexpr auto instructionCount = 0x1000u;
+
+    // Each thread runs its own core with a breakpoint at a different address.
+    std::array<unsigned int, instanceCount> hitAddresses = {};
+    std::vector<std::thread> cores;
+    for (auto instance = 0u; instance < instanceCount; ++instance) {
+        cores.emplace_back([instance, &hitAddresses]() {
+            const auto context = Rdb::CreateDebuggerContext();
+            unsigned int pc = 0;
+            Rdb::SetGetPcRegCallback(context, [&pc]() { return pc; });
+            Rdb::SetReadMemoryCallback(context, [](unsigned int /*address*/) { return 0u; });
+            Rdb::SetBreakpoint(context, 0x100u + instance);
+
+            BreakInfo breakInfo;
+            for (; pc < instructionCount; ++pc) {
+                if (Rdb::CheckBreakpoints(context, &breakInfo)) {
+                    hitAddresses[instance] = breakInfo.address;
+                }
+            }
+            EXPECT_EQ(Rdb::GetBreakpointInfo(context).size(), 1u);
+            Rdb::DestroyDebuggerContext(context);
+        });
+    }
+    for (auto& core : cores) {
+        core.join();
+    }
+
+    for (auto instance = 0u; instance < instanceCount; ++instance) {
+        EXPECT_EQ(hitAddresses[instance], 0x100u + instance);
+    }
+    // The default instance isn't touched by contexts.
+    EXPECT_TRUE(Rdb::GetBreakpointInfo().empty());
+}
+
+}